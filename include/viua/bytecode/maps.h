@@ -74,6 +74,15 @@ const std::map<enum OPCODE, std::string> OP_NAMES = {
     {VPOP, "vpop"},
     {VAT, "vat"},
     {VLEN, "vlen"},
+    {VSUM, "vsum"},
+    {VMIN, "vmin"},
+    {VMAX, "vmax"},
+    {VDOT, "vdot"},
+    {VADD, "vadd"},
+    {VSUB, "vsub"},
+    {VMUL, "vmul"},
+    {VDIV, "vdiv"},
+    {VSORT, "vsort"},
 
     {BOOL, "bool"},
     {NOT, "not"},
@@ -201,6 +210,13 @@ const std::map<enum OPCODE, std::string> OP_NAMES = {
     {STRUCTINSERT, "structinsert"},
     {STRUCTREMOVE, "structremove"},
     {STRUCTKEYS, "structkeys"},
+    {DICT, "dict"},
+    {DICTINSERT, "dictinsert"},
+    {DICTAT, "dictat"},
+    {DICTHAS, "dicthas"},
+    {DICTREMOVE, "dictremove"},
+    {DICTSIZE, "dictsize"},
+    {DICTKEYS, "dictkeys"},
 
     {NEW, "new"},
     {MSG, "msg"},
@@ -119,6 +119,42 @@ enum OPCODE : viua::internals::types::byte {
     VAT,
     VLEN,
 
+    /*
+     *  Reduce a vector of numbers to a single value.
+     *  The result is an Integer if the vector holds only Integers, and a Float
+     *  otherwise.
+     *
+     *  vsum {result-register} {vector-register}
+     */
+    VSUM,
+    VMIN,
+    VMAX,
+
+    /*
+     *  Dot product of two vectors of numbers of equal length.
+     *
+     *  vdot {result-register} {lhs-vector-register} {rhs-vector-register}
+     */
+    VDOT,
+
+    /*
+     *  Element-wise arithmetic on two vectors of numbers of equal length.
+     *  Creates a new vector.
+     *
+     *  vadd {result-register} {lhs-vector-register} {rhs-vector-register}
+     */
+    VADD,
+    VSUB,
+    VMUL,
+    VDIV,
+
+    /*
+     *  Sort a vector of numbers (or booleans) in place, in ascending order.
+     *
+     *  vsort {vector-register}
+     */
+    VSORT,
+
     /*
      * Any Viua VM value may be converted to a boolean value.
      */
@@ -416,6 +452,60 @@ enum OPCODE : viua::internals::types::byte {
      */
     STRUCTKEYS,
 
+    /*
+     *  Create a dict.
+     *  Dicts are hash maps with Integer, Atom, String, Text, or Bits keys.
+     *
+     *  dict {target-register}
+     */
+    DICT,
+
+    /*
+     *  Insert a value into a dict at a given key.
+     *  Copies the key, and moves the value into the dict. Replaces any value
+     *  previously stored at that key.
+     *
+     *  dictinsert {target-dict-register} {key-register} {value-register}
+     */
+    DICTINSERT,
+
+    /*
+     *  Get a pointer to the value stored at a given key.
+     *  Throws an exception if the dict does not have requested key.
+     *
+     *  dictat {result-register} {source-dict-register} {key-register}
+     */
+    DICTAT,
+
+    /*
+     *  Check if a dict has a given key.
+     *
+     *  dicthas {result-register} {source-dict-register} {key-register}
+     */
+    DICTHAS,
+
+    /*
+     *  Remove a value at a given key from a dict, and return removed value.
+     *  Throws an exception if the dict does not have requested key.
+     *
+     *  dictremove {result-register} {source-dict-register} {key-register}
+     */
+    DICTREMOVE,
+
+    /*
+     *  Get the number of keys in a dict.
+     *
+     *  dictsize {result-register} {source-dict-register}
+     */
+    DICTSIZE,
+
+    /*
+     *  Get a vector with copies of keys of a dict, in insertion order.
+     *
+     *  dictkeys {result-register} {source-dict-register}
+     */
+    DICTKEYS,
+
     NEW,     // construct new instance of a class in a register
     MSG,     // send a message to an object (used for dynamic dispatch, for static use plain "CALL")
     INSERT,  // insert an object as a value of an attribute of another object
@@ -133,6 +133,8 @@ namespace viua {
             OBJECT = 1 << 14,
 
             POINTER = 1 << 15,
+
+            DICT = 1 << 16,
         };
     }
 }
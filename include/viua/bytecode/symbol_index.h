@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_BYTECODE_SYMBOL_INDEX_H
+#define VIUA_BYTECODE_SYMBOL_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <viua/bytecode/bytetypedef.h>
+
+
+namespace viua {
+    namespace bytecode {
+        namespace symbol_index {
+            /*  Symbol index is an optional section written by the assembler after
+             *  the bytecode.
+             *  It contains hash tables over the names sections of a binary (functions,
+             *  blocks, and external signatures) so that symbols can be looked up
+             *  directly in the loaded file, without decoding the names sections into
+             *  maps first.
+             *
+             *  Layout of the section:
+             *
+             *      VIUA_SYMBOL_INDEX_MAGIC
+             *      table for functions
+             *      table for blocks
+             *      table for external function signatures
+             *      table for external block signatures
+             *
+             *  Each table is a bucket count (a power of two, or zero for an empty
+             *  table) followed by that many buckets.
+             *  A bucket is three 64 bit words: hash of the name, offset of the name in
+             *  its names section, and the value for the name (entry point address for
+             *  functions and blocks, position in the list for signatures).
+             *  Empty buckets have the name offset set to EMPTY.
+             */
+            using hash_type = uint64_t;
+            using value_type = viua::internals::types::bytecode_size;
+
+            const uint64_t EMPTY = UINT64_MAX;
+
+            auto hash(const char*, const std::size_t) -> hash_type;
+
+            /*  Build a table over a names section as written by the assembler.
+             *  If the last parameter is true every name is followed by an address.
+             */
+            auto build(const char*, const uint64_t, const bool) -> std::string;
+
+            class Table {
+                const viua::internals::types::byte* buckets;
+                uint64_t bucket_count;
+                const char* names;
+                uint64_t names_size;
+
+              public:
+                auto find(const std::string&, value_type&) const -> bool;
+                auto values() const -> std::vector<value_type>;
+                auto entries() const -> std::vector<std::pair<std::string, value_type>>;
+                auto size() const -> uint64_t;
+
+                Table();
+                /*  Table is a view of the memory it is given; it does not copy
+                 *  anything so the memory must outlive the table.
+                 */
+                Table(const viua::internals::types::byte*, const uint64_t, const char*, const uint64_t);
+            };
+
+            struct Index {
+                bool present = false;
+                Table functions;
+                Table blocks;
+                Table external_functions;
+                Table external_blocks;
+            };
+        }
+    }
+}
+
+
+#endif
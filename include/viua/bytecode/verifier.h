@@ -0,0 +1,52 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_BYTECODE_VERIFIER_H
+#define VIUA_BYTECODE_VERIFIER_H
+
+#include <vector>
+#include <viua/bytecode/bytetypedef.h>
+
+
+namespace viua {
+    namespace bytecode {
+        namespace verifier {
+            /*  Verify bytecode of a module before it is run.
+             *
+             *  Bytecode is split into functions (and blocks) at the given entry points.
+             *  Every instruction must have a valid opcode and well-formed operands, and
+             *  must not cross the end of the bytecode; every entry point must be the
+             *  first byte of an instruction; every jump target must be the first byte
+             *  of an instruction in the same function as the jump, and must not be the
+             *  jump itself.
+             *
+             *  Instructions are walked without being disassembled.
+             *  Returns offsets of literals of all "atom" instructions so they can be
+             *  interned without walking the bytecode again.
+             *  Throws std::string describing the first problem found.
+             */
+            auto verify(viua::internals::types::byte*, const viua::internals::types::bytecode_size,
+                        std::vector<viua::internals::types::bytecode_size>)
+                -> std::vector<viua::internals::types::bytecode_size>;
+        }
+    }
+}
+
+
+#endif
@@ -110,6 +110,15 @@ namespace cg {
         viua::internals::types::byte* opvpop(viua::internals::types::byte*, int_op, int_op, int_op);
         viua::internals::types::byte* opvat(viua::internals::types::byte*, int_op, int_op, int_op);
         viua::internals::types::byte* opvlen(viua::internals::types::byte*, int_op, int_op);
+        viua::internals::types::byte* opvsum(viua::internals::types::byte*, int_op, int_op);
+        viua::internals::types::byte* opvmin(viua::internals::types::byte*, int_op, int_op);
+        viua::internals::types::byte* opvmax(viua::internals::types::byte*, int_op, int_op);
+        viua::internals::types::byte* opvdot(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opvadd(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opvsub(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opvmul(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opvdiv(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opvsort(viua::internals::types::byte*, int_op);
 
         viua::internals::types::byte* opnot(viua::internals::types::byte*, int_op, int_op);
         viua::internals::types::byte* opand(viua::internals::types::byte*, int_op, int_op, int_op);
@@ -232,6 +241,14 @@ namespace cg {
         viua::internals::types::byte* opstructremove(viua::internals::types::byte*, int_op, int_op, int_op);
         viua::internals::types::byte* opstructkeys(viua::internals::types::byte*, int_op, int_op);
 
+        viua::internals::types::byte* opdict(viua::internals::types::byte*, int_op);
+        viua::internals::types::byte* opdictinsert(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opdictat(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opdicthas(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opdictremove(viua::internals::types::byte*, int_op, int_op, int_op);
+        viua::internals::types::byte* opdictsize(viua::internals::types::byte*, int_op, int_op);
+        viua::internals::types::byte* opdictkeys(viua::internals::types::byte*, int_op, int_op);
+
         viua::internals::types::byte* opnew(viua::internals::types::byte*, int_op, const std::string&);
         viua::internals::types::byte* opmsg(viua::internals::types::byte*, int_op, const std::string&);
         viua::internals::types::byte* opmsg(viua::internals::types::byte*, int_op, int_op);
@@ -37,6 +37,7 @@ struct invocables_t {
 
 struct compilationflags_t {
     bool as_lib;
+    bool symbol_index;
 
     bool verbose;
     bool debug;
@@ -33,7 +33,9 @@ namespace viua {
     namespace front {
         namespace vm {
             void initialise(viua::kernel::Kernel*, const std::string&, std::vector<std::string>);
+            void initialise_from_image(viua::kernel::Kernel*, const std::string&, std::vector<std::string>, const std::string&);
             void load_standard_prototypes(viua::kernel::Kernel*);
+            void load_standard_functions(viua::kernel::Kernel*);
             void preload_libraries(viua::kernel::Kernel*);
         }
     }
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -41,10 +42,28 @@ class Frame {
 
         std::string function_name;
 
+        /*  Set by the call profiler: name of the function the frame is accounted
+         *  to (differs from function_name after a tail call), process running
+         *  time and wall time (in nanoseconds) at which the frame was entered,
+         *  and running time spent in functions it called.
+         *  A frame is left only once, so frames that were closed before being
+         *  dropped (e.g. those of a stopped process) are not counted twice.
+         */
+        std::string profiled_function_name;
+        uint64_t entered_running_at;
+        uint64_t entered_wall_at;
+        uint64_t callees_running_time;
+        bool profiled;
+
         inline viua::internals::types::byte* ret_address() { return return_address; }
 
         void setLocalRegisterSet(viua::kernel::RegisterSet*, bool receives_ownership = true);
 
+        /*  Register sets that are not owned by the frame (e.g. the ones
+         *  of closures) are not included.
+         */
+        std::size_t memory_footprint() const;
+
         Frame(viua::internals::types::byte*, viua::internals::types::register_index, viua::internals::types::register_index = 16);
         Frame(const Frame&);
 };
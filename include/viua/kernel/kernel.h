@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <dlfcn.h>
 #include <cstdint>
 #include <iostream>
@@ -39,10 +40,17 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <unordered_map>
 #include <viua/bytecode/bytetypedef.h>
+#include <viua/bytecode/symbol_index.h>
+#include <viua/types/atom.h>
 #include <viua/types/prototype.h>
 #include <viua/include/module.h>
 #include <viua/process.h>
+#include <viua/scheduler/telemetry.h>
+#include <viua/scheduler/tracing.h>
+#include <viua/util/persistent_map.h>
+#include <viua/util/published.h>
 
 
 namespace viua {
@@ -65,16 +73,33 @@ namespace viua {
             mutable std::mutex mailbox_mutex;
             std::vector<std::unique_ptr<viua::types::Value>> messages;
 
+            /*
+             * Times at which messages were sent (empty if message timestamps are
+             * disabled), and the highest number of messages that were ever waiting
+             * in the mailbox.
+             */
+            std::vector<std::chrono::steady_clock::time_point> sent_at;
+            decltype(messages)::size_type most_messages;
+
             public:
 
-            auto send(std::unique_ptr<viua::types::Value>) -> void;
-            auto receive(std::queue<std::unique_ptr<viua::types::Value>>&) -> void;
+            auto send(std::unique_ptr<viua::types::Value>, const bool) -> void;
+            auto receive(std::queue<std::unique_ptr<viua::types::Value>>&,
+                         std::queue<std::chrono::steady_clock::time_point>&) -> void;
             auto size() const -> decltype(messages)::size_type;
+            auto high_water_mark() const -> decltype(messages)::size_type;
+
+            Mailbox();
 
-            Mailbox() = default;
             Mailbox(Mailbox&&);
         };
 
+        struct MailboxDepth {
+            viua::process::PID pid;
+            std::size_t depth;
+            std::size_t high_water_mark;
+        };
+
         class ProcessResult {
                 mutable std::mutex result_mutex;
 
@@ -123,28 +148,160 @@ namespace viua {
                 ProcessResult(ProcessResult&&);
         };
 
+        /*  Kinds of modules a name may be resolved to.
+         *  Names imported by processes may be either native or foreign modules,
+         *  but names listed in VIUAPRELINK must be native and names listed in
+         *  VIUAPREIMPORT must be foreign.
+         */
+        enum class ModuleLookup {
+            ANY,
+            NATIVE,
+            FOREIGN,
+        };
+
         class Kernel {
 #ifdef AS_DEBUG_HEADER
             public:
 #endif
             /*  Bytecode pointer is a pointer to program's code.
              *  Size and executable offset are metadata exported from bytecode dump.
+             *  Bytecode is shared (not unique) because it usually points into a
+             *  file mapped by the loader.
              */
-            std::unique_ptr<viua::internals::types::byte[]> bytecode;
+            std::shared_ptr<viua::internals::types::byte[]> bytecode;
             viua::internals::types::bytecode_size bytecode_size;
             viua::internals::types::bytecode_size executable_offset;
 
-            // Map of the typesystem currently existing inside the VM.
-            std::map<std::string, std::unique_ptr<viua::types::Prototype>> typesystem;
+            /*  Map of the typesystem currently existing inside the VM.
+             *  Prototypes are registered while processes are running so the map is
+             *  published as a snapshot (readers never lock it); snapshots share
+             *  their unchanged parts so a registration copies only O(log n) nodes.
+             */
+            using Typesystem = viua::util::PersistentMap<std::string, std::shared_ptr<const viua::types::Prototype>>;
+            viua::util::Published<Typesystem> typesystem;
 
             /*  Function and block names mapped to bytecode addresses.
              */
             std::map<std::string, viua::internals::types::bytecode_size> function_addresses;
             std::map<std::string, viua::internals::types::bytecode_size> block_addresses;
 
-            std::map<std::string, std::pair<std::string, viua::internals::types::byte*>> linked_functions;
-            std::map<std::string, std::pair<std::string, viua::internals::types::byte*>> linked_blocks;
-            std::map<std::string, std::pair<viua::internals::types::bytecode_size, std::unique_ptr<viua::internals::types::byte[]>>> linked_modules;
+            /*  Symbol index of the executable, if it has one.
+             *  Names found in the index are looked up directly in the loaded file
+             *  so the maps above need not be filled.
+             */
+            viua::bytecode::symbol_index::Index symbol_index;
+            auto local_function_address(const std::string&, viua::internals::types::bytecode_size&) const -> bool;
+            auto local_block_address(const std::string&, viua::internals::types::bytecode_size&) const -> bool;
+
+            /*  Symbols of linked modules.
+             *  Modules may be imported by any process at any time, so linking builds
+             *  a new set of symbols and publishes it atomically; lookups work on
+             *  a snapshot and never block.
+             *  Function and block tables share their unchanged parts between
+             *  snapshots so an import copies only what it adds.
+             *  Modules are never unloaded so addresses obtained from a snapshot
+             *  remain valid after the snapshot is released.
+             */
+            struct LinkedSymbols {
+                viua::util::PersistentMap<std::string, std::pair<std::string, viua::internals::types::byte*>> functions;
+                viua::util::PersistentMap<std::string, std::pair<std::string, viua::internals::types::byte*>> blocks;
+                std::map<std::string, std::pair<viua::internals::types::bytecode_size, std::shared_ptr<viua::internals::types::byte[]>>> modules;
+
+                /*  Modules imported lazily map to paths of their files.
+                 *  Their functions and blocks are already listed above (with null
+                 *  entry points), but they are linked only when first entered.
+                 */
+                std::map<std::string, std::string> pending_modules;
+            };
+            viua::util::Published<LinkedSymbols> linked;
+
+            /*  Serialises loading of modules so that a module imported by several
+             *  processes at once is linked only once.
+             */
+            std::mutex linking_mutex;
+            std::map<std::string, std::string> linked_foreign_modules;
+
+            bool lazy_linking;
+
+            /*  If enabled, messages are timestamped when they are sent so that
+             *  receivers can measure how long they were queued.
+             */
+            const bool message_timestamps;
+
+            /*  Trace file shared by all schedulers (null if tracing is disabled).
+             */
+            std::unique_ptr<viua::scheduler::tracing::Sink> trace_sink;
+
+            /*  Paths of modules found on VIUAPATH, VIUAAFTERPATH, and the compiled-in
+             *  path.
+             *  Each module is looked for only once per kernel; if VIUA_MODULE_CACHE
+             *  names a file the cache is also persisted there (when the kernel is
+             *  destroyed) and reused by later runs (an entry from the file is used
+             *  only if the inode and modification time of the module file did not
+             *  change).
+             *  Entries are keyed by the search path, the kind of module that was
+             *  looked for, and the name of the module so that kernels started with
+             *  different search paths can share a cache file.
+             */
+            struct ResolvedModule {
+                bool native;
+                std::string path;
+                uint64_t inode;
+                int64_t mtime;
+                bool verified;
+            };
+            using ModuleCacheKey = std::tuple<std::string, std::string, std::string>;
+            std::map<ModuleCacheKey, ResolvedModule> resolved_modules;
+            std::string module_search_path;
+            std::string module_cache_path;
+            bool module_cache_changed;
+            auto resolve_module(const std::string&, const ModuleLookup) -> const ResolvedModule&;
+            auto load_module_cache() -> void;
+            auto save_module_cache() const -> void;
+            auto is_module_loaded(const std::string&) const -> bool;
+            auto link_native_module(const std::string&, const std::string&) -> void;
+            auto register_native_module(const std::string&, const std::string&) -> void;
+            auto link_pending_module(const std::string&) -> void;
+
+            /*  Atom literals embedded in loaded bytecode (keyed by the address of
+             *  the literal) resolved to interned atom handles.
+             *  Literals are resolved once, when the bytecode is loaded, so the
+             *  "atom" instruction does not have to decode and intern them again.
+             *  Literals of every piece of loaded bytecode are kept in a segment of
+             *  their own, and segments are sorted by address, so loading a module
+             *  publishes only its own literals.
+             */
+            using AtomLiterals = std::unordered_map<const viua::internals::types::byte*, viua::types::Atom::handle_type>;
+            struct AtomLiteralSegment {
+                const viua::internals::types::byte* begin;
+                const viua::internals::types::byte* end;
+                std::shared_ptr<const AtomLiterals> literals;
+            };
+            using AtomLiteralSegments = std::vector<AtomLiteralSegment>;
+            viua::util::Published<AtomLiteralSegments> atom_literals;
+            static auto intern_atom_literals(viua::internals::types::byte*, const viua::internals::types::bytecode_size, const std::vector<viua::internals::types::bytecode_size>&) -> AtomLiterals;
+            auto publish_atom_literals(std::vector<AtomLiteralSegment>) -> void;
+
+            /*  Native module that was read, verified, and had its atom literals
+             *  resolved, but is not yet visible to processes.
+             *  Preparing a module does not touch the kernel so many modules can be
+             *  prepared at once; publishing them requires linking_mutex.
+             */
+            struct PreparedModule {
+                std::string name;
+                viua::internals::types::bytecode_size size;
+                std::shared_ptr<viua::internals::types::byte[]> bytecode;
+                std::vector<std::pair<std::string, viua::internals::types::bytecode_size>> functions;
+                std::vector<std::pair<std::string, viua::internals::types::bytecode_size>> blocks;
+                AtomLiterals atom_literals;
+            };
+            static auto prepare_native_module(const std::string&, const std::string&) -> PreparedModule;
+            auto publish_native_module(PreparedModule) -> void;
+
+            /*  Set when the executable passed verification (linked modules are
+             *  always verified before they are published).
+             */
+            bool bytecode_verified;
 
             int return_code;
 
@@ -174,11 +331,22 @@ namespace viua {
             static const viua::internals::types::schedulers_count default_vp_schedulers_limit = 2;
             viua::internals::types::schedulers_count vp_schedulers_limit;
 
+            /*
+             * Telemetry counters of VP schedulers (one set per scheduler, none if
+             * telemetry is disabled).
+             * They are created before the schedulers are started and outlive them
+             * so that the final metrics dump can be written after all schedulers
+             * shut down.
+             */
+            std::vector<std::unique_ptr<viua::scheduler::telemetry::Counters>> scheduler_counters;
+            auto dump_metrics(const std::string&) const -> void;
+
             /*  This is the interface between programs compiled to VM bytecode and
              *  extension libraries written in C++.
+             *  Published like the typesystem; all functions of a library are
+             *  published at once.
              */
-            std::map<std::string, ForeignFunction*> foreign_functions;
-            std::mutex foreign_functions_mutex;
+            viua::util::Published<viua::util::PersistentMap<std::string, ForeignFunction*>> foreign_functions;
 
             /** This is the mapping Viua uses to dispatch methods on pure-C++ classes.
              */
@@ -195,7 +363,7 @@ namespace viua {
             std::vector<void*> cxx_dynamic_lib_handles;
 
             std::map<viua::process::PID, Mailbox> mailboxes;
-            std::mutex mailbox_mutex;
+            mutable std::mutex mailbox_mutex;
 
             /*
              * Only processes that were not disowned have an entry here.
@@ -210,8 +378,9 @@ namespace viua {
                 /*  Methods dealing with dynamic library loading.
                  */
                 void loadModule(std::string);
-                void loadNativeLibrary(const std::string&);
-                void loadForeignLibrary(const std::string&);
+                void loadModules(const std::vector<std::string>&, const ModuleLookup = ModuleLookup::ANY);
+                void loadNativeLibrary(const std::string&, const std::string&);
+                void loadForeignLibrary(const std::string&, const std::string&);
 
                 // debug and error reporting flags
                 bool debug, errors;
@@ -225,11 +394,41 @@ namespace viua {
                  *      * tell the Kernel where to start execution,
                  *      * kick the Kernel so it starts running,
                  */
-                Kernel& load(std::unique_ptr<viua::internals::types::byte[]>);
+                Kernel& load(std::shared_ptr<viua::internals::types::byte[]>);
                 Kernel& bytes(viua::internals::types::bytecode_size);
 
                 Kernel& mapfunction(const std::string&, viua::internals::types::bytecode_size);
                 Kernel& mapblock(const std::string&, viua::internals::types::bytecode_size);
+                Kernel& mapsymbols(const viua::bytecode::symbol_index::Index&);
+
+                /*  Verify loaded bytecode (must be called after the bytecode and its
+                 *  functions and blocks are loaded, and before it is run).
+                 *  Throws std::string if the bytecode is malformed.
+                 *  Atom literals of the executable are resolved while it is verified;
+                 *  literals of bytecode that was not verified are interned by the
+                 *  "atom" instruction when it runs.
+                 */
+                Kernel& verify();
+
+                /*  Tells whether the code of the module starting at the given address
+                 *  passed verification, so processes can run it without repeating the
+                 *  checks done by the verifier.
+                 */
+                auto is_verified_code(const viua::internals::types::byte*) const -> bool;
+
+                /*  Kernel images.
+                 *  An image contains the executable and every module linked into the
+                 *  kernel (with their functions and blocks), and paths of loaded foreign
+                 *  libraries.
+                 *  A kernel started from an image does not have to search for, read,
+                 *  and link these files again; code from the image is verified when it
+                 *  is loaded.
+                 *  Images record the version of the VM (the second parameter) that
+                 *  wrote them, and are not loaded by any other version.
+                 *  Both functions throw std::string on error.
+                 */
+                auto save_image(const std::string&, const std::string&) -> void;
+                auto load_image(const std::string&, const std::string&) -> void;
 
                 Kernel& registerExternalFunction(const std::string&, ForeignFunction*);
                 Kernel& removeExternalFunction(std::string);
@@ -248,10 +447,12 @@ namespace viua {
                 bool isBlock(const std::string&) const;
                 bool isLocalBlock(const std::string&) const;
                 bool isLinkedBlock(const std::string&) const;
-                std::pair<viua::internals::types::byte*, viua::internals::types::byte*> getEntryPointOfBlock(const std::string&) const;
+                std::pair<viua::internals::types::byte*, viua::internals::types::byte*> getEntryPointOfBlock(const std::string&);
 
                 std::string resolveMethodName(const std::string&, const std::string&) const;
-                std::pair<viua::internals::types::byte*, viua::internals::types::byte*> getEntryPointOf(const std::string&) const;
+                std::pair<viua::internals::types::byte*, viua::internals::types::byte*> getEntryPointOf(const std::string&);
+
+                auto atom_literal_at(const viua::internals::types::byte*) const -> viua::types::Atom::handle_type;
 
                 void registerPrototype(const std::string&, std::unique_ptr<viua::types::Prototype>);
                 void registerPrototype(std::unique_ptr<viua::types::Prototype>);
@@ -278,12 +479,44 @@ namespace viua {
                 auto transfer_result_of(const viua::process::PID) -> std::unique_ptr<viua::types::Value>;
 
                 void send(const viua::process::PID, std::unique_ptr<viua::types::Value>);
-                void receive(const viua::process::PID, std::queue<std::unique_ptr<viua::types::Value>>&);
+                void receive(const viua::process::PID, std::queue<std::unique_ptr<viua::types::Value>>&,
+                             std::queue<std::chrono::steady_clock::time_point>&);
                 uint64_t pids() const;
 
+                /*  Returns depths of mailboxes, deepest first.
+                 *  Only messages not yet taken by their receivers are counted.
+                 */
+                auto mailbox_depths() const -> std::vector<MailboxDepth>;
+
+                auto telemetry() const -> std::vector<const viua::scheduler::telemetry::Counters*>;
+
+                /*  Names of modules whose symbols are visible to processes, of modules
+                 *  that will be linked when first entered, and of foreign functions.
+                 *  All of them are read from published snapshots so they never block.
+                 */
+                auto linked_module_names() const -> std::vector<std::string>;
+                auto pending_module_names() const -> std::vector<std::string>;
+                auto foreign_function_names() const -> std::vector<std::string>;
+
                 auto static no_of_vp_schedulers() -> viua::internals::types::schedulers_count;
                 auto static no_of_ffi_schedulers() -> viua::internals::types::schedulers_count;
                 auto static is_tracing_enabled() -> bool;
+                auto static trace_file() -> std::string;
+                auto static opcode_profile_file() -> std::string;
+                auto static opcode_profile_sampling_interval() -> uint64_t;
+                auto static stack_profile_file() -> std::string;
+                auto static stack_profile_sampling_interval() -> std::chrono::microseconds;
+                auto static allocation_profile_file() -> std::string;
+                auto static allocation_profile_sampling_interval() -> uint64_t;
+                auto static call_profile_file() -> std::string;
+                auto static is_lazy_linking_enabled() -> bool;
+                auto static is_message_timestamping_enabled() -> bool;
+                auto static process_memory_limit() -> std::size_t;
+                auto static hibernation_threshold() -> std::chrono::milliseconds;
+                auto static metrics_file() -> std::string;
+                auto static metrics_interval() -> std::chrono::milliseconds;
+                auto static introspection_socket() -> std::string;
+                auto static is_telemetry_enabled() -> bool;
 
                 int run();
 
@@ -45,6 +45,7 @@ namespace viua {
             public:
             void reset(std::unique_ptr<viua::types::Value>);
             bool empty() const;
+            std::size_t memory_footprint() const;
 
             viua::types::Value* get();
             viua::types::Value* release();
@@ -97,6 +98,15 @@ namespace viua {
 
                 void drop();
                 inline viua::internals::types::register_index size() { return registerset_size; }
+                std::size_t memory_footprint() const;
+
+                /*  Compacting drops trailing empty registers, and
+                 *  expanding brings them back.
+                 *  Pointers to registers of the set are invalidated by both operations.
+                 */
+                void compact();
+                void expand();
+                bool contains(const Register*) const;
 
                 std::unique_ptr<RegisterSet> copy();
 
@@ -24,7 +24,6 @@
 
 
 #include <cstdint>
-#include <fstream>
 #include <tuple>
 #include <string>
 #include <vector>
@@ -32,18 +31,36 @@
 #include <memory>
 #include <viua/machine.h>
 #include <viua/bytecode/bytetypedef.h>
+#include <viua/bytecode/symbol_index.h>
 
 typedef std::tuple<std::vector<std::string>, std::map<std::string, viua::internals::types::bytecode_size> > IdToAddressMapping;
 
-template<class T> void readinto(std::ifstream& in, T* object) {
-    in.read(reinterpret_cast<char*>(object), sizeof(T));
-}
 
 class Loader {
+    /*  Loader maps the whole file into memory (read-only, private mapping) and
+     *  reads sections directly from the mapped region.
+     *  Pages of the file are shared between all processes that map the same
+     *  binary, and the bytecode is never copied unless a caller explicitly asks
+     *  for a copy with getBytecode().
+     *
+     *  If the file cannot be mapped it is read into a buffer on the heap; the rest
+     *  of the loader works the same way in both cases.
+     */
+    using byte = viua::internals::types::byte;
+
+    struct Section {
+        const byte* data;
+        viua::internals::types::bytecode_size size;
+    };
+
     std::string path;
 
+    std::shared_ptr<byte[]> image;
+    std::size_t image_size;
+    std::size_t cursor;
+
     viua::internals::types::bytecode_size size;
-    std::unique_ptr<viua::internals::types::byte[]> bytecode;
+    byte* bytecode;
 
     std::vector<viua::internals::types::bytecode_size> jumps;
 
@@ -51,6 +68,16 @@ class Loader {
 
     std::vector<std::string> external_signatures;
     std::vector<std::string> external_signatures_block;
+    Section external_functions_section;
+    Section external_blocks_section;
+
+    /*  Function and block maps are only decoded from their sections when they
+     *  are first requested.
+     */
+    Section functions_section;
+    Section blocks_section;
+    bool functions_decoded;
+    bool blocks_decoded;
 
     std::map<std::string, viua::internals::types::bytecode_size> function_addresses;
     std::map<std::string, viua::internals::types::bytecode_size> function_sizes;
@@ -58,20 +85,30 @@ class Loader {
     std::map<std::string, viua::internals::types::bytecode_size> block_addresses;
     std::vector<std::string> blocks;
 
-    IdToAddressMapping loadmap(char*, const viua::internals::types::bytecode_size&);
+    viua::bytecode::symbol_index::Index symbol_index;
+
+    IdToAddressMapping loadmap(const char*, const viua::internals::types::bytecode_size&);
     void calculateFunctionSizes();
+    void decodeFunctions();
+    void decodeBlocks();
+
+    void mapImage();
+    const byte* take(std::size_t);
+    viua::internals::types::bytecode_size takeSize();
+    Section takeSection();
 
-    void loadMagicNumber(std::ifstream&);
-    void assumeBinaryType(std::ifstream&, ViuaBinaryType);
+    void loadMagicNumber();
+    void assumeBinaryType(ViuaBinaryType);
 
-    void loadMetaInformation(std::ifstream&);
+    void loadMetaInformation();
 
-    void loadExternalSignatures(std::ifstream&);
-    void loadExternalBlockSignatures(std::ifstream&);
-    void loadJumpTable(std::ifstream&);
-    void loadFunctionsMap(std::ifstream&);
-    void loadBlocksMap(std::ifstream&);
-    void loadBytecode(std::ifstream&);
+    void loadExternalSignatures();
+    void loadExternalBlockSignatures();
+    void loadJumpTable();
+    void loadFunctionsMap();
+    void loadBlocksMap();
+    void loadBytecode();
+    void loadSymbolIndex();
 
     public:
     Loader& load();
@@ -79,6 +116,11 @@ class Loader {
 
     viua::internals::types::bytecode_size getBytecodeSize();
     std::unique_ptr<viua::internals::types::byte[]> getBytecode();
+    /*  Returns bytecode without copying it.
+     *  The returned pointer keeps the whole mapped file alive, and the memory must
+     *  not be written to.
+     */
+    std::shared_ptr<viua::internals::types::byte[]> mapBytecode();
 
     std::vector<viua::internals::types::bytecode_size> getJumps();
 
@@ -94,7 +136,26 @@ class Loader {
     std::map<std::string, viua::internals::types::bytecode_size> getBlockAddresses();
     std::vector<std::string> getBlocks();
 
-    Loader(std::string pth): path(pth), size(0), bytecode(nullptr) {}
+    /*  Symbol index is only present in binaries produced by assemblers that write it.
+     *  Tables of the index point into the loaded file, so they are valid as long as
+     *  the pointer returned by mapBytecode() is.
+     */
+    bool hasSymbolIndex() const;
+    const viua::bytecode::symbol_index::Index& getSymbolIndex() const;
+
+    Loader(std::string pth)
+        : path(pth)
+        , image(nullptr)
+        , image_size(0)
+        , cursor(0)
+        , size(0)
+        , bytecode(nullptr)
+        , external_functions_section{nullptr, 0}
+        , external_blocks_section{nullptr, 0}
+        , functions_section{nullptr, 0}
+        , blocks_section{nullptr, 0}
+        , functions_decoded(false)
+        , blocks_decoded(false) {}
     ~Loader() {
     }
 };
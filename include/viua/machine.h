@@ -27,6 +27,9 @@
 
 extern const char *ENTRY_FUNCTION_NAME;
 extern const char *VIUA_MAGIC_NUMBER;
+extern const char *VIUA_SYMBOL_INDEX_MAGIC;
+extern const char *VIUA_IMAGE_MAGIC;
+extern const char *VIUA_TRACE_MAGIC;
 
 typedef char ViuaBinaryType;
 
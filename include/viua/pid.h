@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 
@@ -31,17 +32,24 @@ namespace viua {
 
         class PID {
             const viua::process::Process *associated_process;
+            /*
+             * Addresses of processes are reused after the processes die, but
+             * PIDs of dead processes may still be around (e.g. in slots for
+             * results of joinable processes) so every PID also gets a serial
+             * number that is never reused. PIDs are compared only by it.
+             */
+            uint64_t serial;
 
             public:
             bool operator==(const viua::process::PID&) const;
-            bool operator==(const viua::process::Process*) const;
             bool operator<(const viua::process::PID&) const;
             bool operator>(const viua::process::PID&) const;
 
             auto get() const -> decltype(associated_process);
-            auto str() const -> std::string;
+            auto serial_number() const -> uint64_t;
+            auto str() const -> std::string;  // address of the process, and the serial
 
-            PID(const viua::process::Process*);
+            explicit PID(const viua::process::Process*);
         };
     }
 }
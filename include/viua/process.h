@@ -35,6 +35,8 @@
 #include <viua/kernel/registerset.h>
 #include <viua/kernel/tryframe.h>
 #include <viua/pid.h>
+#include <viua/scheduler/profiling.h>
+#include <viua/scheduler/telemetry.h>
 #include <viua/types/prototype.h>
 #include <viua/types/value.h>
 
@@ -106,6 +108,12 @@ namespace viua {
             viua::internals::types::byte* jump_base;
             viua::internals::types::byte* instruction_pointer;
 
+            /*  Set if the module of the currently executed function passed
+             *  verification; checks already done by the verifier are not repeated
+             *  while such code runs.
+             */
+            bool verified_code;
+
             std::unique_ptr<Frame> frame_new;
             using size_type = decltype(frames)::size_type;
 
@@ -159,6 +167,8 @@ namespace viua {
             auto size() const -> decltype(frames)::size_type;
             auto clear() -> void;
 
+            auto memory_footprint() const -> std::size_t;
+
             auto emplace_back(std::unique_ptr<Frame> f) -> decltype(frames.emplace_back(f));
 
             auto prepare_frame(viua::internals::types::register_index, viua::internals::types::register_index)
@@ -184,8 +194,20 @@ namespace viua {
              * regarding executed code.
              */
             const bool tracing_enabled;
-            auto get_trace_line(viua::internals::types::byte*) const -> std::string;
-            auto emit_trace_line(viua::internals::types::byte*) const -> void;
+            auto emit_trace_record(viua::internals::types::byte*) const -> void;
+
+            /*
+             * Calls made by the process (null if call profiling is disabled), and
+             * the clock measuring time the process spent running: total time of its
+             * finished quants, and the start of the current one (if any).
+             */
+            std::unique_ptr<viua::scheduler::profiling::CallProfile> call_profile;
+            uint64_t running_time;
+            std::chrono::steady_clock::time_point quant_started_at;
+            auto profile_clocks() const -> std::pair<uint64_t, uint64_t>;
+            auto profile_enter(Frame*, const std::string&) -> void;
+            auto profile_leave(Frame*, Frame*) -> void;
+            auto profile_leave_all() -> void;
 
             /*
              * Pointer to scheduler the process is currently bound to.
@@ -223,6 +245,22 @@ namespace viua {
 
             std::queue<std::unique_ptr<viua::types::Value>> message_queue;
 
+            /*  Account charged for values allocated by the process (null if memory
+             *  is not accounted).
+             */
+            viua::types::MemoryAccount* memory_account{nullptr};
+
+            /*  Moves messages sent to the process from its mailbox to its message queue.
+             */
+            auto collect_messages() -> void;
+
+            /*  Times at which queued messages were sent (empty if message timestamps
+             *  are disabled), and the histogram of times messages spent queued.
+             */
+            std::queue<std::chrono::steady_clock::time_point> message_timestamps;
+            viua::scheduler::telemetry::Histogram message_latency;
+            auto record_message_latency() -> void;
+
             viua::types::Value* fetch(viua::internals::types::register_index) const;
             std::unique_ptr<viua::types::Value> pop(viua::internals::types::register_index);
             void place(viua::internals::types::register_index, std::unique_ptr<viua::types::Value>);
@@ -268,6 +306,16 @@ namespace viua {
             bool timeout_active = false;
             bool wait_until_infinity = false;
 
+            /*  Hibernation.
+             *  A process that is blocked waiting for a message may be compacted: trailing
+             *  empty registers of its register sets are dropped until a message arrives.
+             */
+            std::chrono::steady_clock::time_point waiting_since;
+            bool waiting_for_message = false;
+            bool hibernated = false;
+            bool hibernation_requested = false;
+            auto hibernatable_register_sets() -> std::vector<viua::kernel::RegisterSet*>;
+
             /*  Methods implementing individual instructions.
              */
             viua::internals::types::byte* opizero(viua::internals::types::byte*);
@@ -309,6 +357,15 @@ namespace viua {
             viua::internals::types::byte* opvpop(viua::internals::types::byte*);
             viua::internals::types::byte* opvat(viua::internals::types::byte*);
             viua::internals::types::byte* opvlen(viua::internals::types::byte*);
+            viua::internals::types::byte* opvsum(viua::internals::types::byte*);
+            viua::internals::types::byte* opvmin(viua::internals::types::byte*);
+            viua::internals::types::byte* opvmax(viua::internals::types::byte*);
+            viua::internals::types::byte* opvdot(viua::internals::types::byte*);
+            viua::internals::types::byte* opvadd(viua::internals::types::byte*);
+            viua::internals::types::byte* opvsub(viua::internals::types::byte*);
+            viua::internals::types::byte* opvmul(viua::internals::types::byte*);
+            viua::internals::types::byte* opvdiv(viua::internals::types::byte*);
+            viua::internals::types::byte* opvsort(viua::internals::types::byte*);
 
             viua::internals::types::byte* boolean(viua::internals::types::byte*);
             viua::internals::types::byte* opnot(viua::internals::types::byte*);
@@ -423,6 +480,14 @@ namespace viua {
             viua::internals::types::byte* opstructremove(viua::internals::types::byte*);
             viua::internals::types::byte* opstructkeys(viua::internals::types::byte*);
 
+            viua::internals::types::byte* opdict(viua::internals::types::byte*);
+            viua::internals::types::byte* opdictinsert(viua::internals::types::byte*);
+            viua::internals::types::byte* opdictat(viua::internals::types::byte*);
+            viua::internals::types::byte* opdicthas(viua::internals::types::byte*);
+            viua::internals::types::byte* opdictremove(viua::internals::types::byte*);
+            viua::internals::types::byte* opdictsize(viua::internals::types::byte*);
+            viua::internals::types::byte* opdictkeys(viua::internals::types::byte*);
+
             viua::internals::types::byte* opnew(viua::internals::types::byte*);
             viua::internals::types::byte* opmsg(viua::internals::types::byte*);
             viua::internals::types::byte* opinsert(viua::internals::types::byte*);
@@ -484,6 +549,37 @@ namespace viua {
 
             bool empty() const;
 
+            /*  Approximate number of bytes of memory used by values held by the process:
+             *  in its registers, call stacks, and message queue.
+             */
+            auto memory_usage() -> std::size_t;
+
+            /*  Number of bytes of values allocated by the process and not freed yet
+             *  (messages it received count as allocated by it).
+             *  Unlike memory usage it is kept up to date as the process runs so it is
+             *  cheap to check after every quant.
+             */
+            auto allocated_memory() const -> std::size_t;
+            auto allocation_account() const -> viua::types::MemoryAccount*;
+
+            auto request_hibernation() -> void;
+            auto should_hibernate(const std::chrono::milliseconds) const -> bool;
+            auto hibernate() -> void;
+            auto hibernating() const -> bool;
+            auto blocked_in_receive() const -> bool;
+            auto queued_messages() const -> std::size_t;
+            auto message_latency_histogram() const -> const viua::scheduler::telemetry::Histogram&;
+
+            /*  Hooks of the call profiler (they do nothing unless call profiling is enabled).
+             *  Foreign calls are finished by FFI schedulers while the process is
+             *  suspended so they are accounted as waiting time.
+             */
+            auto begin_quant() -> void;
+            auto end_quant() -> void;
+            auto profile_foreign_call_finished(Frame*) -> void;
+            auto ready_to_wake_up() -> bool;
+            auto rehydrate() -> void;
+
             Process(std::unique_ptr<Frame>, viua::scheduler::VirtualProcessScheduler*,
                     viua::process::Process*, const bool = false);
             ~Process();
@@ -105,6 +105,15 @@ class Program {
     Program& opvpop(int_op, int_op, int_op);
     Program& opvat(int_op, int_op, int_op);
     Program& opvlen(int_op, int_op);
+    Program& opvsum(int_op, int_op);
+    Program& opvmin(int_op, int_op);
+    Program& opvmax(int_op, int_op);
+    Program& opvdot(int_op, int_op, int_op);
+    Program& opvadd(int_op, int_op, int_op);
+    Program& opvsub(int_op, int_op, int_op);
+    Program& opvmul(int_op, int_op, int_op);
+    Program& opvdiv(int_op, int_op, int_op);
+    Program& opvsort(int_op);
 
     Program& opnot(int_op, int_op);
     Program& opand(int_op, int_op, int_op);
@@ -224,6 +233,14 @@ class Program {
     Program& opstructremove(int_op, int_op, int_op);
     Program& opstructkeys(int_op, int_op);
 
+    Program& opdict(int_op);
+    Program& opdictinsert(int_op, int_op, int_op);
+    Program& opdictat(int_op, int_op, int_op);
+    Program& opdicthas(int_op, int_op, int_op);
+    Program& opdictremove(int_op, int_op, int_op);
+    Program& opdictsize(int_op, int_op);
+    Program& opdictkeys(int_op, int_op);
+
     Program& opnew(int_op, const std::string&);
     Program& opmsg(int_op, const std::string&);
     Program& opmsg(int_op, int_op);
@@ -24,6 +24,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <viua/include/module.h>
+#include <viua/util/persistent_map.h>
+#include <viua/util/published.h>
 
 
 namespace viua {
@@ -54,7 +56,7 @@ namespace viua {
                     ~ForeignFunctionCallRequest() {}
             };
 
-            void ff_call_processor(std::vector<std::unique_ptr<ForeignFunctionCallRequest>> *requests, std::map<std::string, ForeignFunction*> *foreign_functions, std::mutex *ff_map_mtx, std::mutex *mtx, std::condition_variable *cv);
+            void ff_call_processor(std::vector<std::unique_ptr<ForeignFunctionCallRequest>> *requests, const viua::util::Published<viua::util::PersistentMap<std::string, ForeignFunction*>> *foreign_functions, std::mutex *mtx, std::condition_variable *cv);
         }
     }
 }
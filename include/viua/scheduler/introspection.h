@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_SCHEDULER_INTROSPECTION_H
+#define VIUA_SCHEDULER_INTROSPECTION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <viua/bytecode/bytetypedef.h>
+
+
+namespace viua {
+    namespace kernel {
+        class Kernel;
+    }
+}
+
+namespace viua {
+    namespace scheduler {
+        namespace introspection {
+            struct ProcessInfo {
+                std::string pid;
+                std::string state;
+                viua::internals::types::process_time_slice_type priority;
+                std::size_t queued_messages;
+
+                // function names, from the entry point to the most recent call
+                std::vector<std::string> stack;
+            };
+
+            struct Snapshot {
+                std::chrono::steady_clock::time_point taken_at;
+                std::vector<ProcessInfo> processes;
+            };
+
+            class Board {
+                /** Latest snapshot of processes of a single VP scheduler.
+                 *
+                 *  Readers never stop the scheduler: they ask for a new snapshot
+                 *  and the scheduler publishes one between two bursts, when its
+                 *  processes are not running.
+                 *  A reader that does not want to wait uses whatever snapshot was
+                 *  published last.
+                 */
+                std::shared_ptr<const Snapshot> latest;
+                std::atomic<uint64_t> requested_generation{0};
+                std::atomic<uint64_t> published_generation{0};
+
+              public:
+                // called by readers; returns the generation to wait for
+                auto request() -> uint64_t;
+                auto requested() const -> uint64_t;
+                auto published() const -> uint64_t;
+
+                // called by the scheduler owning the board
+                auto wanted() const -> bool;
+                auto publish(Snapshot, const uint64_t) -> void;
+
+                auto load() const -> std::shared_ptr<const Snapshot>;
+
+                Board();
+            };
+
+            class Server {
+                /** Answers queries about a running kernel on a Unix domain socket.
+                 *
+                 *  Queries are lines of text; every answer ends with an empty line.
+                 *  Clients are served one at a time by a dedicated thread which reads
+                 *  only snapshots published by schedulers, telemetry counters, and
+                 *  published symbol tables of the kernel.
+                 */
+                viua::kernel::Kernel& kernel;
+                const std::vector<std::unique_ptr<Board>>& boards;
+                const std::string path;
+                int listening_socket;
+                std::atomic_bool done;
+                std::thread server_thread;
+
+                auto serve() -> void;
+                auto converse(const int) -> void;
+                auto snapshots() -> std::vector<std::shared_ptr<const Snapshot>>;
+
+                auto list_processes() -> std::string;
+                auto stack_of(const std::string&) -> std::string;
+                auto list_modules() const -> std::string;
+                auto list_foreign_functions() const -> std::string;
+                auto list_schedulers() -> std::string;
+
+              public:
+                auto answer(const std::string&) -> std::string;
+
+                auto start() -> void;
+                auto stop() -> void;
+
+                Server(viua::kernel::Kernel&, const std::vector<std::unique_ptr<Board>>&, std::string);
+                Server(const Server&) = delete;
+                auto operator=(const Server&) -> Server& = delete;
+                ~Server();
+            };
+        }
+    }
+}
+
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VIUA_SCHEDULER_PROFILING_H
+#define VIUA_SCHEDULER_PROFILING_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <viua/types/value.h>
+#if defined(__x86_64__) or defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+class Frame;
+
+namespace viua {
+    namespace scheduler {
+        namespace profiling {
+            /*  Cycle counter on x86, and a nanosecond clock elsewhere.
+             */
+            inline auto cycles() -> uint64_t {
+#if defined(__x86_64__) or defined(__i386__)
+                return __rdtsc();
+#else
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 std::chrono::steady_clock::now().time_since_epoch())
+                                                 .count());
+#endif
+            }
+
+            class OpcodeProfile {
+                /** Numbers of executions of every opcode.
+                 *
+                 *  Every scheduler keeps its own profile so counting is not
+                 *  contended; profiles are merged when the kernel exits.
+                 *  If sampling is enabled, cycles are also measured for every
+                 *  n-th executed instruction.
+                 */
+              public:
+                struct Entry {
+                    uint64_t executions;
+                    uint64_t samples;
+                    uint64_t cycles;
+                };
+
+              private:
+                std::array<Entry, 256> entries;
+                uint64_t sampling_interval;
+                uint64_t until_next_sample;
+                uint64_t sample_started;
+                bool sampling;
+
+              public:
+                inline auto begin(const uint8_t opcode) -> void {
+                    ++entries[opcode].executions;
+                    // end() is skipped for instructions that throw, so their samples are dropped here
+                    sampling = false;
+                    if (sampling_interval and (--until_next_sample == 0)) {
+                        until_next_sample = sampling_interval;
+                        sampling = true;
+                        sample_started = cycles();
+                    }
+                }
+                inline auto end(const uint8_t opcode) -> void {
+                    if (sampling) {
+                        auto& entry = entries[opcode];
+                        entry.cycles += (cycles() - sample_started);
+                        ++entry.samples;
+                        sampling = false;
+                    }
+                }
+
+                auto merge(const OpcodeProfile&) -> void;
+
+                auto write_table(std::ostream&) const -> void;
+                auto write_json(std::ostream&) const -> void;
+
+                OpcodeProfile(const uint64_t = 0);
+            };
+
+            class StackProfile {
+                /** Samples of call stacks of processes.
+                 *
+                 *  Every scheduler keeps its own profile.
+                 *  Each time the sampling interval elapses the scheduler records
+                 *  the stack of every process it runs, and profiles of all schedulers are
+                 *  merged and written in collapsed-stack format (one line per
+                 *  unique stack: "main/0;foo/1;bar/2 <count>") when the kernel exits.
+                 */
+                std::unordered_map<std::string, uint64_t> stacks;
+                std::chrono::microseconds interval;
+                std::chrono::steady_clock::time_point next_sample_at;
+
+              public:
+                inline auto due() -> bool {
+                    auto const now = std::chrono::steady_clock::now();
+                    if (now < next_sample_at) {
+                        return false;
+                    }
+                    next_sample_at = (now + interval);
+                    return true;
+                }
+
+                auto record(const std::string&) -> void;
+                auto merge(const StackProfile&) -> void;
+                auto write_collapsed(std::ostream&) const -> void;
+
+                StackProfile(const std::chrono::microseconds = std::chrono::microseconds{1000});
+            };
+
+            class AllocationProfile : public viua::types::AllocationObserver {
+                /** Counts and sizes of values allocated by processes, by type and by
+                 *  allocation site (function and offset of the instruction).
+                 *
+                 *  Every scheduler keeps its own profile and observes allocations
+                 *  made by its thread.
+                 *  Types of values are only known once they are fully constructed, so
+                 *  allocations are kept pending until the instruction that made them
+                 *  finishes.
+                 *  Values freed before that are counted as "(temporary)".
+                 *  If sampling is enabled only every n-th allocation is recorded, and
+                 *  its count and size are scaled by n.
+                 */
+              public:
+                struct Entry {
+                    uint64_t count;
+                    uint64_t bytes;
+                };
+
+              private:
+                struct Pending {
+                    viua::types::Value* value;
+                    std::size_t size;
+                    std::string function;
+                    uint64_t offset;
+                };
+
+                std::unordered_map<std::string, Entry> types;
+                std::map<std::tuple<std::string, uint64_t, std::string>, Entry> sites;
+                std::vector<Pending> pending;
+                uint64_t sampling_interval;
+                uint64_t until_next_sample;
+                const std::string* site_function;
+                uint64_t site_offset;
+
+                auto account(const Pending&, const std::string&) -> void;
+                auto settle_pending() -> void;
+
+              public:
+                inline auto at(const std::string* function, const uint64_t offset) -> void {
+                    site_function = function;
+                    site_offset = offset;
+                }
+                inline auto settle() -> void {
+                    if (not pending.empty()) {
+                        settle_pending();
+                    }
+                    site_function = nullptr;
+                }
+
+                auto allocated(viua::types::Value*, const std::size_t) -> void override;
+                auto released(viua::types::Value*) -> void override;
+
+                auto merge(const AllocationProfile&) -> void;
+                auto write_report(std::ostream&) const -> void;
+
+                AllocationProfile(const uint64_t = 1);
+            };
+
+            class CallProfile {
+                /** Calls of functions made by a single process.
+                 *
+                 *  Every call is recorded (there is no sampling) with its inclusive
+                 *  and exclusive running time, i.e. time the process was actually
+                 *  executing instructions.
+                 *  Time during which the process was not running (suspended waiting for a
+                 *  foreign call or a message, or waiting for its turn to run) is
+                 *  reported separately as waiting time.
+                 *  Times of recursive calls are counted once for every activation.
+                 */
+              public:
+                struct Entry {
+                    uint64_t calls;
+                    uint64_t inclusive;
+                    uint64_t exclusive;
+                    uint64_t waiting;
+                };
+
+              private:
+                std::unordered_map<std::string, Entry> functions;
+                std::map<std::pair<std::string, std::string>, Entry> arcs;
+
+                friend class CallProfiles;
+
+              public:
+                auto enter(Frame*, const std::string&, const uint64_t, const uint64_t) -> void;
+                auto leave(Frame*, Frame*, const uint64_t, const uint64_t) -> void;
+                auto merge(const CallProfile&) -> void;
+            };
+
+            class CallProfiles {
+                /** Call profiles of processes run by a scheduler.
+                 *
+                 *  Profiles of finished processes are merged into a profile of all
+                 *  processes, and into profiles of processes started with the same
+                 *  function.
+                 *  Profiles of all schedulers are merged and written as a flat profile and
+                 *  a call graph when the kernel exits.
+                 */
+                CallProfile all;
+                std::map<std::string, std::pair<uint64_t, CallProfile>> processes;
+
+              public:
+                auto record(const std::string&, const CallProfile&) -> void;
+                auto merge(const CallProfiles&) -> void;
+                auto write_report(std::ostream&) const -> void;
+            };
+        }
+    }
+}
+
+
+#endif
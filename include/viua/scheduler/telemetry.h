@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VIUA_SCHEDULER_TELEMETRY_H
+#define VIUA_SCHEDULER_TELEMETRY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+
+namespace viua {
+    namespace scheduler {
+        namespace telemetry {
+            /*  Counters are written only by the thread of the scheduler owning
+             *  them, but may be read at any time by other threads (e.g. the metrics
+             *  exporter, or foreign functions).
+             *  Since there is a single writer a plain load-and-store is enough, and
+             *  is cheaper than an atomic read-modify-write.
+             */
+            inline auto bump(std::atomic<uint64_t>& counter, const uint64_t n = 1) -> void {
+                counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+            inline auto bump(std::atomic<uint64_t>& counter, const std::chrono::steady_clock::duration duration)
+                -> void {
+                bump(counter,
+                     static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+            }
+
+            /*  Upper bounds (in microseconds) of buckets of duration histograms.
+             *  The last, implicit, bucket is unbounded.
+             */
+            const std::array<uint64_t, 6> DURATION_BUCKETS = {10, 100, 1000, 10000, 100000, 1000000};
+
+            struct Histogram {
+                std::array<std::atomic<uint64_t>, DURATION_BUCKETS.size() + 1> buckets{};
+                std::atomic<uint64_t> sum_ns{0};
+                std::atomic<uint64_t> count{0};
+                std::atomic<uint64_t> max_ns{0};
+
+                auto record(const std::chrono::steady_clock::duration) -> void;
+            };
+
+            struct Counters {
+                std::atomic<uint64_t> bursts{0};
+                std::atomic<uint64_t> quants{0};
+                std::atomic<uint64_t> ticks{0};
+                std::atomic<uint64_t> busy_ns{0};
+                std::atomic<uint64_t> idle_ns{0};
+                std::atomic<uint64_t> spawned{0};
+                std::atomic<uint64_t> posted{0};
+                std::atomic<uint64_t> grabbed{0};
+                std::atomic<uint64_t> ffi_calls{0};
+
+                // gauges
+                std::atomic<uint64_t> run_queue{0};
+                std::atomic<uint64_t> load{0};
+                std::atomic<uint64_t> process_memory{0};
+
+                Histogram burst_duration;
+
+                /*  Time between sending a message and its receiver taking it out of
+                 *  its queue (recorded only if message timestamps are enabled).
+                 */
+                Histogram message_latency;
+
+                auto record_burst(const std::chrono::steady_clock::duration) -> void;
+            };
+
+            auto write_prometheus(std::ostream&, const std::vector<const Counters*>&) -> void;
+        }
+    }
+}
+
+
+#endif
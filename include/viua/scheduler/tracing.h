@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef VIUA_SCHEDULER_TRACING_H
+#define VIUA_SCHEDULER_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace viua {
+    namespace scheduler {
+        namespace tracing {
+            /*  Version of the trace file format.
+             *  Must be bumped every time the layout of Record changes.
+             */
+            const uint32_t TRACE_FORMAT_VERSION = 2;
+
+            /*  A trace file begins with VIUA_TRACE_MAGIC (including the terminating
+             *  null byte), the format version, and the size of a single record.
+             *  Records follow until the end of file.
+             *  All numbers are stored in the byte order of the machine that wrote the trace.
+             */
+            struct Record {
+                uint64_t timestamp;  // nanoseconds since the trace was started
+                uint64_t pid;  // serial number of the PID of the process
+                uint64_t ip;  // offset of the instruction from the beginning of its module
+                uint32_t depth;
+                uint16_t scheduler;
+                uint8_t opcode;
+                uint8_t flags;
+            };
+
+            const uint8_t RECORD_EXCEPTION_ACTIVE = 0x01;
+
+            class Sink {
+                /** Trace file shared by all schedulers of a kernel.
+                 *
+                 *  Schedulers collect records in their own buffers and hand
+                 *  full buffers over to a writer thread, getting an empty
+                 *  one in exchange, so they never wait for the disk.
+                 *  The file is flushed only when the sink is destroyed.
+                 */
+                std::ofstream out;
+                std::atomic<uint16_t> buffers;
+
+                std::mutex queue_mtx;
+                std::condition_variable queue_cv;
+                // full buffers, and the number of records in each of them
+                std::queue<std::pair<std::vector<Record>, std::size_t>> written;
+                std::vector<std::vector<Record>> spare;
+                bool closing;
+                std::thread writer;
+
+                auto write_buffers() -> void;
+
+              public:
+                const std::chrono::steady_clock::time_point started;
+
+                /*  Takes a buffer with the given number of records, and returns an
+                 *  empty buffer of the given capacity.
+                 */
+                auto submit(std::vector<Record>, const std::size_t) -> std::vector<Record>;
+                auto register_buffer() -> uint16_t;
+
+                Sink(const std::string&);
+                ~Sink();
+            };
+
+            class Buffer {
+                /** Ring buffer of trace records owned by a single scheduler.
+                 *
+                 *  Only the thread running the scheduler touches the buffer so
+                 *  recording does not need any synchronisation.
+                 *  When the buffer fills up it is submitted to the sink, and
+                 *  recording continues in an empty buffer.
+                 */
+                Sink* sink;
+                std::vector<Record> records;
+                std::size_t next;
+                uint16_t scheduler_id;
+
+              public:
+                inline auto record(const uint64_t pid, const uint64_t ip, const uint32_t depth,
+                                   const uint8_t opcode, const uint8_t flags) -> void {
+                    auto& r = records[next];
+                    r.timestamp = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - sink->started)
+                            .count());
+                    r.pid = pid;
+                    r.ip = ip;
+                    r.depth = depth;
+                    r.scheduler = scheduler_id;
+                    r.opcode = opcode;
+                    r.flags = flags;
+
+                    if (++next == records.size()) {
+                        flush();
+                    }
+                }
+
+                auto flush() -> void;
+
+                Buffer(Sink*, const std::size_t = 4096);
+                Buffer(Buffer&&);
+                ~Buffer();
+            };
+        }
+    }
+}
+
+
+#endif
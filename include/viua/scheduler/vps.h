@@ -28,8 +28,14 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <viua/bytecode/bytetypedef.h>
 #include <viua/kernel/frame.h>
+#include <viua/scheduler/introspection.h>
+#include <viua/scheduler/profiling.h>
+#include <viua/scheduler/telemetry.h>
+#include <viua/scheduler/tracing.h>
+#include <viua/types/atom.h>
 
 
 namespace viua {
@@ -44,6 +50,20 @@ namespace viua {
 
 namespace viua {
     namespace scheduler {
+        struct Instrumentation {
+            /** Optional tracing, profiling, and telemetry sinks of a scheduler.
+             *
+             *  All of them are owned by the kernel; null ones are disabled.
+             */
+            viua::scheduler::tracing::Sink* trace_sink = nullptr;
+            viua::scheduler::profiling::OpcodeProfile* opcode_profile = nullptr;
+            viua::scheduler::profiling::StackProfile* stack_profile = nullptr;
+            viua::scheduler::profiling::AllocationProfile* allocation_profile = nullptr;
+            viua::scheduler::profiling::CallProfiles* call_profiles = nullptr;
+            viua::scheduler::telemetry::Counters* counters = nullptr;
+            viua::scheduler::introspection::Board* introspection_board = nullptr;
+        };
+
         class VirtualProcessScheduler {
             /** Scheduler of Viua VM virtual processes.
              */
@@ -55,6 +75,61 @@ namespace viua {
              * regarding executed code.
              */
             const bool tracing_enabled;
+            viua::scheduler::tracing::Buffer trace_buffer;
+
+            /*
+             * Maximum number of bytes a process may use (zero if there is no limit).
+             * Processes are measured after each quant they run for, and
+             * those that exceed the limit receive an exception.
+             */
+            const std::size_t process_memory_limit;
+
+            /*
+             * Processes waiting for a message for longer than this are
+             * hibernated (zero disables automatic hibernation).
+             */
+            const std::chrono::milliseconds hibernation_threshold;
+
+            /*
+             * Per-opcode execution counts (null if opcode profiling is disabled).
+             * The profile is owned by the kernel which merges profiles of all
+             * schedulers when it exits.
+             */
+            viua::scheduler::profiling::OpcodeProfile* opcode_profile_of_scheduler;
+
+            /*
+             * Sampled call stacks of processes (null if stack sampling is disabled).
+             * Owned by the kernel, like the opcode profile.
+             */
+            viua::scheduler::profiling::StackProfile* stack_profile;
+            auto sample_stacks() -> void;
+
+            /*
+             * Values allocated by processes (null if allocation profiling is disabled).
+             * Owned by the kernel, like the opcode profile.
+             */
+            viua::scheduler::profiling::AllocationProfile* allocation_profile_of_scheduler;
+
+            /*
+             * Calls made by processes (null if call profiling is disabled).
+             * Owned by the kernel, like the opcode profile.
+             */
+            viua::scheduler::profiling::CallProfiles* call_profiles_of_scheduler;
+
+            /*
+             * Telemetry counters of the scheduler (owned by the kernel, null if
+             * telemetry is disabled).
+             */
+            viua::scheduler::telemetry::Counters* counters;
+            auto update_gauges() -> void;
+
+            /*
+             * Snapshots of processes for the introspection server (null if
+             * introspection is disabled).
+             * Owned by the kernel; snapshots are taken only when asked for.
+             */
+            viua::scheduler::introspection::Board* introspection_board;
+            auto publish_snapshot() -> void;
 
             std::vector<std::unique_ptr<viua::process::Process>> *free_processes;
             std::mutex *free_processes_mutex;
@@ -75,6 +150,17 @@ namespace viua {
             public:
 
             viua::kernel::Kernel* kernel() const;
+            inline auto tracer() -> viua::scheduler::tracing::Buffer& { return trace_buffer; }
+            inline auto opcode_profile() -> viua::scheduler::profiling::OpcodeProfile* {
+                return opcode_profile_of_scheduler;
+            }
+            inline auto telemetry() -> viua::scheduler::telemetry::Counters* { return counters; }
+            inline auto allocation_profile() -> viua::scheduler::profiling::AllocationProfile* {
+                return allocation_profile_of_scheduler;
+            }
+            inline auto call_profiles() -> viua::scheduler::profiling::CallProfiles* {
+                return call_profiles_of_scheduler;
+            }
 
             bool isClass(const std::string&) const;
             bool classAccepts(const std::string&, const std::string&) const;
@@ -92,6 +178,9 @@ namespace viua {
 
             std::string resolveMethodName(const std::string&, const std::string&) const;
             std::pair<viua::internals::types::byte*, viua::internals::types::byte*> getEntryPointOf(const std::string&) const;
+            auto is_verified_code(const viua::internals::types::byte*) const -> bool;
+
+            auto atom_literal_at(const viua::internals::types::byte*) const -> viua::types::Atom::handle_type;
 
             void registerPrototype(std::unique_ptr<viua::types::Prototype>);
 
@@ -108,7 +197,8 @@ namespace viua {
             viua::process::Process* spawn(std::unique_ptr<Frame>, viua::process::Process*, bool);
 
             void send(const viua::process::PID, std::unique_ptr<viua::types::Value>);
-            void receive(const viua::process::PID, std::queue<std::unique_ptr<viua::types::Value>>&);
+            void receive(const viua::process::PID, std::queue<std::unique_ptr<viua::types::Value>>&,
+                         std::queue<std::chrono::steady_clock::time_point>&);
 
             auto is_joinable(const viua::process::PID) const -> bool;
             auto is_stopped(const viua::process::PID) const -> bool;
@@ -118,6 +208,7 @@ namespace viua {
 
             bool executeQuant(viua::process::Process*, viua::internals::types::process_time_slice_type);
             bool burst();
+            auto fetch_free_processes() -> void;
 
             void operator()();
 
@@ -127,7 +218,10 @@ namespace viua {
             void join();
             int exit() const;
 
-            VirtualProcessScheduler(viua::kernel::Kernel*, std::vector<std::unique_ptr<viua::process::Process>>*, std::mutex*, std::condition_variable*, const bool = false);
+            VirtualProcessScheduler(viua::kernel::Kernel*, std::vector<std::unique_ptr<viua::process::Process>>*,
+                                    std::mutex*, std::condition_variable*, const std::size_t = 0,
+                                    const std::chrono::milliseconds = std::chrono::milliseconds{0},
+                                    const Instrumentation& = Instrumentation{});
             VirtualProcessScheduler(VirtualProcessScheduler&&);
             ~VirtualProcessScheduler();
         };
@@ -23,6 +23,8 @@
 #pragma once
 
 #include <sys/stat.h>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -31,6 +33,14 @@ namespace support {
         std::vector<std::string> getpaths(const std::string&);
         std::string getvar(const std::string&);
 
+        /*  Reads a non-negative number from a variable, or returns the default
+         *  if the variable is not set.
+         *  The number may be followed by one of the given suffixes, and is then
+         *  multiplied by the value the suffix maps to.
+         *  Throws a string describing the problem if the value is invalid.
+         */
+        uint64_t getnumber(const std::string&, const uint64_t, const std::map<std::string, uint64_t>& = {});
+
         bool isfile(const std::string&);
 
         namespace viua {
@@ -22,19 +22,39 @@
 
 #pragma once
 
+#include <string>
 #include <viua/types/value.h>
 
 
 namespace viua {
     namespace types {
         class Atom: public Value {
-                const std::string value;
+            public:
+                /*
+                 * Atoms are interned in a kernel-wide, append-only table.
+                 * A handle is a pointer to the string stored in that table so
+                 * two atoms are equal if, and only if, their handles are equal.
+                 * Handles stay valid until the VM exits.
+                 */
+                using handle_type = const std::string*;
+
+            private:
+                handle_type value;
 
             public:
                 static const std::string type_name;
 
+                static auto intern(const std::string&) -> handle_type;
+
+                /*
+                 * Returns handle of an already interned atom, or null if the string
+                 * was never interned (so no value can be keyed by it).
+                 */
+                static auto find(const std::string&) -> handle_type;
+
                 virtual std::string type() const override;
                 virtual bool boolean() const override;
+                std::size_t memory_footprint() const override;
 
                 virtual std::string str() const override;
                 virtual std::string repr() const override;
@@ -43,11 +63,13 @@ namespace viua {
                 virtual std::vector<std::string> inheritancechain() const override;
 
                 operator std::string () const;
+                auto handle() const -> handle_type;
                 auto operator == (const Atom&) const -> bool;
 
                 virtual std::unique_ptr<Value> copy() const override;
 
                 Atom(std::string);
+                Atom(handle_type);
                 ~Atom() override = default;
         };
     }
@@ -44,7 +44,10 @@ namespace viua {
 
                 bool boolean() const override;
 
+                std::size_t memory_footprint() const override;
+
                 std::unique_ptr<Value> copy() const override;
+                auto charge_to(MemoryAccount*) -> void override;
 
                 std::string name() const override;
                 viua::kernel::RegisterSet* rs() const;
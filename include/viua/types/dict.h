@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_TYPES_DICT_H
+#define VIUA_TYPES_DICT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <viua/types/atom.h>
+#include <viua/types/value.h>
+
+
+namespace viua {
+    namespace types {
+        class Dict : public Value {
+            /** Hash map.
+             *
+             *  Keys may be Integers, Atoms, Strings, Texts, or Bits.
+             *  Values of different types are always different keys, even if
+             *  they print the same.
+             *
+             *  The table uses open addressing with a separate array of control
+             *  bytes (one per slot) that are probed a group at a time, so most
+             *  misses are rejected without touching the keys at all.
+             *  Slots point into a dense array of entries kept in insertion
+             *  order; this is the order in which keys are listed.
+             */
+          public:
+            using size_type = std::size_t;
+
+            enum class KeyKind : uint8_t {
+                INTEGER,
+                ATOM,
+                STRING,
+                TEXT,
+                BITS,
+            };
+
+          private:
+            struct Key {
+                KeyKind kind;
+                int64_t integer;
+                Atom::handle_type atom;
+                std::string bytes;
+                std::size_t hash;
+
+                auto operator==(const Key&) const -> bool;
+            };
+            struct Entry {
+                Key key;
+                std::unique_ptr<Value> original_key;
+                std::unique_ptr<Value> value;
+            };
+
+            using control_type = int8_t;
+            using index_type = uint32_t;
+
+            std::vector<control_type> control;
+            std::vector<index_type> slots;
+            std::vector<Entry> entries;
+            size_type live_entries;
+            // heap memory held by keys of entries (including removed ones)
+            size_type key_bytes;
+
+            static auto make_key(Value*) -> Key;
+
+            auto find_slot(const Key&) const -> size_type;
+            auto find_free_slot(std::size_t) const -> size_type;
+            auto rehash(size_type) -> void;
+            auto capacity() const -> size_type;
+            auto charge_table() -> void;
+
+          public:
+            static const std::string type_name;
+
+            std::string type() const override;
+            std::string str() const override;
+            std::string repr() const override;
+            bool boolean() const override;
+            std::size_t memory_footprint() const override;
+
+            std::vector<std::string> bases() const override;
+            std::vector<std::string> inheritancechain() const override;
+
+            auto insert(Value*, std::unique_ptr<Value>) -> void;
+            auto at(Value*) -> Value*;
+            auto contains(Value*) const -> bool;
+            auto remove(Value*) -> std::unique_ptr<Value>;
+            auto size() const -> size_type;
+            auto keys() const -> std::vector<std::unique_ptr<Value>>;
+
+            std::unique_ptr<Value> copy() const override;
+            auto charge_to(MemoryAccount*) -> void override;
+
+            Dict();
+            ~Dict() override = default;
+        };
+    }
+}
+
+
+#endif
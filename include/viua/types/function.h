@@ -42,6 +42,8 @@ namespace viua {
 
                 bool boolean() const override;
 
+                std::size_t memory_footprint() const override;
+
                 std::unique_ptr<Value> copy() const override;
 
                 virtual std::string name() const;
@@ -45,6 +45,7 @@ namespace viua {
             std::string type() const override;
             std::string str() const override;
             bool boolean() const override;
+            std::size_t memory_footprint() const override;
 
             auto value() -> decltype(number);
 
@@ -44,6 +44,7 @@ namespace viua {
 
                 std::string type() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
 
                 std::string str() const override;
 
@@ -57,6 +58,7 @@ namespace viua {
                 inline Value* at(const std::string& s) { return attributes.at(s).get(); }
 
                 virtual std::unique_ptr<Value> copy() const override;
+                auto charge_to(MemoryAccount*) -> void override;
 
                 Object(const std::string& tn);
                 virtual ~Object();
@@ -66,6 +66,7 @@ namespace viua {
 
                 std::string type() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
 
                 std::vector<std::string> bases() const override;
                 std::vector<std::string> inheritancechain() const override;
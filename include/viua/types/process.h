@@ -58,6 +58,7 @@ namespace viua {
                 std::string str() const override;
                 std::string repr() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
                 std::unique_ptr<Value> copy() const override;
 
                 /*
@@ -67,6 +68,7 @@ namespace viua {
                 viua::process::PID pid() const;
 
                 Process(viua::process::Process*);
+                Process(viua::process::Process*, viua::process::PID);
         };
     }
 }
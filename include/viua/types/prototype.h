@@ -44,6 +44,7 @@ namespace viua {
 
                 std::string type() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
 
                 std::string str() const override;
 
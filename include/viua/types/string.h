@@ -59,6 +59,7 @@ namespace viua {
                 std::string str() const override;
                 std::string repr() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
 
                 std::unique_ptr<Value> copy() const override;
 
@@ -25,6 +25,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <viua/types/atom.h>
 #include <viua/types/value.h>
 
 
@@ -36,13 +37,21 @@ namespace viua {
              *  This type is used internally inside the VM.
              */
             private:
-                std::map<std::string, std::unique_ptr<Value>> attributes;
+                /*
+                 * Keys are interned atoms ordered by their handles so lookups only
+                 * compare pointers.
+                 * Keys are sorted by their names only when they are printed or
+                 * listed so that the output stays stable.
+                 */
+                std::map<Atom::handle_type, std::unique_ptr<Value>> attributes;
+                auto keys_by_name() const -> std::vector<Atom::handle_type>;
 
             public:
                 static const std::string type_name;
 
                 std::string type() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
 
                 std::string str() const override;
                 std::string repr() const override;
@@ -51,10 +60,13 @@ namespace viua {
                 std::vector<std::string> inheritancechain() const override;
 
                 virtual void insert(const std::string& key, std::unique_ptr<Value> value);
+                virtual void insert(const Atom& key, std::unique_ptr<Value> value);
                 virtual std::unique_ptr<Value> remove(const std::string& key);
-                virtual std::vector<std::string> keys() const;
+                virtual std::unique_ptr<Value> remove(const Atom& key);
+                virtual std::vector<Atom::handle_type> keys() const;
 
                 std::unique_ptr<Value> copy() const override;
+                auto charge_to(MemoryAccount*) -> void override;
 
                 ~Struct() override = default;
         };
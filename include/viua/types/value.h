@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -35,10 +37,78 @@ namespace viua {
 
     namespace types {
         class Pointer;
+        class Value;
+
+        class AllocationObserver {
+            /** Receives notifications about values allocated on the heap by the
+             *  thread observing allocations.
+             *
+             *  A value is reported when memory for it is allocated, before it is
+             *  constructed, so its type is only available after the expression that
+             *  allocated it finishes.
+             *  Its release is reported when the memory is freed.
+             */
+            public:
+                virtual auto allocated(Value*, const std::size_t) -> void = 0;
+                virtual auto released(Value*) -> void = 0;
+                virtual ~AllocationObserver() = default;
+        };
+
+        /*  Sets observer of allocations made by calling thread (null to stop observing).
+         */
+        auto observe_allocations(AllocationObserver*) -> void;
+
+        class MemoryAccount {
+            /** Number of bytes of values allocated by a process, and not freed yet.
+             *
+             *  Values are charged to the account set by the thread that allocated
+             *  them, and credited back to the same account when they are freed (by
+             *  whichever thread frees them).
+             *  Buffers owned by strings, vectors, and dicts are charged to the
+             *  account of the value that owns them when they grow.
+             *  The account is deleted when the process has released it and all values
+             *  charged to it are freed.
+             */
+            // charged bytes, plus one while the process holds the account
+            std::atomic<uint64_t> held;
+
+          public:
+            auto charge(const std::size_t) -> void;
+            auto credit(const std::size_t) -> void;
+            auto bytes() const -> uint64_t;
+            auto release() -> void;
+
+            MemoryAccount();
+        };
+
+        /*  Turns on accounting of memory of values.
+         *  Must be called before any value is allocated, as values allocated earlier
+         *  could not be told apart from accounted ones when they are freed.
+         */
+        auto account_memory() -> void;
+        auto accounting_memory() -> bool;
+
+        /*  Sets the account charged for values allocated by calling thread (null to
+         *  stop charging), and returns the previous one.
+         */
+        auto charge_allocations_to(MemoryAccount*) -> MemoryAccount*;
 
         class Value {
             friend class Pointer;
-            std::vector<Pointer*> pointers;
+            /*
+             *  Pointers taken to this value.
+             *  Most values never have a pointer taken so the list is
+             *  allocated when the first one is, and freed with the last one.
+             *  Copies of a value do not share its pointers.
+             */
+            std::unique_ptr<std::vector<Pointer*>> pointers;
+
+            protected:
+                /*  Sets the number of bytes of buffers owned by the value, and charges
+                 *  the difference to the account of the value.
+                 *  Values not allocated on the heap must not call it.
+                 */
+                auto charge_owned_memory(const std::size_t) -> void;
 
             public:
                 /** Basic interface of a Value.
@@ -51,6 +121,12 @@ namespace viua {
                 virtual std::string repr() const;
                 virtual bool boolean() const;
 
+                /*  Approximate number of bytes of memory held by the value, including
+                 *  the values it contains.
+                 *  Used to account memory of processes.
+                 */
+                virtual std::size_t memory_footprint() const;
+
                 virtual std::unique_ptr<Pointer> pointer(const viua::process::Process*);
 
                 virtual std::vector<std::string> bases() const;
@@ -58,7 +134,17 @@ namespace viua {
 
                 virtual std::unique_ptr<Value> copy() const = 0;
 
+                /*  Moves the value, and the values it contains, from the account they
+                 *  were charged to to the given one (e.g. when a message is received).
+                 */
+                virtual auto charge_to(MemoryAccount*) -> void;
+
+                static void* operator new(const std::size_t);
+                static void operator delete(void*, const std::size_t);
+
                 Value() = default;
+                Value(const Value&);
+                auto operator=(const Value&) -> Value&;
                 virtual ~Value();
         };
     }
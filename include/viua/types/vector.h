@@ -22,8 +22,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include <viua/types/bits.h>
+#include <viua/types/float.h>
+#include <viua/types/integer.h>
 #include <viua/types/value.h>
 
 
@@ -31,8 +35,48 @@ namespace viua {
     namespace types {
         class Vector : public Value {
             /** Vector type.
+             *
+             *  Vectors holding only Integers, Floats, Booleans, or Bits of a
+             *  single width are kept in contiguous unboxed arrays.
+             *  Elements are boxed only when they leave the vector (pop), and
+             *  the whole vector falls back to boxed storage when a pointer
+             *  into it is requested (at) or an element of a different type is
+             *  inserted.
              */
-            std::vector<std::unique_ptr<Value>> internal_object;
+            public:
+                enum class Storage {
+                    BOXED,
+                    INTEGER,
+                    FLOAT,
+                    BOOLEAN,
+                    BITS,
+                };
+
+            private:
+                Storage storage;
+
+                std::vector<std::unique_ptr<Value>> internal_object;
+                std::vector<Integer::underlying_type> integer_elements;
+                std::vector<Float::underlying_type> float_elements;
+                /*
+                 *  Booleans are stored one per byte, and Bits are flattened (one
+                 *  byte per bit, bits_width bytes per element).
+                 */
+                std::vector<uint8_t> boolean_elements;
+                Bits::size_type bits_width;
+
+                auto offset_of(long int, const bool) const -> std::size_t;
+                auto storage_for(const Value*) const -> Storage;
+                auto box(std::size_t) const -> std::unique_ptr<Value>;
+                auto unbox(std::size_t, std::unique_ptr<Value>) -> void;
+                auto make_boxed() -> void;
+                auto charge_storage() -> void;
+
+                auto numeric_storage() const -> Storage;
+                template<typename T> auto elements_as(std::vector<T>&) const -> const std::vector<T>&;
+                template<typename Reduction> auto reduce(Reduction) const -> std::unique_ptr<Value>;
+                template<typename Operation>
+                auto elementwise(const Vector&, Operation) const -> std::unique_ptr<Vector>;
 
             public:
                 static const std::string type_name;
@@ -40,15 +84,35 @@ namespace viua {
                 std::string type() const override;
                 std::string str() const override;
                 bool boolean() const override;
+                std::size_t memory_footprint() const override;
                 std::unique_ptr<Value> copy() const override;
+                auto charge_to(MemoryAccount*) -> void override;
 
                 std::vector<std::unique_ptr<Value>>& value();
+                auto storage_kind() const -> Storage;
 
                 void insert(long int, std::unique_ptr<Value>);
                 void push(std::unique_ptr<Value>);
                 std::unique_ptr<Value> pop(long int);
                 Value* at(long int);
                 int len();
+                auto size() const -> std::size_t;
+
+                /*
+                 *  Bulk operations.
+                 *  They work on vectors of Integers and Floats; the result is an
+                 *  Integer (or a vector of Integers) only if all operands hold
+                 *  Integers, and a Float otherwise.
+                 */
+                auto sum() const -> std::unique_ptr<Value>;
+                auto min() const -> std::unique_ptr<Value>;
+                auto max() const -> std::unique_ptr<Value>;
+                auto dot(const Vector&) const -> std::unique_ptr<Value>;
+                auto add(const Vector&) const -> std::unique_ptr<Vector>;
+                auto sub(const Vector&) const -> std::unique_ptr<Vector>;
+                auto mul(const Vector&) const -> std::unique_ptr<Vector>;
+                auto div(const Vector&) const -> std::unique_ptr<Vector>;
+                auto sort() -> void;
 
                 Vector();
                 Vector(const std::vector<Value*>& v);
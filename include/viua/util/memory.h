@@ -22,6 +22,7 @@
 
 #include <cstring>
 #include <memory>
+#include <string>
 
 
 #pragma once
@@ -65,6 +66,7 @@ namespace viua {
                 }
 
                 auto get() -> T* { return pointer; }
+                auto get() const -> const T* { return pointer; }
 
                 auto owns() const -> bool { return owns_pointer; }
 
@@ -74,6 +76,24 @@ namespace viua {
                 ~maybe_unique_ptr() { delete_if_owned(); }
             };
 
+            /*  Approximate number of bytes a string allocated on the heap (zero if
+             *  the characters are stored inside the string object itself).
+             */
+            inline auto heap_size(const std::string& s) -> std::size_t {
+                auto object = reinterpret_cast<const char*>(&s);
+                if (s.data() >= object and s.data() < (object + sizeof(s))) {
+                    return 0;
+                }
+                return (s.capacity() + 1);
+            }
+
+            /*  Approximate size of a node of a node-based container (e.g. std::map)
+             *  holding an element of type T.
+             */
+            template<class T> constexpr auto node_size() -> std::size_t {
+                return (sizeof(T) + 4 * sizeof(void*));
+            }
+
             template<class To, class From> auto load_aligned(const From* source) -> To {
                 To data{};
                 std::memcpy(&data, source, sizeof(To));
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_UTIL_PARALLEL_H
+#define VIUA_UTIL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+namespace viua {
+    namespace util {
+        namespace parallel {
+            /** Call fn(i) for every i in [0, n) using a pool of threads.
+             *
+             *  At most as many threads as there are hardware threads are started,
+             *  and the calling thread returns only after all calls finished.
+             *  If any call throws, the exception thrown by the call with the lowest
+             *  index is rethrown so the errors reported do not depend on the order
+             *  in which threads happened to run.
+             */
+            template<class Fn> auto for_each_index(const std::size_t n, Fn&& fn) -> void {
+                std::vector<std::exception_ptr> errors(n);
+                std::atomic<std::size_t> next{0};
+                auto worker = [n, &fn, &errors, &next] {
+                    for (auto i = next++; i < n; i = next++) {
+                        try {
+                            fn(i);
+                        } catch (...) { errors[i] = std::current_exception(); }
+                    }
+                };
+
+                const auto limit = std::max(std::thread::hardware_concurrency(), 1u);
+                std::vector<std::thread> workers;
+                for (std::size_t i = 1; i < std::min<std::size_t>(n, limit); ++i) {
+                    workers.emplace_back(worker);
+                }
+                worker();
+                for (auto& each : workers) {
+                    each.join();
+                }
+
+                for (auto& each : errors) {
+                    if (each) {
+                        std::rethrow_exception(each);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_UTIL_PERSISTENT_MAP_H
+#define VIUA_UTIL_PERSISTENT_MAP_H
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+
+namespace viua {
+    namespace util {
+        template<class K, class V> class PersistentMap {
+            /** Ordered map whose copies share structure.
+             *
+             *  The map is an AVL tree of immutable nodes.
+             *  Copying a map copies only the pointer to its root, and assigning
+             *  a key copies only the nodes on the path from the root to that key,
+             *  so a copy that is modified and published (see Published) costs
+             *  O(log n) nodes per changed key instead of a copy of the whole map.
+             */
+          public:
+            using value_type = std::pair<const K, V>;
+
+          private:
+            struct Node;
+            using Link = std::shared_ptr<const Node>;
+            struct Node {
+                value_type entry;
+                Link left, right;
+                unsigned height;
+
+                Node(Link l, value_type e, Link r)
+                    : entry(std::move(e)),
+                      left(std::move(l)),
+                      right(std::move(r)),
+                      height(1 + std::max(height_of(left), height_of(right))) {}
+            };
+
+            Link root;
+            std::size_t entries = 0;
+
+            static auto height_of(const Link& node) -> unsigned { return (node ? node->height : 0); }
+            static auto make(Link l, value_type e, Link r) -> Link {
+                return std::make_shared<const Node>(std::move(l), std::move(e), std::move(r));
+            }
+            static auto balance(Link l, value_type e, Link r) -> Link {
+                if (height_of(l) > (height_of(r) + 1)) {
+                    if (height_of(l->left) >= height_of(l->right)) {
+                        return make(l->left, l->entry, make(l->right, std::move(e), std::move(r)));
+                    }
+                    return make(make(l->left, l->entry, l->right->left), l->right->entry,
+                                make(l->right->right, std::move(e), std::move(r)));
+                }
+                if (height_of(r) > (height_of(l) + 1)) {
+                    if (height_of(r->right) >= height_of(r->left)) {
+                        return make(make(std::move(l), std::move(e), r->left), r->entry, r->right);
+                    }
+                    return make(make(std::move(l), std::move(e), r->left->left), r->left->entry,
+                                make(r->left->right, r->entry, r->right));
+                }
+                return make(std::move(l), std::move(e), std::move(r));
+            }
+            static auto assign(const Link& node, const K& key, V value, bool& added) -> Link {
+                if (not node) {
+                    added = true;
+                    return make(nullptr, value_type(key, std::move(value)), nullptr);
+                }
+                if (key < node->entry.first) {
+                    return balance(assign(node->left, key, std::move(value), added), node->entry, node->right);
+                }
+                if (node->entry.first < key) {
+                    return balance(node->left, node->entry, assign(node->right, key, std::move(value), added));
+                }
+                return make(node->left, value_type(key, std::move(value)), node->right);
+            }
+            template<class Fn> static auto walk(const Node* node, Fn& fn) -> void {
+                for (; node; node = node->right.get()) {
+                    walk(node->left.get(), fn);
+                    fn(node->entry);
+                }
+            }
+
+          public:
+            auto find(const K& key) const -> const V* {
+                for (auto node = root.get(); node;) {
+                    if (key < node->entry.first) {
+                        node = node->left.get();
+                    } else if (node->entry.first < key) {
+                        node = node->right.get();
+                    } else {
+                        return &node->entry.second;
+                    }
+                }
+                return nullptr;
+            }
+            auto count(const K& key) const -> std::size_t { return (find(key) ? 1 : 0); }
+            auto at(const K& key) const -> const V& {
+                if (auto found = find(key)) {
+                    return *found;
+                }
+                throw std::out_of_range("PersistentMap::at");
+            }
+            auto size() const -> std::size_t { return entries; }
+
+            auto insert_or_assign(const K& key, V value) -> void {
+                bool added = false;
+                root = assign(root, key, std::move(value), added);
+                entries += (added ? 1 : 0);
+            }
+
+            /** Call fn(entry) for every entry in the order of keys.
+             */
+            template<class Fn> auto for_each(Fn&& fn) const -> void { walk(root.get(), fn); }
+        };
+    }
+}
+
+
+#endif
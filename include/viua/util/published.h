@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIUA_UTIL_PUBLISHED_H
+#define VIUA_UTIL_PUBLISHED_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace viua {
+    namespace util {
+        template<class T> class Published {
+            /** Value that is read often (and from many threads) but rarely written.
+             *
+             *  Readers get an immutable snapshot with a single atomic load of
+             *  a pointer; they never lock and never touch a reference count.
+             *  Writers copy the current snapshot, modify the copy, and publish it
+             *  atomically; writers are serialised.
+             *
+             *  Snapshots replaced by newer ones are not freed until the Published
+             *  object itself is destroyed, because there is no way to tell when the
+             *  last reader let go of them.
+             *  This is why T should be cheap to copy: big tables should share
+             *  their unchanged parts between snapshots (see PersistentMap).
+             */
+            std::atomic<const T*> current;
+            std::vector<std::unique_ptr<const T>> snapshots;
+            std::mutex writer;
+
+            static_assert(std::atomic<const T*>::is_always_lock_free);
+
+          public:
+            auto load() const -> const T* { return current.load(std::memory_order_acquire); }
+
+            template<class Fn> auto update(Fn&& fn) -> void {
+                std::unique_lock<std::mutex> lck{writer};
+                auto next = std::make_unique<T>(*load());
+                fn(*next);
+                current.store(next.get(), std::memory_order_release);
+                snapshots.emplace_back(std::move(next));
+            }
+
+            Published() : current(nullptr) {
+                snapshots.emplace_back(std::make_unique<const T>());
+                current.store(snapshots.back().get(), std::memory_order_release);
+            }
+            Published(const Published&) = delete;
+            auto operator=(const Published&) -> Published& = delete;
+        };
+    }
+}
+
+
+#endif
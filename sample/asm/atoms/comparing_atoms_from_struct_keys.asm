@@ -0,0 +1,39 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    struct (.name: %iota container) local
+
+    atom (.name: %iota key) local 'answer'
+    integer (.name: %iota value) local 42
+    structinsert %container local %key local %value local
+
+    structkeys (.name: %iota keys) local %container local
+
+    atom (.name: %iota an_atom) local 'answer'
+    atom (.name: %iota another_atom) local 'question'
+    izero (.name: %iota index) local
+    vat (.name: %iota key_from_struct) local %keys local %index local
+
+    print (atomeq %iota local *key_from_struct local %an_atom local) local
+    print (atomeq %iota local *key_from_struct local %another_atom local) local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,47 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+
+.function: waiter/0
+    print (receive %iota local infinity) local
+    return
+.end
+
+.function: main/0
+    .name: %iota waiter
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    frame %0
+    process %waiter local waiter/0
+
+    ; keep the only scheduler busy so that the waiter is put on it many times
+    ; before its message arrives
+    integer %counter local 0
+    integer %limit local 1000
+    .mark: loop
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    send %waiter local %counter local
+    join void %waiter local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,44 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    dict (.name: %iota container) local
+
+    integer (.name: %iota i) local 0
+    integer (.name: %iota limit) local 1000
+
+    .mark: loop
+    if (gte (.name: %iota done) local %i local %limit local) local after_loop
+    dictinsert %container local %i local (copy (.name: %iota value) local %i local) local
+    iinc %i local
+    jump loop
+    .mark: after_loop
+
+    print (dictsize (.name: %iota size) local %container local) local
+
+    dictremove void %container local (integer %i local 0) local
+    print (dictsize %size local %container local) local
+
+    dictat (.name: %iota value_at) local %container local (integer %i local 999) local
+    print *value_at local
+    print (dicthas (.name: %iota found) local %container local (integer %i local 0) local) local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,34 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    dict (.name: %iota container) local
+
+    dictinsert %container local (integer (.name: %iota key) local 1) local (integer %iota local 42) local
+    dictinsert %container local (atom %key local 'answer') local (integer %iota local 42) local
+    dictinsert %container local (text %key local "answer") local (integer %iota local 666) local
+    dictinsert %container local (bits %key local 0b0101) local (integer %iota local 5) local
+    print %container local
+
+    dictsize (.name: %iota size) local %container local
+    print %size local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,37 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    dict (.name: %iota container) local
+
+    integer (.name: %iota key) local 1
+    dictinsert %container local %key local (integer %iota local 42) local
+    dictinsert %container local (integer %iota local 2) local (integer %iota local 666) local
+    print %container local
+
+    dictremove (.name: %iota removed) local %container local %key local
+    print %removed local
+    print %container local
+
+    dictremove void %container local (integer %key local 2) local
+    print %container local
+
+    izero %0 local
+    return
+.end
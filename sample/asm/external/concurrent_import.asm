@@ -0,0 +1,49 @@
+;
+;   Copyright (C) 2016, 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.signature: printer::print/1
+
+
+.function: importing_printer/1
+    -- every process imports the module by itself, and
+    -- the module must be linked exactly once
+    import "build/test/printer"
+
+    frame ^[(pamv %0 (arg %1 %0))]
+    call printer::print/1
+
+    return
+.end
+
+.function: main/0
+    frame ^[(pamv %0 (string %1 "Joe"))]
+    process void importing_printer/1
+
+    frame ^[(pamv %0 (string %1 "Robert"))]
+    process void importing_printer/1
+
+    frame ^[(pamv %0 (string %1 "Mike"))]
+    process void importing_printer/1
+
+    frame ^[(pamv %0 (string %1 "Bjarne"))]
+    process void importing_printer/1
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,52 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+
+.signature: std::scheduler::statistics/0
+
+.function: report/0
+    frame %0
+    call %1 std::scheduler::statistics/0
+    print (vlen %2 %1)
+    return
+.end
+
+.function: countdown/1
+    .name: 1 counter
+    arg %counter %0
+
+    ; the last call in the chain is replaced by a call to "report"
+    if (eq %2 %counter (integer %3 0)) finish
+
+    frame ^[(param %0 (idec %counter))]
+    call countdown/1
+    return
+
+    .mark: finish
+    frame %0
+    tailcall report/0
+.end
+
+.function: main/0
+    frame ^[(param %0 (integer %1 3))]
+    call countdown/1
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,39 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+.function: watchdog_process/1
+    arg %1 %0
+    print (remove %2 %1 (string %2 "exception"))
+    return
+.end
+
+.function: fail/0
+    throw (string %1 "OH NOES!")
+    return
+.end
+
+.function: main/0
+    watchdog watchdog_process/1
+
+    ; frames dropped when the process dies must still be profiled
+    frame %0
+    call fail/0
+
+    izero %0 local
+    return
+.end
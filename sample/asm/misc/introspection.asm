@@ -0,0 +1,39 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+
+; A program that does nothing but wait, so that it can be looked at through
+; the introspection socket.
+
+.function: waiter/0
+    receive void infinity
+    return
+.end
+
+.function: main/0
+    import "std::vector"
+
+    frame %0
+    process void waiter/0
+
+    receive void infinity
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,55 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: waiter/1
+    send (arg %iota %0) (self %iota)
+    print (receive %iota 10s)
+    return
+.end
+
+.function: spin/1
+    .name: %iota counter
+    .name: %iota limit
+    integer %counter 0
+    arg %limit %0
+
+    .mark: loop
+    if (not (lt %iota %counter %limit)) done
+    iinc %counter
+    jump loop
+
+    .mark: done
+    return
+.end
+
+.function: main/0
+    .name: %iota pid
+    frame ^[(pamv %0 (self %pid))]
+    process void waiter/1
+    receive %pid 10s
+
+    ; keep the main process busy while the other one waits for a message
+    frame ^[(pamv %0 (integer %iota 100000))]
+    call void spin/1
+
+    send %pid (string %iota "Hello sampled World!")
+
+    izero %0 local
+    return
+.end
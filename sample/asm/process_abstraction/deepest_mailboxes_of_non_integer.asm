@@ -0,0 +1,37 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.signature: std::process::deepest_mailboxes/1
+
+.function: main/0
+    try
+    catch "Exception" .block: handle_type_mismatch
+        print (draw %iota)
+        leave
+    .end
+    enter .block: list_mailboxes
+        frame %1
+        param %0 (string %iota "ten")
+        call void std::process::deepest_mailboxes/1
+        leave
+    .end
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,54 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.signature: std::process::hibernate/0
+
+.function: sleeper/1
+    .name: %iota parent
+    .name: %iota greeting
+    arg %parent %0
+    string %greeting "Hello"
+
+    ; hibernate as soon as the process blocks waiting for a message
+    frame %0
+    call void std::process::hibernate/0
+
+    ; tell the parent the process is ready and wait
+    send %parent (self %iota)
+
+    .name: %iota message
+    receive %message 10s
+
+    ; registers must survive hibernation
+    print %greeting
+    print %message
+    return
+.end
+
+.function: main/0
+    .name: %iota pid
+    frame ^[(pamv %0 (self %pid))]
+    process void sleeper/1
+
+    receive %pid 10s
+    send %pid (string %iota "hibernated World!")
+
+    izero %0 local
+    return
+.end
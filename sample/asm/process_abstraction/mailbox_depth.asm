@@ -0,0 +1,79 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+
+.signature: std::process::deepest_mailboxes/1
+.signature: std::process::message_latency/0
+
+.function: print_deepest_mailbox/0
+    .name: %iota mailboxes
+    frame %1
+    param %0 (integer %iota 1)
+    call %mailboxes std::process::deepest_mailboxes/1
+
+    .name: %iota deepest
+    vpop %deepest %mailboxes (izero %iota)
+    .name: %iota depth
+    .name: %iota high_water_mark
+    structremove %depth %deepest (atom %iota 'depth')
+    structremove %high_water_mark %deepest (atom %iota 'high_water_mark')
+    print %depth
+    print %high_water_mark
+
+    return
+.end
+
+.function: main/0
+    .name: %iota me
+    .name: %iota counter
+    .name: %iota limit
+    self %me
+    integer %counter 0
+    integer %limit 10
+
+    .mark: send_loop
+    if (not (lt %iota %counter %limit)) sent
+    send %me (string %iota "a message")
+    iinc %counter
+    jump send_loop
+
+    .mark: sent
+    frame %0
+    call void print_deepest_mailbox/0
+
+    .mark: receive_loop
+    if (not (lt %iota (izero %iota) %counter)) received
+    receive void 100ms
+    idec %counter
+    jump receive_loop
+
+    .mark: received
+    frame %0
+    call void print_deepest_mailbox/0
+
+    .name: %iota latency
+    .name: %iota count
+    frame %0
+    call %latency std::process::message_latency/0
+    structremove %count %latency (atom %iota 'count')
+    print %count
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,45 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: hog/0
+    .name: %iota strings
+    vector %strings
+
+    .mark: loop
+    vpush %strings (string %iota "a string long enough to be allocated on the heap")
+    jump loop
+
+    return
+.end
+
+.function: main/0
+    try
+    catch "Exception" .block: handle_limit
+        print (string %iota "memory limit exceeded")
+        leave
+    .end
+    enter .block: hog_memory
+        frame %0
+        call void hog/0
+        leave
+    .end
+
+    izero %0 local
+    return
+.end
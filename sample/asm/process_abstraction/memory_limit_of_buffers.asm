@@ -0,0 +1,49 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; integers pushed to the vector are stored unboxed so the only memory the hog
+; keeps allocating is the storage of the vector
+.function: hog/0
+    .name: %iota numbers
+    .name: %iota number
+    vector %numbers local
+    integer %number local 42
+
+    .mark: loop
+    vpush %numbers local (copy %iota local %number local) local
+    jump loop
+
+    return
+.end
+
+.function: main/0
+    try
+    catch "Exception" .block: handle_limit
+        print (string %iota "memory limit exceeded")
+        leave
+    .end
+    enter .block: hog_memory
+        frame %0
+        call void hog/0
+        leave
+    .end
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,71 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: hoard/1
+    .name: %iota sender
+    .name: %iota messages
+    .name: %iota message
+    arg %sender local %0
+    vector %messages local
+
+    .mark: loop
+    vpush %messages local (receive %message local infinity) local
+    send %sender local (integer %message local 0) local
+    jump loop
+
+    return
+.end
+
+.function: hoarder/1
+    arg %1 local %0
+
+    try
+    catch "Exception" .block: handle_limit
+        print (string %2 local "memory limit exceeded") local
+        send %1 local (integer %2 local -1) local
+        leave
+    .end
+    enter .block: hoard_messages
+        frame ^[(param %0 %1 local)]
+        call void hoard/1
+        leave
+    .end
+
+    return
+.end
+
+.function: main/0
+    .name: %iota hoarder
+    .name: %iota message
+    .name: %iota condition
+    frame ^[(param %0 (self %hoarder local) local)]
+    process %hoarder local hoarder/1
+
+    ; messages kept by the receiver are charged to it, not to the sender
+    .mark: loop
+    send %hoarder local (string %message local "a string long enough to be allocated on the heap") local
+    receive %message local infinity
+    if (lt %condition local %message local (integer %condition local 0) local) local done loop
+
+    .mark: done
+    join void %hoarder local
+
+    izero %0 local
+    return
+.end
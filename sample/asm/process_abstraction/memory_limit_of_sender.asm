@@ -0,0 +1,64 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: echo/2
+    .name: %iota sender
+    .name: %iota limit
+    .name: %iota counter
+    .name: %iota message
+    .name: %iota condition
+    arg %sender local %0
+    arg %limit local %1
+    integer %counter local 0
+
+    .mark: loop
+    receive %message local infinity
+    send %sender local %message local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota receiver
+    .name: %iota message
+    integer %counter local 0
+    integer %limit local 5000
+
+    frame ^[(param %0 (self %receiver local) local) (param %1 %limit local)]
+    process %receiver local echo/2
+
+    ; every message is freed by the process that received it, so none of them
+    ; may be left charged to the process that sent it
+    .mark: loop
+    send %receiver local (string %message local "a string long enough to be allocated on the heap") local
+    receive %message local infinity
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    join void %receiver local
+    print %counter local
+
+    izero %0 local
+    return
+.end
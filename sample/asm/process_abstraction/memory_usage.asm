@@ -0,0 +1,49 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.signature: std::process::memory_usage/0
+
+.function: main/0
+    .name: %iota before
+    frame %0
+    call %before std::process::memory_usage/0
+
+    .name: %iota strings
+    .name: %iota counter
+    .name: %iota limit
+    vector %strings
+    integer %counter 0
+    integer %limit 1000
+
+    .mark: loop
+    if (not (lt %iota %counter %limit)) done
+    vpush %strings (string %iota "a string long enough to be allocated on the heap")
+    iinc %counter
+    jump loop
+
+    .mark: done
+    .name: %iota after
+    frame %0
+    call %after std::process::memory_usage/0
+
+    print (lt %iota %before %after)
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,32 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    string (.name: %iota format) "#{0} + #{0} = #{1} (#{ #{01} #{x)"
+
+    vector (.name: %iota format_params)
+    vpush %format_params (string %iota "2")
+    vpush %format_params (string %iota "4")
+
+    frame ^[(param %iota %format) (param %iota %format_params)]
+    print (msg (.name: %iota result) format/)
+
+    izero %0 local
+    return
+.end
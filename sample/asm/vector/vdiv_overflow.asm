@@ -0,0 +1,39 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    ; the smallest integer, -2^63, is built as (-2^31 * -2^31) * -2
+    integer (.name: %iota half) local -2147483648
+    mul %half local %half local %half local
+    mul (.name: %iota smallest) local %half local (integer %iota local -2) local
+
+    vector (.name: %iota lhs) local
+    vpush %lhs local (integer %iota local 6) local
+    vpush %lhs local %smallest local
+
+    vector (.name: %iota rhs) local
+    vpush %rhs local (integer %iota local 2) local
+    vpush %rhs local (integer %iota local -1) local
+
+    vdiv (.name: %iota result) local %lhs local %rhs local
+    print %result local
+
+    izero %0 local
+    return
+.end
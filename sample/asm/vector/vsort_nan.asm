@@ -0,0 +1,52 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: fill/1
+    arg (.name: %iota v) local %0
+
+    string (.name: %iota nan) local "nan"
+    stof %nan local %nan local
+
+    vpush %v local (float %iota local 2.0) local
+    vpush %v local (copy %iota local %nan local) local
+    vpush %v local (float %iota local 1.0) local
+    vpush %v local (copy %iota local %nan local) local
+    vpush %v local (float %iota local 0.5) local
+
+    move %0 local %v local
+    return
+.end
+
+.function: main/0
+    frame ^[(param %0 (vector %iota local) local)]
+    call (.name: %iota unboxed) local fill/1
+    vsort %unboxed local
+    print %unboxed local
+
+    ; taking a pointer to an element makes the vector keep its elements boxed
+    frame ^[(param %0 (vector %iota local) local)]
+    call (.name: %iota boxed) local fill/1
+    vat (.name: %iota first) local %boxed local (integer %iota local 0) local
+    delete %first local
+    vsort %boxed local
+    print %boxed local
+
+    izero %0 local
+    return
+.end
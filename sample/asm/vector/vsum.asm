@@ -0,0 +1,34 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+.function: main/0
+    vector (.name: %iota v) local
+
+    vpush %v local (integer %iota local 3) local
+    vpush %v local (integer %iota local 1) local
+    vpush %v local (integer %iota local 4) local
+    vpush %v local (integer %iota local 2) local
+
+    print (vsum (.name: %iota result) local %v local) local
+    print (vmin %result local %v local) local
+    print (vmax %result local %v local) local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,102 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Every process sends a message to every process (itself included).
+; Prints the number of messages exchanged.
+
+.function: peer/1
+    .name: %iota parent
+    .name: %iota peers
+    .name: %iota expected
+    .name: %iota message
+    .name: %iota peer
+    .name: %iota condition
+    arg %parent local %0
+
+    ; the list of peers always arrives first, and the signal to start sending
+    ; (a zero) only after every peer has got its list
+    receive %peers local infinity
+    vlen %expected local %peers local
+    iinc %expected local
+
+    .mark: receive_messages
+    receive %message local infinity
+    if %message local counted
+
+    .mark: send_to_peers
+    vpop %peer local %peers local
+    send %peer local (integer %iota local 1) local
+    if (vlen %condition local %peers local) local send_to_peers
+
+    .mark: counted
+    idec %expected local
+    if (gt %condition local %expected local (integer %iota local 0) local) local receive_messages
+
+    send %parent local (integer %iota local 1) local
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota peer_count
+    .name: %iota condition
+    .name: %iota peers
+    .name: %iota pid
+    integer %counter local 0
+    integer %peer_count local 100
+    vector %peers local
+
+    .mark: spawn_peers
+    frame ^[(param %0 (self %pid local) local)]
+    process %pid local peer/1
+    vpush %peers local %pid local
+    iinc %counter local
+    if (lt %condition local %counter local %peer_count local) local spawn_peers
+
+    ; every peer gets its own list of all peers
+    .name: %iota unintroduced
+    copy %unintroduced local %peers local
+    .mark: introduce_peers
+    vpop %pid local %unintroduced local
+    send %pid local (copy %iota local %peers local) local
+    if (vlen %condition local %unintroduced local) local introduce_peers
+
+    copy %unintroduced local %peers local
+    .mark: start_peers
+    vpop %pid local %unintroduced local
+    send %pid local (integer %iota local 0) local
+    if (vlen %condition local %unintroduced local) local start_peers
+    delete %unintroduced local
+
+    integer %counter local 0
+    .mark: wait_for_peers
+    delete (receive %iota local infinity) local
+    iinc %counter local
+    if (lt %condition local %counter local %peer_count local) local wait_for_peers
+
+    .mark: join_peers
+    vpop %pid local %peers local
+    join void %pid local
+    if (vlen %condition local %peers local) local join_peers
+
+    print (mul %iota local %peer_count local %peer_count local) local
+
+    izero %0 local
+    return
+.end
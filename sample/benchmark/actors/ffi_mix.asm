@@ -0,0 +1,83 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Workers that interleave bytecode with calls to foreign functions so that
+; both kinds of schedulers are kept busy.
+; Prints the number of iterations done by all workers.
+
+.signature: std::process::memory_usage/0
+
+.function: worker/2
+    .name: %iota parent
+    .name: %iota iterations
+    .name: %iota counter
+    .name: %iota total
+    .name: %iota condition
+    arg %parent local %0
+    arg %iterations local %1
+
+    integer %counter local 0
+    integer %total local 0
+    .mark: loop
+    frame %0
+    add %total local %total local (call %iota local std::process::memory_usage/0) local
+    frame ^[(param %0 %counter local)]
+    add %total local %total local (call %iota local square/1) local
+    iinc %counter local
+    if (lt %condition local %counter local %iterations local) local loop
+
+    delete %total local
+    send %parent local %counter local
+    return
+.end
+
+.function: square/1
+    arg %1 local %0
+    mul %0 local %1 local %1 local
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota workers
+    .name: %iota iterations
+    .name: %iota condition
+    .name: %iota total
+    integer %counter local 0
+    integer %workers local 8
+    integer %iterations local 500
+
+    .mark: spawn_workers
+    frame ^[(param %0 (self %iota local) local) (param %1 %iterations local)]
+    process void worker/2
+    iinc %counter local
+    if (lt %condition local %counter local %workers local) local spawn_workers
+
+    integer %counter local 0
+    integer %total local 0
+    .mark: collect_results
+    add %total local %total local (receive %iota local infinity) local
+    iinc %counter local
+    if (lt %condition local %counter local %workers local) local collect_results
+
+    print %total local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,57 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; A fork-join tree shaped like the call tree of naive Fibonacci: every node
+; for n >= 2 spawns nodes for n - 1 and n - 2 and joins them.
+; Prints the number of processes in the tree.
+
+.function: node/1
+    .name: %iota n
+    .name: %iota condition
+    .name: %iota left
+    .name: %iota right
+    .name: %iota left_size
+    .name: %iota right_size
+    arg %n local %0
+
+    if (lt %condition local %n local (integer %iota local 2) local) local leaf
+
+    frame ^[(param %0 (idec %n local) local)]
+    process %left local node/1
+    frame ^[(param %0 (idec %n local) local)]
+    process %right local node/1
+
+    join %left_size local %left local
+    join %right_size local %right local
+    add %0 local %left_size local %right_size local
+    iinc %0 local
+    return
+
+    .mark: leaf
+    integer %0 local 1
+    return
+.end
+
+.function: main/0
+    frame ^[(param %0 (integer %1 local 14) local)]
+    print (call %1 local node/1) local
+
+    izero %0 local
+    return
+.end
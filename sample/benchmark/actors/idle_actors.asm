@@ -0,0 +1,72 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Many processes that spend their whole life blocked in receive.
+; This workload is about the memory footprint of a process rather than
+; about speed.
+; Prints the number of processes that were spawned.
+
+.function: idle/1
+    .name: %iota parent
+    arg %parent local %0
+    send %parent local (receive %iota local infinity) local
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota actors
+    .name: %iota condition
+    .name: %iota idle
+    .name: %iota woken
+    .name: %iota pid
+    integer %counter local 0
+    integer %actors local 2000
+    vector %idle local
+
+    .mark: spawn_actors
+    frame ^[(param %0 (self %pid local) local)]
+    process %pid local idle/1
+    vpush %idle local %pid local
+    iinc %counter local
+    if (lt %condition local %counter local %actors local) local spawn_actors
+
+    copy %woken local %idle local
+    .mark: wake_actors
+    vpop %pid local %woken local
+    send %pid local (integer %iota local 1) local
+    if (vlen %condition local %woken local) local wake_actors
+    delete %woken local
+
+    integer %counter local 0
+    .mark: collect_replies
+    delete (receive %iota local infinity) local
+    iinc %counter local
+    if (lt %condition local %counter local %actors local) local collect_replies
+
+    .mark: join_actors
+    vpop %pid local %idle local
+    join void %pid local
+    if (vlen %condition local %idle local) local join_actors
+
+    print %actors local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,80 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; A chain of stages, each of which transforms an item and passes it on.
+; All items are pushed into the pipeline before the first result is
+; collected so that the stages work concurrently.
+; Prints the number of items that went through the pipeline.
+
+.function: stage/1
+    .name: %iota next
+    .name: %iota item
+    .name: %iota condition
+    arg %next local %0
+
+    ; a negative item is the signal to finish
+    .mark: loop
+    receive %item local infinity
+    if (lt %condition local %item local (integer %iota local 0) local) local finish
+    send %next local (iinc %item local) local
+    jump loop
+
+    .mark: finish
+    send %next local %item local
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota stages
+    .name: %iota items
+    .name: %iota condition
+    .name: %iota next
+    integer %counter local 0
+    integer %stages local 16
+    integer %items local 2000
+
+    ; the last stage sends its results back to the main process
+    self %next local
+    .mark: spawn_stages
+    frame ^[(pamv %0 %next local)]
+    process %next local stage/1
+    iinc %counter local
+    if (lt %condition local %counter local %stages local) local spawn_stages
+
+    integer %counter local 0
+    .mark: push_items
+    send %next local (copy %iota local %counter local) local
+    iinc %counter local
+    if (lt %condition local %counter local %items local) local push_items
+
+    integer %counter local 0
+    .mark: collect_results
+    delete (receive %iota local infinity) local
+    iinc %counter local
+    if (lt %condition local %counter local %items local) local collect_results
+
+    send %next local (integer %iota local -1) local
+    receive void infinity
+
+    print %items local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,50 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Integer and floating point arithmetic.
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota integer_accumulator
+    .name: %iota float_accumulator
+    .name: %iota operand
+    integer %counter local 0
+    integer %limit local 20000
+    integer %integer_accumulator local 1
+    float %float_accumulator local 1.0
+
+    .mark: loop
+    add %integer_accumulator local %integer_accumulator local (integer %operand local 3) local
+    mul %integer_accumulator local %integer_accumulator local (integer %operand local 2) local
+    sub %integer_accumulator local %integer_accumulator local (integer %operand local 1) local
+    div %integer_accumulator local %integer_accumulator local (integer %operand local 2) local
+    add %float_accumulator local %float_accumulator local (float %operand local 0.5) local
+    mul %float_accumulator local %float_accumulator local (float %operand local 1.5) local
+    div %float_accumulator local %float_accumulator local (float %operand local 1.5) local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    print %integer_accumulator local
+    print %float_accumulator local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,50 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Bit string operations.
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota first
+    .name: %iota second
+    .name: %iota result
+    .name: %iota index
+    .name: %iota bit
+    integer %counter local 0
+    integer %limit local 5000
+    bits %first local 0b1111010110111001
+    bits %second local 0b1011100111110101
+
+    .mark: loop
+    bitand %result local %first local %second local
+    bitor %result local %result local %second local
+    bitxor %result local %result local %first local
+    bitnot %result local %result local
+    shl void %result local (integer %index local 3) local
+    delete (bitat %bit local %result local %index local) local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    print %result local
+
+    izero %0 local
+    return
+.end
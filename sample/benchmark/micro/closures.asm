@@ -0,0 +1,48 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Closure creation and calls.
+
+.function: adder/1
+    add %0 local (arg %2 local %0) local %1 local
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota add_counter
+    .name: %iota result
+    integer %counter local 0
+    integer %limit local 10000
+
+    .mark: loop
+    closure %add_counter local adder/1
+    capturecopy %add_counter local %1 %counter local
+    frame ^[(param %0 %counter local)]
+    call %result local %add_counter local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    print %result local
+
+    izero %0 local
+    return
+.end
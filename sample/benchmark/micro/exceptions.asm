@@ -0,0 +1,51 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Throwing and catching exceptions.
+
+.function: thrower/1
+    throw (arg %1 local %0) local
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota caught
+    integer %counter local 0
+    integer %limit local 5000
+
+    .mark: loop
+    try
+    catch "Integer" .block: handle_integer
+        delete (draw %caught local) local
+        leave
+    .end
+    enter .block: throwing_block
+        frame ^[(param %0 %counter local)]
+        call void thrower/1
+        leave
+    .end
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    izero %0 local
+    return
+.end
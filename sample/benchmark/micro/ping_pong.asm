@@ -0,0 +1,62 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Message passing between two processes.
+
+.function: ponger/1
+    .name: %iota pinger
+    .name: %iota message
+    .name: %iota condition
+    arg %pinger local %0
+
+    ; a negative number is the signal to finish
+    .mark: loop
+    receive %message local infinity
+    if (lt %condition local %message local (integer %iota local 0) local) local finish
+    send %pinger local %message local
+    jump loop
+
+    .mark: finish
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota ponger
+    .name: %iota message
+    integer %counter local 0
+    integer %limit local 20000
+
+    frame ^[(param %0 (self %ponger local) local)]
+    process %ponger local ponger/1
+
+    .mark: loop
+    send %ponger local (copy %message local %counter local) local
+    receive %counter local infinity
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    send %ponger local (integer %message local -1) local
+    join void %ponger local
+
+    izero %0 local
+    return
+.end
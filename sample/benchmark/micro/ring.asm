@@ -0,0 +1,73 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; A ring of processes passing a token around.
+; Every process forwards the token to the next one until it completes the
+; requested number of laps.
+
+.function: ring_member/1
+    .name: %iota next
+    .name: %iota token
+    .name: %iota condition
+    arg %next local %0
+
+    ; a negative token is the signal to finish
+    .mark: loop
+    receive %token local infinity
+    send %next local (copy %iota local %token local) local
+    if (lt %condition local %token local (integer %iota local 0) local) local finish
+    jump loop
+
+    .mark: finish
+    return
+.end
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota ring_size
+    .name: %iota laps
+    .name: %iota condition
+    .name: %iota next
+    .name: %iota token
+    integer %counter local 0
+    integer %ring_size local 100
+    integer %laps local 20
+
+    ; the first process is linked to the main one; the last one spawned is
+    ; the head of the ring
+    self %next local
+    .mark: spawn_ring
+    frame ^[(pamv %0 %next local)]
+    process %next local ring_member/1
+    iinc %counter local
+    if (lt %condition local %counter local %ring_size local) local spawn_ring
+
+    integer %counter local 0
+    .mark: lap
+    send %next local (copy %token local %counter local) local
+    receive %counter local infinity
+    iinc %counter local
+    if (lt %condition local %counter local %laps local) local lap
+
+    send %next local (integer %token local -1) local
+    receive void infinity
+
+    izero %0 local
+    return
+.end
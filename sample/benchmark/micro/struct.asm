@@ -0,0 +1,45 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Struct operations.
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota container
+    .name: %iota key
+    .name: %iota keys
+    integer %counter local 0
+    integer %limit local 5000
+    struct %container local
+
+    .mark: loop
+    structinsert %container local (atom %key local 'answer') local (copy %iota local %counter local) local
+    structinsert %container local (atom %key local 'question') local (copy %iota local %counter local) local
+    delete (structkeys %keys local %container local) local
+    structremove void %container local (atom %key local 'answer') local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    print %container local
+
+    izero %0 local
+    return
+.end
@@ -0,0 +1,42 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Tail calls: a counting loop implemented as a chain of tail calls.
+
+.function: countdown/1
+    .name: %iota counter
+    arg %counter local %0
+
+    if (eq %iota local %counter local (integer %iota local 0) local) local finish
+
+    frame ^[(pamv %0 (idec %counter local) local)]
+    tailcall countdown/1
+
+    .mark: finish
+    izero %0 local
+    return
+.end
+
+.function: main/0
+    frame ^[(param %0 (integer %1 local 20000) local)]
+    print (call %1 local countdown/1) local
+
+    izero %0 local
+    return
+.end
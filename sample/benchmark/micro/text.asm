@@ -0,0 +1,50 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Text operations.
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota hello
+    .name: %iota world
+    .name: %iota hello_world
+    .name: %iota index
+    .name: %iota result
+    integer %counter local 0
+    integer %limit local 5000
+    text %hello local "Hello "
+    text %world local "World!"
+
+    .mark: loop
+    textconcat %hello_world local %hello local %world local
+    delete (textat %result local %hello_world local (integer %index local 6) local) local
+    textsub %result local %hello_world local (integer %iota local 0) local %index local
+    delete (texteq %iota local %result local %hello local) local
+    delete %result local
+    textlength %result local %hello_world local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    print %result local
+
+    izero %0 local
+    return
+.end
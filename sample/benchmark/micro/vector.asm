@@ -0,0 +1,45 @@
+;
+;   Copyright (C) 2017 Marek Marecki
+;
+;   This file is part of Viua VM.
+;
+;   Viua VM is free software: you can redistribute it and/or modify
+;   it under the terms of the GNU General Public License as published by
+;   the Free Software Foundation, either version 3 of the License, or
+;   (at your option) any later version.
+;
+;   Viua VM is distributed in the hope that it will be useful,
+;   but WITHOUT ANY WARRANTY; without even the implied warranty of
+;   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;   GNU General Public License for more details.
+;
+;   You should have received a copy of the GNU General Public License
+;   along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+;
+
+; Vector operations.
+
+.function: main/0
+    .name: %iota counter
+    .name: %iota limit
+    .name: %iota condition
+    .name: %iota values
+    .name: %iota index
+    .name: %iota element
+    integer %counter local 0
+    integer %limit local 5000
+    vector %values local
+
+    .mark: loop
+    vpush %values local (copy %element local %counter local) local
+    delete (vat %element local %values local (integer %index local -1) local) local
+    iinc %counter local
+    if (lt %condition local %counter local %limit local) local loop
+
+    .mark: drain
+    vpop void %values local void
+    if (vlen %index local %values local) local drain
+
+    izero %0 local
+    return
+.end
@@ -416,6 +416,10 @@ auto value_type_names = map<ValueTypes, string>{
         ValueTypes::OBJECT,
         "object"s,
     },
+    {
+        ValueTypes::DICT,
+        "dict"s,
+    },
 };
 static auto to_string(ValueTypes value_type_id) -> string {
     auto has_pointer = not not(value_type_id & ValueTypes::POINTER);
@@ -1350,6 +1354,75 @@ static auto check_register_usage_for_instruction_block_impl(RegisterUsageProfile
                 auto val = Register(*result);
                 val.value_type = ValueTypes::INTEGER;
                 register_usage_profile.define(val, result->tokens.at(0));
+            } else if (opcode == VSUM or opcode == VMIN or opcode == VMAX) {
+                auto result = get_operand<RegisterIndex>(*instruction, 0);
+                if (not result) {
+                    throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_if_name_resolved(register_usage_profile, *result);
+
+                auto source = get_operand<RegisterIndex>(*instruction, 1);
+                if (not source) {
+                    throw invalid_syntax(instruction->operands.at(1)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *source);
+                assert_type_of_register<viua::internals::ValueTypes::VECTOR>(register_usage_profile, *source);
+
+                /*
+                 * Whether the result is an integer or a float depends on the elements of the vector so
+                 * it is left for the inferencer.
+                 */
+                register_usage_profile.define(Register{*result}, result->tokens.at(0));
+            } else if (opcode == VDOT or opcode == VADD or opcode == VSUB or opcode == VMUL or
+                       opcode == VDIV) {
+                auto result = get_operand<RegisterIndex>(*instruction, 0);
+                if (not result) {
+                    throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_if_name_resolved(register_usage_profile, *result);
+
+                auto lhs = get_operand<RegisterIndex>(*instruction, 1);
+                if (not lhs) {
+                    throw invalid_syntax(instruction->operands.at(1)->tokens,
+                                         "invalid left-hand side operand")
+                        .note("expected register index");
+                }
+
+                auto rhs = get_operand<RegisterIndex>(*instruction, 2);
+                if (not rhs) {
+                    throw invalid_syntax(instruction->operands.at(2)->tokens,
+                                         "invalid right-hand side operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *lhs);
+                check_use_of_register(register_usage_profile, *rhs);
+
+                assert_type_of_register<viua::internals::ValueTypes::VECTOR>(register_usage_profile, *lhs);
+                assert_type_of_register<viua::internals::ValueTypes::VECTOR>(register_usage_profile, *rhs);
+
+                auto val = Register(*result);
+                if (opcode != VDOT) {
+                    val.value_type = ValueTypes::VECTOR;
+                }
+                register_usage_profile.define(val, result->tokens.at(0));
+            } else if (opcode == VSORT) {
+                auto operand = get_operand<RegisterIndex>(*instruction, 0);
+                if (not operand) {
+                    throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_if_name_resolved(register_usage_profile, *operand);
+
+                check_use_of_register(register_usage_profile, *operand);
+                assert_type_of_register<viua::internals::ValueTypes::VECTOR>(register_usage_profile, *operand);
             } else if (opcode == NOT) {
                 auto target = get_operand<RegisterIndex>(*instruction, 0);
                 if (not target) {
@@ -2497,7 +2570,7 @@ static auto check_register_usage_for_instruction_block_impl(RegisterUsageProfile
                 }
 
                 if (target) {
-                    check_use_of_register(register_usage_profile, *target);
+                    check_if_name_resolved(register_usage_profile, *target);
                 }
 
                 auto source = get_operand<RegisterIndex>(*instruction, 1);
@@ -2542,6 +2615,105 @@ static auto check_register_usage_for_instruction_block_impl(RegisterUsageProfile
                 auto val = Register{*target};
                 val.value_type = ValueTypes::VECTOR;
                 register_usage_profile.define(val, target->tokens.at(0));
+            } else if (opcode == DICT) {
+                auto operand = get_operand<RegisterIndex>(*instruction, 0);
+                if (not operand) {
+                    throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_if_name_resolved(register_usage_profile, *operand);
+
+                auto val = Register{*operand};
+                val.value_type = ValueTypes::DICT;
+                register_usage_profile.define(val, operand->tokens.at(0));
+            } else if (opcode == DICTINSERT) {
+                auto target = get_operand<RegisterIndex>(*instruction, 0);
+                if (not target) {
+                    throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *target);
+                assert_type_of_register<viua::internals::ValueTypes::DICT>(register_usage_profile, *target);
+
+                auto key = get_operand<RegisterIndex>(*instruction, 1);
+                if (not key) {
+                    throw invalid_syntax(instruction->operands.at(1)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *key);
+
+                auto source = get_operand<RegisterIndex>(*instruction, 2);
+                if (not source) {
+                    throw invalid_syntax(instruction->operands.at(2)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *source);
+                erase_if_direct_access(register_usage_profile, source, instruction);
+            } else if (opcode == DICTAT or opcode == DICTHAS or opcode == DICTREMOVE) {
+                auto target = get_operand<RegisterIndex>(*instruction, 0);
+                if (not target) {
+                    if (opcode != DICTREMOVE or not get_operand<VoidLiteral>(*instruction, 0)) {
+                        throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                            .note((opcode == DICTREMOVE) ? "expected register index or void literal"
+                                                         : "expected register index");
+                    }
+                }
+
+                if (target) {
+                    check_if_name_resolved(register_usage_profile, *target);
+                }
+
+                auto source = get_operand<RegisterIndex>(*instruction, 1);
+                if (not source) {
+                    throw invalid_syntax(instruction->operands.at(1)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *source);
+                assert_type_of_register<viua::internals::ValueTypes::DICT>(register_usage_profile, *source);
+
+                auto key = get_operand<RegisterIndex>(*instruction, 2);
+                if (not key) {
+                    throw invalid_syntax(instruction->operands.at(2)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *key);
+
+                if (target) {
+                    auto val = Register{*target};
+                    if (opcode == DICTAT) {
+                        val.value_type = ValueTypes::POINTER;
+                    } else if (opcode == DICTHAS) {
+                        val.value_type = ValueTypes::BOOLEAN;
+                    }
+                    register_usage_profile.define(val, target->tokens.at(0));
+                }
+            } else if (opcode == DICTSIZE or opcode == DICTKEYS) {
+                auto target = get_operand<RegisterIndex>(*instruction, 0);
+                if (not target) {
+                    throw invalid_syntax(instruction->operands.at(0)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_if_name_resolved(register_usage_profile, *target);
+
+                auto source = get_operand<RegisterIndex>(*instruction, 1);
+                if (not source) {
+                    throw invalid_syntax(instruction->operands.at(1)->tokens, "invalid operand")
+                        .note("expected register index");
+                }
+
+                check_use_of_register(register_usage_profile, *source);
+                assert_type_of_register<viua::internals::ValueTypes::DICT>(register_usage_profile, *source);
+
+                auto val = Register{*target};
+                val.value_type = ((opcode == DICTSIZE) ? ValueTypes::INTEGER : ValueTypes::VECTOR);
+                register_usage_profile.define(val, target->tokens.at(0));
             } else if (opcode == NEW) {
                 auto operand = get_operand<RegisterIndex>(*instruction, 0);
                 if (not operand) {
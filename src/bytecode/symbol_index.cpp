@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <viua/bytecode/symbol_index.h>
+#include <viua/util/memory.h>
+using namespace std;
+
+using viua::util::memory::aligned_read;
+
+
+static const uint64_t BUCKET_SIZE = 3 * sizeof(uint64_t);
+
+
+auto viua::bytecode::symbol_index::hash(const char* s, const std::size_t length) -> hash_type {
+    /*  FNV-1a.
+     *  The hash is stored in binaries so it must not depend on the platform or
+     *  the standard library used to build the VM.
+     */
+    hash_type h = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < length; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+auto viua::bytecode::symbol_index::build(const char* section, const uint64_t section_size,
+                                         const bool with_addresses) -> string {
+    struct Symbol {
+        hash_type hash;
+        uint64_t offset;
+        value_type value;
+    };
+    vector<Symbol> symbols;
+
+    uint64_t i = 0;
+    while (i < section_size) {
+        auto length = strnlen(section + i, section_size - i);
+        Symbol each{hash(section + i, length), i, symbols.size()};
+        i += length + 1;
+        if (with_addresses) {
+            if (i + sizeof(value_type) > section_size) {
+                break;
+            }
+            aligned_read(each.value) = (section + i);
+            i += sizeof(value_type);
+        }
+        symbols.push_back(each);
+    }
+
+    uint64_t bucket_count = 0;
+    if (not symbols.empty()) {
+        bucket_count = 1;
+        while (bucket_count < (symbols.size() * 2)) {
+            bucket_count <<= 1;
+        }
+    }
+
+    vector<Symbol> buckets(bucket_count, Symbol{0, EMPTY, 0});
+    for (const auto& each : symbols) {
+        auto slot = (each.hash & (bucket_count - 1));
+        while (buckets[slot].offset != EMPTY) {
+            slot = ((slot + 1) & (bucket_count - 1));
+        }
+        buckets[slot] = each;
+    }
+
+    string table;
+    table.reserve(sizeof(uint64_t) + bucket_count * BUCKET_SIZE);
+    auto put = [&table](const uint64_t value) {
+        table.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    put(bucket_count);
+    for (const auto& each : buckets) {
+        put(each.hash);
+        put(each.offset);
+        put(each.value);
+    }
+    return table;
+}
+
+
+viua::bytecode::symbol_index::Table::Table()
+    : buckets(nullptr), bucket_count(0), names(nullptr), names_size(0) {}
+viua::bytecode::symbol_index::Table::Table(const viua::internals::types::byte* table, const uint64_t available,
+                                           const char* names_section, const uint64_t names_section_size)
+    : buckets(nullptr), bucket_count(0), names(names_section), names_size(names_section_size) {
+    if (available < sizeof(uint64_t)) {
+        throw string("truncated symbol index");
+    }
+    aligned_read(bucket_count) = table;
+    if ((bucket_count & (bucket_count - 1)) != 0 or
+        bucket_count > (available - sizeof(uint64_t)) / BUCKET_SIZE) {
+        throw string("invalid symbol index");
+    }
+    buckets = (table + sizeof(uint64_t));
+}
+
+auto viua::bytecode::symbol_index::Table::size() const -> uint64_t {
+    return sizeof(uint64_t) + bucket_count * BUCKET_SIZE;
+}
+
+auto viua::bytecode::symbol_index::Table::values() const -> vector<value_type> {
+    vector<value_type> found;
+    for (uint64_t slot = 0; slot < bucket_count; ++slot) {
+        auto bucket = buckets + slot * BUCKET_SIZE;
+
+        uint64_t offset = 0;
+        aligned_read(offset) = (bucket + sizeof(uint64_t));
+        if (offset != EMPTY) {
+            value_type value = 0;
+            aligned_read(value) = (bucket + 2 * sizeof(uint64_t));
+            found.push_back(value);
+        }
+    }
+    return found;
+}
+
+auto viua::bytecode::symbol_index::Table::entries() const -> vector<pair<string, value_type>> {
+    vector<pair<string, value_type>> found;
+    for (uint64_t slot = 0; slot < bucket_count; ++slot) {
+        auto bucket = buckets + slot * BUCKET_SIZE;
+
+        uint64_t offset = 0;
+        aligned_read(offset) = (bucket + sizeof(uint64_t));
+        if (offset != EMPTY and offset < names_size) {
+            value_type value = 0;
+            aligned_read(value) = (bucket + 2 * sizeof(uint64_t));
+            found.emplace_back(string(names + offset, strnlen(names + offset, names_size - offset)), value);
+        }
+    }
+    return found;
+}
+
+auto viua::bytecode::symbol_index::Table::find(const string& name, value_type& value) const -> bool {
+    if (bucket_count == 0) {
+        return false;
+    }
+
+    const auto h = hash(name.c_str(), name.size());
+    auto slot = (h & (bucket_count - 1));
+    for (uint64_t probes = 0; probes < bucket_count; ++probes) {
+        auto bucket = buckets + slot * BUCKET_SIZE;
+
+        uint64_t offset = 0;
+        aligned_read(offset) = (bucket + sizeof(uint64_t));
+        if (offset == EMPTY) {
+            return false;
+        }
+
+        hash_type bucket_hash = 0;
+        aligned_read(bucket_hash) = bucket;
+        if (bucket_hash == h and offset < names_size and name.size() < (names_size - offset) and
+            memcmp(names + offset, name.c_str(), name.size() + 1) == 0) {
+            aligned_read(value) = (bucket + 2 * sizeof(uint64_t));
+            return true;
+        }
+
+        slot = ((slot + 1) & (bucket_count - 1));
+    }
+    return false;
+}
@@ -0,0 +1,408 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <viua/bytecode/maps.h>
+#include <viua/bytecode/opcodes.h>
+#include <viua/bytecode/operand_types.h>
+#include <viua/bytecode/verifier.h>
+#include <viua/util/memory.h>
+using namespace std;
+
+using viua::internals::types::bytecode_size;
+using viua::util::memory::load_aligned;
+
+
+static auto at(const bytecode_size address) -> string {
+    ostringstream oss;
+    oss << "0x" << hex << address;
+    return oss.str();
+}
+
+/*  Instructions are walked without disassembling them.
+ *  Each of the functions below moves the pointer past one part of an instruction,
+ *  and throws if that part is malformed or does not fit in the bytecode.
+ *  The layout of operands must match the one used by disassembler::instruction().
+ */
+static auto skip(viua::internals::types::byte*& ptr, const viua::internals::types::byte* end,
+                 const bytecode_size n) -> void {
+    if (n > static_cast<bytecode_size>(end - ptr)) {
+        throw string("crosses the end of bytecode");
+    }
+    ptr += n;
+}
+static auto skip_string(viua::internals::types::byte*& ptr, const viua::internals::types::byte* end) -> void {
+    auto terminator = memchr(ptr, 0, static_cast<size_t>(end - ptr));
+    if (terminator == nullptr) {
+        throw string("crosses the end of bytecode");
+    }
+    ptr = (static_cast<viua::internals::types::byte*>(terminator) + 1);
+}
+static auto peek_operand_type(const viua::internals::types::byte* ptr, const viua::internals::types::byte* end)
+    -> OperandType {
+    if (ptr == end) {
+        throw string("crosses the end of bytecode");
+    }
+    return OperandType(*ptr);
+}
+static auto skip_register_operand(viua::internals::types::byte*& ptr, const viua::internals::types::byte* end)
+    -> void {
+    switch (peek_operand_type(ptr, end)) {
+        case OT_REGISTER_INDEX:
+        case OT_REGISTER_REFERENCE:
+        case OT_POINTER:
+            skip(ptr, end,
+                 sizeof(OperandType) + sizeof(viua::internals::types::register_index) +
+                     sizeof(viua::internals::RegisterSets));
+            break;
+        case OT_VOID:
+            skip(ptr, end, sizeof(OperandType));
+            break;
+        case OT_INT:
+            skip(ptr, end, sizeof(OperandType) + sizeof(viua::internals::types::plain_int));
+            break;
+        default:
+            throw string("invalid operand type detected");
+    }
+}
+static auto skip_register_operands(viua::internals::types::byte*& ptr, const viua::internals::types::byte* end,
+                                   unsigned n) -> void {
+    for (; n; --n) {
+        skip_register_operand(ptr, end);
+    }
+}
+static auto is_register_or_pointer(const viua::internals::types::byte* ptr,
+                                   const viua::internals::types::byte* end) -> bool {
+    const auto ot = peek_operand_type(ptr, end);
+    return (ot == OT_REGISTER_INDEX or ot == OT_POINTER);
+}
+
+static auto skip_instruction(viua::internals::types::byte* ptr, const viua::internals::types::byte* end,
+                             viua::internals::types::byte*& atom_literal) -> viua::internals::types::byte* {
+    /*  Returns address of the next instruction.
+     *  If the instruction is an ATOM the address of its literal is stored in atom_literal.
+     */
+    const auto op = OPCODE(*ptr);
+    ++ptr;
+
+    switch (op) {
+        case STRING:
+            skip_register_operand(ptr, end);
+            skip(ptr, end, sizeof(OperandType));
+            skip_string(ptr, end);
+            break;
+        case TEXT:
+            skip_register_operand(ptr, end);
+            if (not is_register_or_pointer(ptr, end)) {
+                skip(ptr, end, sizeof(OperandType));
+                skip_string(ptr, end);
+            } else {
+                skip_register_operand(ptr, end);
+            }
+            break;
+        case ATOM:
+            skip_register_operand(ptr, end);
+            atom_literal = ptr;
+            skip_string(ptr, end);
+            break;
+        case CLOSURE:
+        case FUNCTION:
+        case CLASS:
+        case NEW:
+        case DERIVE:
+            skip_register_operand(ptr, end);
+            skip_string(ptr, end);
+            break;
+        case CALL:
+        case PROCESS:
+        case MSG:
+            skip_register_operand(ptr, end);
+            if (is_register_or_pointer(ptr, end)) {
+                skip_register_operand(ptr, end);
+            } else {
+                skip_string(ptr, end);
+            }
+            break;
+        case TAILCALL:
+        case DEFER:
+            if (is_register_or_pointer(ptr, end)) {
+                skip_register_operand(ptr, end);
+            } else {
+                skip_string(ptr, end);
+            }
+            break;
+        case IMPORT:
+        case ENTER:
+        case WATCHDOG:
+            skip_string(ptr, end);
+            break;
+        case CATCH:
+            skip_string(ptr, end);
+            skip_string(ptr, end);
+            break;
+        case ATTACH:
+            skip_register_operand(ptr, end);
+            skip_string(ptr, end);
+            skip_string(ptr, end);
+            break;
+        case IZERO:
+        case PRINT:
+        case ECHO:
+        case THROW:
+        case DRAW:
+        case DELETE:
+        case IINC:
+        case IDEC:
+        case VSORT:
+        case SELF:
+        case ARGC:
+        case STRUCT:
+        case DICT:
+        case WRAPINCREMENT:
+        case WRAPDECREMENT:
+        case CHECKEDSINCREMENT:
+        case CHECKEDSDECREMENT:
+        case CHECKEDUINCREMENT:
+        case CHECKEDUDECREMENT:
+        case SATURATINGSINCREMENT:
+        case SATURATINGSDECREMENT:
+        case SATURATINGUINCREMENT:
+        case SATURATINGUDECREMENT:
+        case REGISTER:
+        case BOOL:
+            skip_register_operands(ptr, end, 1);
+            break;
+        case INTEGER:
+        case FRAME:
+        case ARG:
+        case PARAM:
+        case PAMV:
+        case SEND:
+        case ITOF:
+        case FTOI:
+        case STOI:
+        case STOF:
+        case ISNULL:
+        case NOT:
+        case MOVE:
+        case COPY:
+        case PTR:
+        case SWAP:
+        case VPUSH:
+        case VLEN:
+        case VSUM:
+        case VMIN:
+        case VMAX:
+        case TEXTLENGTH:
+        case STRUCTKEYS:
+        case DICTSIZE:
+        case DICTKEYS:
+        case BITNOT:
+        case ROL:
+        case ROR:
+            skip_register_operands(ptr, end, 2);
+            break;
+        case BITS:
+            skip_register_operand(ptr, end);
+            if (peek_operand_type(ptr, end) == OT_BITS) {
+                skip(ptr, end, sizeof(OperandType));
+                const auto bits_start = ptr;
+                skip(ptr, end, sizeof(viua::internals::types::bits_size));
+                skip(ptr, end, load_aligned<viua::internals::types::bits_size>(bits_start));
+            } else {
+                skip_register_operand(ptr, end);
+            }
+            break;
+        case ADD:
+        case SUB:
+        case MUL:
+        case DIV:
+        case LT:
+        case LTE:
+        case GT:
+        case GTE:
+        case EQ:
+        case BITAND:
+        case BITOR:
+        case BITXOR:
+        case BITAT:
+        case SHL:
+        case SHR:
+        case ASHL:
+        case ASHR:
+        case WRAPADD:
+        case WRAPSUB:
+        case WRAPMUL:
+        case WRAPDIV:
+        case CHECKEDSADD:
+        case CHECKEDSSUB:
+        case CHECKEDSMUL:
+        case CHECKEDSDIV:
+        case CHECKEDUADD:
+        case CHECKEDUSUB:
+        case CHECKEDUMUL:
+        case CHECKEDUDIV:
+        case SATURATINGSADD:
+        case SATURATINGSSUB:
+        case SATURATINGSMUL:
+        case SATURATINGSDIV:
+        case SATURATINGUADD:
+        case SATURATINGUSUB:
+        case SATURATINGUMUL:
+        case SATURATINGUDIV:
+        case VECTOR:
+        case VAT:
+        case CAPTURE:
+        case CAPTURECOPY:
+        case CAPTUREMOVE:
+        case AND:
+        case OR:
+        case TEXTEQ:
+        case TEXTAT:
+        case TEXTCOMMONPREFIX:
+        case TEXTCOMMONSUFFIX:
+        case TEXTCONCAT:
+        case VINSERT:
+        case VPOP:
+        case VDOT:
+        case VADD:
+        case VSUB:
+        case VMUL:
+        case VDIV:
+        case ATOMEQ:
+        case STRUCTINSERT:
+        case STRUCTREMOVE:
+        case DICTINSERT:
+        case DICTAT:
+        case DICTHAS:
+        case DICTREMOVE:
+        case STREQ:
+        case INSERT:
+        case REMOVE:
+            skip_register_operands(ptr, end, 3);
+            break;
+        case BITSET:
+            skip_register_operands(ptr, end, 2);
+            if (peek_operand_type(ptr, end) == OT_TRUE or peek_operand_type(ptr, end) == OT_FALSE) {
+                skip(ptr, end, sizeof(OperandType));
+            } else {
+                skip_register_operand(ptr, end);
+            }
+            break;
+        case TEXTSUB:
+            skip_register_operands(ptr, end, 4);
+            break;
+        case JUMP:
+            skip(ptr, end, sizeof(uint64_t));
+            break;
+        case IF:
+            skip_register_operand(ptr, end);
+            skip(ptr, end, 2 * sizeof(uint64_t));
+            break;
+        case FLOAT:
+            skip_register_operand(ptr, end);
+            skip(ptr, end, sizeof(viua::internals::types::plain_float));
+            break;
+        case RESS:
+            skip(ptr, end, sizeof(viua::internals::types::registerset_type_marker));
+            break;
+        case JOIN:
+            skip_register_operands(ptr, end, 2);
+            skip(ptr, end, sizeof(viua::internals::types::byte) + sizeof(viua::internals::types::timeout));
+            break;
+        case RECEIVE:
+            skip_register_operand(ptr, end);
+            skip(ptr, end, sizeof(viua::internals::types::byte) + sizeof(viua::internals::types::timeout));
+            break;
+        default:
+            // opcodes without operands
+            break;
+    }
+
+    return ptr;
+}
+
+auto viua::bytecode::verifier::verify(viua::internals::types::byte* code, const bytecode_size size,
+                                      vector<bytecode_size> entry_points) -> vector<bytecode_size> {
+    sort(entry_points.begin(), entry_points.end());
+    entry_points.erase(unique(entry_points.begin(), entry_points.end()), entry_points.end());
+
+    vector<bool> instruction_starts(size, false);
+    vector<bytecode_size> jumps;
+    vector<bytecode_size> atom_literals;
+
+    const viua::internals::types::byte* end = (code + size);
+    for (bytecode_size i = 0; i < size;) {
+        const auto op = OPCODE(code[i]);
+        if (OP_NAMES.count(op) == 0) {
+            throw("invalid opcode " + to_string(static_cast<unsigned>(code[i])) + " at " + at(i));
+        }
+
+        viua::internals::types::byte* atom_literal = nullptr;
+        viua::internals::types::byte* next = nullptr;
+        try {
+            next = skip_instruction(code + i, end, atom_literal);
+        } catch (const string& e) {
+            throw("malformed " + OP_NAMES.at(op) + " instruction at " + at(i) + ": " + e);
+        }
+
+        instruction_starts[i] = true;
+        if (op == JUMP or op == IF) {
+            jumps.push_back(i);
+        }
+        if (atom_literal) {
+            atom_literals.push_back(static_cast<bytecode_size>(atom_literal - code));
+        }
+        i = static_cast<bytecode_size>(next - code);
+    }
+
+    for (const auto each : entry_points) {
+        if (each >= size or not instruction_starts[each]) {
+            throw("entry point " + at(each) + " is not at the beginning of an instruction");
+        }
+    }
+
+    for (const auto each : jumps) {
+        // function containing the jump spans from the closest entry point to the next one
+        auto next = upper_bound(entry_points.begin(), entry_points.end(), each);
+        const bytecode_size function_begin = (next == entry_points.begin() ? 0 : *(next - 1));
+        const bytecode_size function_end = (next == entry_points.end() ? size : *next);
+
+        // targets are the last operands of both JUMP and IF
+        viua::internals::types::byte* unused = nullptr;
+        const auto instruction_end = skip_instruction(code + each, end, unused);
+        const auto targets = (OPCODE(code[each]) == JUMP ? 1 : 2);
+        for (auto t = targets; t; --t) {
+            const auto target = load_aligned<uint64_t>(instruction_end - t * sizeof(uint64_t));
+            if (target == each) {
+                throw(OP_NAMES.at(OPCODE(code[each])) + " instruction at " + at(each) + " jumps to itself");
+            }
+            if (target < function_begin or target >= function_end or not instruction_starts[target]) {
+                throw(OP_NAMES.at(OPCODE(code[each])) + " instruction at " + at(each) + " jumps to " +
+                      at(target) + " which is not an instruction of the same function");
+            }
+        }
+    }
+
+    return atom_literals;
+}
@@ -435,7 +435,7 @@ static void check_block_body(const TokenVector& body_tokens, TokenVector::size_t
 
             i = skip_till_next_line(body_tokens, i);
             continue;
-        } else if (token == "vlen") {
+        } else if (token == "vlen" or token == "vsum" or token == "vmin" or token == "vmax") {
             TokenIndex target = i + 1;
             TokenIndex source = target + 2;
 
@@ -658,7 +658,8 @@ static void check_block_body(const TokenVector& body_tokens, TokenVector::size_t
                                   "closure of empty register");
 
             i = skip_till_next_line(body_tokens, i);
-        } else if (token == "copy" or token == "ptr" or token == "textlength" or token == "structkeys") {
+        } else if (token == "copy" or token == "ptr" or token == "textlength" or token == "structkeys" or
+                   token == "dictsize" or token == "dictkeys") {
             TokenIndex target = i + 1;
             TokenIndex source = target + 2;
 
@@ -762,7 +763,8 @@ static void check_block_body(const TokenVector& body_tokens, TokenVector::size_t
         } else if (token == "and" or token == "or" or token == "texteq" or token == "textat" or
                    token == "textcommonprefix" or token == "textcommonsuffix" or token == "textconcat" or
                    token == "atomeq" or token == "bitand" or token == "bitor" or token == "bitxor" or
-                   token == "bitat") {
+                   token == "bitat" or token == "vdot" or token == "vadd" or token == "vsub" or
+                   token == "vmul" or token == "vdiv") {
             ++i;  // skip mnemonic token
 
             TokenIndex target = i;
@@ -884,7 +886,7 @@ static void check_block_body(const TokenVector& body_tokens, TokenVector::size_t
 
             i = skip_till_next_line(body_tokens, i);
         } else if (token == "iinc" or token == "idec" or token == "wrapincrement" or
-                   token == "wrapdecrement") {
+                   token == "wrapdecrement" or token == "vsort") {
             // skip mnemonic
             ++i;
             check_use_of_register(body_tokens, i, i - 1, registers, named_registers, "use of empty register");
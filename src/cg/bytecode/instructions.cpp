@@ -334,6 +334,51 @@ namespace cg {
             return insert_two_ri_instruction(addr_ptr, VLEN, vec, reg);
         }
 
+        viua::internals::types::byte* opvsum(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op vec) {
+            return insert_two_ri_instruction(addr_ptr, VSUM, target, vec);
+        }
+
+        viua::internals::types::byte* opvmin(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op vec) {
+            return insert_two_ri_instruction(addr_ptr, VMIN, target, vec);
+        }
+
+        viua::internals::types::byte* opvmax(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op vec) {
+            return insert_two_ri_instruction(addr_ptr, VMAX, target, vec);
+        }
+
+        viua::internals::types::byte* opvdot(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op lhs, int_op rhs) {
+            return insert_three_ri_instruction(addr_ptr, VDOT, target, lhs, rhs);
+        }
+
+        viua::internals::types::byte* opvadd(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op lhs, int_op rhs) {
+            return insert_three_ri_instruction(addr_ptr, VADD, target, lhs, rhs);
+        }
+
+        viua::internals::types::byte* opvsub(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op lhs, int_op rhs) {
+            return insert_three_ri_instruction(addr_ptr, VSUB, target, lhs, rhs);
+        }
+
+        viua::internals::types::byte* opvmul(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op lhs, int_op rhs) {
+            return insert_three_ri_instruction(addr_ptr, VMUL, target, lhs, rhs);
+        }
+
+        viua::internals::types::byte* opvdiv(viua::internals::types::byte* addr_ptr, int_op target,
+                                             int_op lhs, int_op rhs) {
+            return insert_three_ri_instruction(addr_ptr, VDIV, target, lhs, rhs);
+        }
+
+        viua::internals::types::byte* opvsort(viua::internals::types::byte* addr_ptr, int_op vec) {
+            *(addr_ptr++) = VSORT;
+            return insert_ri_operand(addr_ptr, vec);
+        }
+
         viua::internals::types::byte* opnot(viua::internals::types::byte* addr_ptr, int_op target,
                                             int_op source) {
             *(addr_ptr++) = NOT;
@@ -929,6 +974,41 @@ namespace cg {
             return insert_two_ri_instruction(addr_ptr, STRUCTKEYS, target, source);
         }
 
+        viua::internals::types::byte* opdict(viua::internals::types::byte* addr_ptr, int_op regno) {
+            *(addr_ptr++) = DICT;
+            return insert_ri_operand(addr_ptr, regno);
+        }
+
+        viua::internals::types::byte* opdictinsert(viua::internals::types::byte* addr_ptr, int_op target,
+                                                   int_op key, int_op source) {
+            return insert_three_ri_instruction(addr_ptr, DICTINSERT, target, key, source);
+        }
+
+        viua::internals::types::byte* opdictat(viua::internals::types::byte* addr_ptr, int_op target,
+                                               int_op source, int_op key) {
+            return insert_three_ri_instruction(addr_ptr, DICTAT, target, source, key);
+        }
+
+        viua::internals::types::byte* opdicthas(viua::internals::types::byte* addr_ptr, int_op target,
+                                                int_op source, int_op key) {
+            return insert_three_ri_instruction(addr_ptr, DICTHAS, target, source, key);
+        }
+
+        viua::internals::types::byte* opdictremove(viua::internals::types::byte* addr_ptr, int_op target,
+                                                   int_op source, int_op key) {
+            return insert_three_ri_instruction(addr_ptr, DICTREMOVE, target, source, key);
+        }
+
+        viua::internals::types::byte* opdictsize(viua::internals::types::byte* addr_ptr, int_op target,
+                                                 int_op source) {
+            return insert_two_ri_instruction(addr_ptr, DICTSIZE, target, source);
+        }
+
+        viua::internals::types::byte* opdictkeys(viua::internals::types::byte* addr_ptr, int_op target,
+                                                 int_op source) {
+            return insert_two_ri_instruction(addr_ptr, DICTKEYS, target, source);
+        }
+
         viua::internals::types::byte* opnew(viua::internals::types::byte* addr_ptr, int_op reg,
                                             const string& class_name) {
             *(addr_ptr++) = NEW;
@@ -426,9 +426,11 @@ tuple<string, viua::internals::types::bytecode_size> disassembler::instruction(
         case DELETE:
         case IINC:
         case IDEC:
+        case VSORT:
         case SELF:
         case ARGC:
         case STRUCT:
+        case DICT:
         case WRAPINCREMENT:
         case WRAPDECREMENT:
         case CHECKEDSINCREMENT:
@@ -476,8 +478,13 @@ tuple<string, viua::internals::types::bytecode_size> disassembler::instruction(
         case SWAP:
         case VPUSH:
         case VLEN:
+        case VSUM:
+        case VMIN:
+        case VMAX:
         case TEXTLENGTH:
         case STRUCTKEYS:
+        case DICTSIZE:
+        case DICTKEYS:
         case BITNOT:
         case ROL:
         case ROR:
@@ -580,9 +587,18 @@ tuple<string, viua::internals::types::bytecode_size> disassembler::instruction(
         case TEXTCONCAT:
         case VINSERT:
         case VPOP:
+        case VDOT:
+        case VADD:
+        case VSUB:
+        case VMUL:
+        case VDIV:
         case ATOMEQ:
         case STRUCTINSERT:
         case STRUCTREMOVE:
+        case DICTINSERT:
+        case DICTAT:
+        case DICTHAS:
+        case DICTREMOVE:
             ptr = disassemble_ri_operand_with_rs_type(oss, ptr);
             ptr = disassemble_ri_operand_with_rs_type(oss, ptr);
             ptr = disassemble_ri_operand_with_rs_type(oss, ptr);
@@ -566,7 +566,8 @@ namespace viua {
                         } else {
                             tokens.push_back(input_tokens.at(++i));
                         }
-                    } else if (token == "insert" or token == "structinsert") {
+                    } else if (token == "insert" or token == "structinsert" or token == "dictinsert" or
+                               token == "dictat" or token == "dicthas") {
                         tokens.push_back(token);  // mnemonic
 
                         tokens.push_back(input_tokens.at(++i));  // target register
@@ -589,7 +590,7 @@ namespace viua {
                         } else {
                             tokens.push_back(input_tokens.at(++i));
                         }
-                    } else if (token == "remove" or token == "structremove") {
+                    } else if (token == "remove" or token == "structremove" or token == "dictremove") {
                         tokens.push_back(token);  // mnemonic
 
                         tokens.push_back(input_tokens.at(++i));  // target register
@@ -957,7 +958,7 @@ namespace viua {
                     } else if (token == "move" or token == "copy" or token == "swap" or token == "ptr" or
                                token == "isnull" or token == "send" or token == "textlength" or
                                token == "structkeys" or token == "bits" or token == "bitset" or
-                               token == "bitat") {
+                               token == "bitat" or token == "dictsize" or token == "dictkeys") {
                         tokens.push_back(token);  // mnemonic
 
                         if (input_tokens.at(i + 1) == "[[") {
@@ -996,7 +997,7 @@ namespace viua {
                         }
                     } else if (token == "izero" or token == "print" or token == "argc" or token == "echo" or
                                token == "delete" or token == "draw" or token == "throw" or token == "iinc" or
-                               token == "idec" or token == "self" or token == "struct") {
+                               token == "idec" or token == "self" or token == "struct" or token == "dict") {
                         tokens.push_back(token);                 // mnemonic
                         tokens.push_back(input_tokens.at(++i));  // target register
                         if (input_tokens.at(i + 1) == "\n") {
@@ -1253,7 +1254,8 @@ namespace viua {
                         } else {
                             tokens.push_back(input_tokens.at(++i));
                         }
-                    } else if (token == "insert" or token == "structinsert") {
+                    } else if (token == "insert" or token == "structinsert" or token == "dictinsert" or
+                               token == "dictat" or token == "dicthas") {
                         tokens.push_back(input_tokens.at(++i));  // target register
                         if (not is_register_set_name(input_tokens.at(i + 1))) {
                             tokens.emplace_back(tokens.back().line(), tokens.back().character(), "current");
@@ -1274,7 +1276,7 @@ namespace viua {
                         } else {
                             tokens.push_back(input_tokens.at(++i));
                         }
-                    } else if (token == "remove" or token == "structremove") {
+                    } else if (token == "remove" or token == "structremove" or token == "dictremove") {
                         tokens.push_back(input_tokens.at(++i));  // target register
                         if (tokens.back() != "void") {
                             if (not is_register_set_name(input_tokens.at(i + 1))) {
@@ -1617,7 +1619,8 @@ namespace viua {
                         }
                     } else if (token == "move" or token == "copy" or token == "swap" or token == "ptr" or
                                token == "isnull" or token == "send" or token == "textlength" or
-                               token == "structkeys" or token == "bitset" or token == "bitat") {
+                               token == "structkeys" or token == "bitset" or token == "bitat" or
+                               token == "dictsize" or token == "dictkeys") {
                         if (input_tokens.at(i + 1) == "[[") {  // FIXME attributes
                             do {
                                 tokens.push_back(input_tokens.at(++i));
@@ -1671,7 +1674,7 @@ namespace viua {
                         }
                     } else if (token == "izero" or token == "print" or token == "argc" or token == "echo" or
                                token == "delete" or token == "draw" or token == "throw" or token == "iinc" or
-                               token == "idec" or token == "self" or token == "struct" or
+                               token == "idec" or token == "self" or token == "struct" or token == "dict" or
                                token == "wrapincrement" or token == "wrapdecrement") {
                         tokens.push_back(input_tokens.at(++i));  // target register
                         if (input_tokens.at(i + 1) == "\n") {
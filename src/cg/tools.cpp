@@ -534,6 +534,42 @@ namespace viua {
                 -> tuple<bytecode_size_type, decltype(i)> {
                 return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
             }
+            static auto size_of_vsum(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vmin(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vmax(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vdot(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vadd(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vsub(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vmul(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vdiv(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_vsort(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_one_ri_operand_with_rs_type(tokens, i);
+            }
             static auto size_of_bool(const TokenVector& tokens, TokenVector::size_type i)
                 -> tuple<bytecode_size_type, decltype(i)> {
                 return size_of_instruction_with_one_ri_operand(tokens, i);
@@ -1216,6 +1252,34 @@ namespace viua {
                 -> tuple<bytecode_size_type, decltype(i)> {
                 return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
             }
+            static auto size_of_dict(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_one_ri_operand(tokens, i);
+            }
+            static auto size_of_dictinsert(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_dictat(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_dicthas(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_dictremove(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_three_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_dictsize(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
+            }
+            static auto size_of_dictkeys(const TokenVector& tokens, TokenVector::size_type i)
+                -> tuple<bytecode_size_type, decltype(i)> {
+                return size_of_instruction_with_two_ri_operands_with_rs_types(tokens, i);
+            }
 
             static auto size_of_new(const TokenVector& tokens, TokenVector::size_type i)
                 -> tuple<bytecode_size_type, decltype(i)> {
@@ -1421,6 +1485,33 @@ namespace viua {
                     } else if (tokens.at(i) == "vlen") {
                         ++i;
                         tie(increase, i) = size_of_vlen(tokens, i);
+                    } else if (tokens.at(i) == "vsum") {
+                        ++i;
+                        tie(increase, i) = size_of_vsum(tokens, i);
+                    } else if (tokens.at(i) == "vmin") {
+                        ++i;
+                        tie(increase, i) = size_of_vmin(tokens, i);
+                    } else if (tokens.at(i) == "vmax") {
+                        ++i;
+                        tie(increase, i) = size_of_vmax(tokens, i);
+                    } else if (tokens.at(i) == "vdot") {
+                        ++i;
+                        tie(increase, i) = size_of_vdot(tokens, i);
+                    } else if (tokens.at(i) == "vadd") {
+                        ++i;
+                        tie(increase, i) = size_of_vadd(tokens, i);
+                    } else if (tokens.at(i) == "vsub") {
+                        ++i;
+                        tie(increase, i) = size_of_vsub(tokens, i);
+                    } else if (tokens.at(i) == "vmul") {
+                        ++i;
+                        tie(increase, i) = size_of_vmul(tokens, i);
+                    } else if (tokens.at(i) == "vdiv") {
+                        ++i;
+                        tie(increase, i) = size_of_vdiv(tokens, i);
+                    } else if (tokens.at(i) == "vsort") {
+                        ++i;
+                        tie(increase, i) = size_of_vsort(tokens, i);
                     } else if (tokens.at(i) == "bool") {
                         ++i;
                         tie(increase, i) = size_of_bool(tokens, i);
@@ -1706,6 +1797,27 @@ namespace viua {
                     } else if (tokens.at(i) == "structkeys") {
                         ++i;
                         tie(increase, i) = size_of_structkeys(tokens, i);
+                    } else if (tokens.at(i) == "dict") {
+                        ++i;
+                        tie(increase, i) = size_of_dict(tokens, i);
+                    } else if (tokens.at(i) == "dictinsert") {
+                        ++i;
+                        tie(increase, i) = size_of_dictinsert(tokens, i);
+                    } else if (tokens.at(i) == "dictat") {
+                        ++i;
+                        tie(increase, i) = size_of_dictat(tokens, i);
+                    } else if (tokens.at(i) == "dicthas") {
+                        ++i;
+                        tie(increase, i) = size_of_dicthas(tokens, i);
+                    } else if (tokens.at(i) == "dictremove") {
+                        ++i;
+                        tie(increase, i) = size_of_dictremove(tokens, i);
+                    } else if (tokens.at(i) == "dictsize") {
+                        ++i;
+                        tie(increase, i) = size_of_dictsize(tokens, i);
+                    } else if (tokens.at(i) == "dictkeys") {
+                        ++i;
+                        tie(increase, i) = size_of_dictkeys(tokens, i);
                     } else if (tokens.at(i) == "new") {
                         ++i;
                         tie(increase, i) = size_of_new(tokens, i);
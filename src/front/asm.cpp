@@ -54,6 +54,8 @@ bool REPORT_BYTECODE_SIZE = false;
 bool PERFORM_STATIC_ANALYSIS = true;
 bool USE_NEW_SA = true;
 bool SHOW_META = false;
+// should the symbol index be written after the bytecode?
+bool WRITE_SYMBOL_INDEX = true;
 
 bool VERBOSE = false;
 bool DEBUG = false;
@@ -124,7 +126,9 @@ static bool usage(const char* program, bool show_help, bool show_version, bool v
              << "    --no-sa              - disable static checking of register accesses (use in case of "
                 "false positives)\n"
              << "    --new-sa             - use new static analyser (more precise, with better features, but "
-                "without coverage of all instructions yet)\n";
+                "without coverage of all instructions yet)\n"
+             << "    --no-symbol-index    - do not write symbol index section (the index makes loading faster, "
+                "but the binary is larger)\n";
     }
 
     return (show_help or show_version);
@@ -196,6 +200,9 @@ int main(int argc, char* argv[]) {
         } else if (option == "--new-sa") {
             USE_NEW_SA = true;
             continue;
+        } else if (option == "--no-symbol-index") {
+            WRITE_SYMBOL_INDEX = false;
+            continue;
         } else if (str::startswith(option, "-")) {
             cerr << send_control_seq(COLOR_FG_RED) << "error" << send_control_seq(ATTR_RESET);
             cerr << ": unknown option: ";
@@ -329,6 +336,7 @@ int main(int argc, char* argv[]) {
 
     compilationflags_t flags;
     flags.as_lib = AS_LIB;
+    flags.symbol_index = WRITE_SYMBOL_INDEX;
     flags.verbose = VERBOSE;
     flags.debug = DEBUG;
     flags.scream = SCREAM;
@@ -587,6 +587,90 @@ viua::internals::types::bytecode_size assemble_instruction(
                                                                 resolve_rs_type(tokens.at(target + 1))),
                        assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
                                                                 resolve_rs_type(tokens.at(source + 1))));
+    } else if (tokens.at(i) == "vsum") {
+        TokenIndex target = i + 1;
+        TokenIndex source = target + 2;
+
+        program.opvsum(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                                resolve_rs_type(tokens.at(source + 1))));
+    } else if (tokens.at(i) == "vmin") {
+        TokenIndex target = i + 1;
+        TokenIndex source = target + 2;
+
+        program.opvmin(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                                resolve_rs_type(tokens.at(source + 1))));
+    } else if (tokens.at(i) == "vmax") {
+        TokenIndex target = i + 1;
+        TokenIndex source = target + 2;
+
+        program.opvmax(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                                resolve_rs_type(tokens.at(source + 1))));
+    } else if (tokens.at(i) == "vdot") {
+        TokenIndex target = i + 1;
+        TokenIndex lhs = target + 2;
+        TokenIndex rhs = lhs + 2;
+
+        program.opvdot(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(lhs)),
+                                                                resolve_rs_type(tokens.at(lhs + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(rhs)),
+                                                                resolve_rs_type(tokens.at(rhs + 1))));
+    } else if (tokens.at(i) == "vadd") {
+        TokenIndex target = i + 1;
+        TokenIndex lhs = target + 2;
+        TokenIndex rhs = lhs + 2;
+
+        program.opvadd(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(lhs)),
+                                                                resolve_rs_type(tokens.at(lhs + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(rhs)),
+                                                                resolve_rs_type(tokens.at(rhs + 1))));
+    } else if (tokens.at(i) == "vsub") {
+        TokenIndex target = i + 1;
+        TokenIndex lhs = target + 2;
+        TokenIndex rhs = lhs + 2;
+
+        program.opvsub(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(lhs)),
+                                                                resolve_rs_type(tokens.at(lhs + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(rhs)),
+                                                                resolve_rs_type(tokens.at(rhs + 1))));
+    } else if (tokens.at(i) == "vmul") {
+        TokenIndex target = i + 1;
+        TokenIndex lhs = target + 2;
+        TokenIndex rhs = lhs + 2;
+
+        program.opvmul(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(lhs)),
+                                                                resolve_rs_type(tokens.at(lhs + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(rhs)),
+                                                                resolve_rs_type(tokens.at(rhs + 1))));
+    } else if (tokens.at(i) == "vdiv") {
+        TokenIndex target = i + 1;
+        TokenIndex lhs = target + 2;
+        TokenIndex rhs = lhs + 2;
+
+        program.opvdiv(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(lhs)),
+                                                                resolve_rs_type(tokens.at(lhs + 1))),
+                       assembler::operands::getint_with_rs_type(resolveregister(tokens.at(rhs)),
+                                                                resolve_rs_type(tokens.at(rhs + 1))));
+    } else if (tokens.at(i) == "vsort") {
+        TokenIndex target = i + 1;
+
+        program.opvsort(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                 resolve_rs_type(tokens.at(target + 1))));
     } else if (tokens.at(i) == "not") {
         TokenIndex target = i + 1;
         TokenIndex source = target + 2;
@@ -1223,6 +1307,81 @@ viua::internals::types::bytecode_size assemble_instruction(
                                                                       resolve_rs_type(tokens.at(target + 1))),
                              assembler::operands::getint_with_rs_type(
                                  resolveregister(tokens.at(source)), resolve_rs_type(tokens.at(source + 1))));
+    } else if (tokens.at(i) == "dict") {
+        TokenIndex target = i + 1;
+
+        program.opdict(assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                resolve_rs_type(tokens.at(target + 1))));
+    } else if (tokens.at(i) == "dictinsert") {
+        TokenIndex target = i + 1;
+        TokenIndex key = target + 2;
+        TokenIndex source = key + 2;
+
+        program.opdictinsert(
+            assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                     resolve_rs_type(tokens.at(target + 1))),
+            assembler::operands::getint_with_rs_type(resolveregister(tokens.at(key)),
+                                                     resolve_rs_type(tokens.at(key + 1))),
+            assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                     resolve_rs_type(tokens.at(source + 1))));
+    } else if (tokens.at(i) == "dictat" or tokens.at(i) == "dicthas") {
+        TokenIndex target = i + 1;
+        TokenIndex source = target + 2;
+        TokenIndex key = source + 2;
+
+        if (tokens.at(i) == "dictat") {
+            program.opdictat(
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                         resolve_rs_type(tokens.at(target + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                         resolve_rs_type(tokens.at(source + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(key)),
+                                                         resolve_rs_type(tokens.at(key + 1))));
+        } else {
+            program.opdicthas(
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                         resolve_rs_type(tokens.at(target + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                         resolve_rs_type(tokens.at(source + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(key)),
+                                                         resolve_rs_type(tokens.at(key + 1))));
+        }
+    } else if (tokens.at(i) == "dictremove") {
+        TokenIndex target = i + 1;
+        TokenIndex source = target + 2;
+        TokenIndex key = source + 2;
+
+        if (tokens.at(target) == "void") {
+            --source;
+            --key;
+            program.opdictremove(
+                assembler::operands::getint(resolveregister(tokens.at(target))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                         resolve_rs_type(tokens.at(source + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(key)),
+                                                         resolve_rs_type(tokens.at(key + 1))));
+        } else {
+            program.opdictremove(
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                         resolve_rs_type(tokens.at(target + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                         resolve_rs_type(tokens.at(source + 1))),
+                assembler::operands::getint_with_rs_type(resolveregister(tokens.at(key)),
+                                                         resolve_rs_type(tokens.at(key + 1))));
+        }
+    } else if (tokens.at(i) == "dictsize" or tokens.at(i) == "dictkeys") {
+        TokenIndex target = i + 1;
+        TokenIndex source = target + 2;
+
+        auto target_operand = assembler::operands::getint_with_rs_type(resolveregister(tokens.at(target)),
+                                                                       resolve_rs_type(tokens.at(target + 1)));
+        auto source_operand = assembler::operands::getint_with_rs_type(resolveregister(tokens.at(source)),
+                                                                       resolve_rs_type(tokens.at(source + 1)));
+        if (tokens.at(i) == "dictsize") {
+            program.opdictsize(target_operand, source_operand);
+        } else {
+            program.opdictkeys(target_operand, source_operand);
+        }
     } else if (tokens.at(i) == "new") {
         TokenIndex target = i + 1;
         TokenIndex class_name = target + 2;
@@ -19,11 +19,13 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <viua/assembler/util/pretty_printer.h>
 #include <viua/bytecode/maps.h>
+#include <viua/bytecode/symbol_index.h>
 #include <viua/cg/assembler/assembler.h>
 #include <viua/cg/tokenizer.h>
 #include <viua/cg/tools.h>
@@ -34,6 +36,7 @@
 #include <viua/support/env.h>
 #include <viua/support/string.h>
 #include <viua/util/memory.h>
+#include <viua/util/parallel.h>
 using namespace std;
 
 using viua::util::memory::aligned_read;
@@ -55,10 +58,21 @@ extern bool SCREAM;
 using Token = viua::cg::lex::Token;
 
 
-template<class T> void bwrite(ofstream& out, const T& object) {
+/*  Contents of a module given to the assembler to be linked statically.
+ */
+struct LinkedModule {
+    vector<string> function_names;
+    map<string, viua::internals::types::bytecode_size> function_addresses;
+    vector<viua::internals::types::bytecode_size> jumps;
+    viua::internals::types::bytecode_size size;
+    unique_ptr<viua::internals::types::byte[]> bytecode;
+};
+
+
+template<class T> void bwrite(ostream& out, const T& object) {
     out.write(reinterpret_cast<const char*>(&object), sizeof(T));
 }
-static void strwrite(ofstream& out, const string& s) {
+static void strwrite(ostream& out, const string& s) {
     out.write(s.c_str(), static_cast<std::streamsize>(s.size()));
     out.put('\0');
 }
@@ -161,7 +175,7 @@ static map<string, viua::internals::types::bytecode_size> mapInvocableAddresses(
 }
 
 static viua::internals::types::bytecode_size writeCodeBlocksSection(
-    ofstream& out, const invocables_t& blocks, const vector<string>& linked_block_names,
+    ostream& out, const invocables_t& blocks, const vector<string>& linked_block_names,
     viua::internals::types::bytecode_size block_bodies_size_so_far = 0) {
     viua::internals::types::bytecode_size block_ids_section_size = 0;
 
@@ -528,12 +542,24 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
         }
     }
 
-    // gather all linked function names
-    for (string lnk : links) {
-        Loader loader(lnk);
+    // load all linked modules at once, they do not depend on each other
+    vector<LinkedModule> linked_modules(links.size());
+    viua::util::parallel::for_each_index(links.size(), [&links, &linked_modules](size_t i) {
+        Loader loader(links[i]);
         loader.load();
 
-        vector<string> fn_names = loader.getFunctions();
+        auto& linked = linked_modules[i];
+        linked.function_names = loader.getFunctions();
+        linked.function_addresses = loader.getFunctionAddresses();
+        linked.jumps = loader.getJumps();
+        linked.size = loader.getBytecodeSize();
+        linked.bytecode = loader.getBytecode();
+    });
+
+    // gather all linked function names
+    for (decltype(links)::size_type i = 0; i < links.size(); ++i) {
+        const auto& lnk = links[i];
+        const auto& fn_names = linked_modules[i].function_names;
         for (string fn : fn_names) {
             if (function_addresses.count(fn)) {
                 throw("duplicate symbol '" + fn + "' found when linking '" + lnk +
@@ -541,7 +567,6 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
             }
         }
 
-        map<string, viua::internals::types::bytecode_size> fn_addresses = loader.getFunctionAddresses();
         for (string fn : fn_names) {
             function_addresses[fn] = 0;  // for now we just build a list of all available functions
             symbol_sources[fn] = lnk;
@@ -607,7 +632,9 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
 
 
     viua::internals::types::bytecode_size current_link_offset = bytes;
-    for (string lnk : links) {
+    for (decltype(links)::size_type link_index = 0; link_index < links.size(); ++link_index) {
+        const auto& lnk = links[link_index];
+        auto& linked = linked_modules[link_index];
         if (DEBUG or VERBOSE) {
             cout << send_control_seq(COLOR_FG_WHITE) << filename << send_control_seq(ATTR_RESET);
             cout << ": ";
@@ -618,26 +645,23 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
             cout << "'" << endl;
         }
 
-        Loader loader(lnk);
-        loader.load();
+        const auto& fn_names = linked.function_names;
 
-        vector<string> fn_names = loader.getFunctions();
-
-        vector<viua::internals::types::bytecode_size> lib_jumps = loader.getJumps();
+        const auto& lib_jumps = linked.jumps;
         if (DEBUG) {
             cout << send_control_seq(COLOR_FG_WHITE) << filename << send_control_seq(ATTR_RESET);
             cout << ": ";
             cout << send_control_seq(COLOR_FG_YELLOW) << "debug" << send_control_seq(ATTR_RESET);
             cout << ": ";
             cout << "[loader] entries in jump table: " << lib_jumps.size() << endl;
-            for (decltype(lib_jumps)::size_type i = 0; i < lib_jumps.size(); ++i) {
+            for (decltype(linked.jumps)::size_type i = 0; i < lib_jumps.size(); ++i) {
                 cout << "  jump at byte: " << lib_jumps[i] << endl;
             }
         }
 
         linked_libs_jumptables[lnk] = lib_jumps;
 
-        map<string, viua::internals::types::bytecode_size> fn_addresses = loader.getFunctionAddresses();
+        const auto& fn_addresses = linked.function_addresses;
         for (string fn : fn_names) {
             function_addresses[fn] = fn_addresses.at(fn) + current_link_offset;
             if (DEBUG) {
@@ -652,8 +676,8 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
             }
         }
 
-        linked_libs_bytecode.emplace_back(lnk, loader.getBytecodeSize(), loader.getBytecode());
-        bytes += loader.getBytecodeSize();
+        linked_libs_bytecode.emplace_back(lnk, linked.size, std::move(linked.bytecode));
+        bytes += linked.size;
     }
 
 
@@ -940,16 +964,28 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
     }
 
 
+    /*
+     * Names sections are first written to buffers, and only then to the output file
+     * because the symbol index (written after the bytecode) is built from them.
+     * Each buffer begins with the size of the section.
+     */
+    ostringstream external_functions_section;
+    ostringstream external_blocks_section;
+    ostringstream blocks_section;
+    ostringstream functions_section;
+
+
     /////////////////////////////////////////////////////////////
     // WRITE EXTERNAL FUNCTION SIGNATURES
     viua::internals::types::bytecode_size signatures_section_size = 0;
     for (const auto each : functions.signatures) {
         signatures_section_size += (each.size() + 1);  // +1 for null byte after each signature
     }
-    bwrite(out, signatures_section_size);
+    bwrite(external_functions_section, signatures_section_size);
     for (const auto each : functions.signatures) {
-        strwrite(out, each);
+        strwrite(external_functions_section, each);
     }
+    out << external_functions_section.str();
 
 
     /////////////////////////////////////////////////////////////
@@ -958,23 +994,26 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
     for (const auto each : blocks.signatures) {
         signatures_section_size += (each.size() + 1);  // +1 for null byte after each signature
     }
-    bwrite(out, signatures_section_size);
+    bwrite(external_blocks_section, signatures_section_size);
     for (const auto each : blocks.signatures) {
-        strwrite(out, each);
+        strwrite(external_blocks_section, each);
     }
+    out << external_blocks_section.str();
 
 
     /////////////////////////////////////////////////////////////
     // WRITE BLOCK AND FUNCTION ENTRY POINT ADDRESSES TO BYTECODE
     viua::internals::types::bytecode_size functions_size_so_far =
-        writeCodeBlocksSection(out, blocks, linked_block_names);
-    writeCodeBlocksSection(out, functions, linked_function_names, functions_size_so_far);
+        writeCodeBlocksSection(blocks_section, blocks, linked_block_names);
+    writeCodeBlocksSection(functions_section, functions, linked_function_names, functions_size_so_far);
     for (string name : linked_function_names) {
-        strwrite(out, name);
+        strwrite(functions_section, name);
         // mapped address must come after name
         viua::internals::types::bytecode_size address = function_addresses[name];
-        bwrite(out, address);
+        bwrite(functions_section, address);
     }
+    out << blocks_section.str();
+    out << functions_section.str();
 
 
     //////////////////////
@@ -1087,5 +1126,21 @@ void generate(vector<Token> const& tokens, invocables_t& functions, invocables_t
     }
 
     out.write(reinterpret_cast<const char*>(program_bytecode.get()), static_cast<std::streamsize>(bytes));
+
+
+    /////////////////////////////////////////////////////////////
+    // WRITE SYMBOL INDEX
+    if (flags.symbol_index) {
+        out.write(VIUA_SYMBOL_INDEX_MAGIC, static_cast<std::streamsize>(strlen(VIUA_SYMBOL_INDEX_MAGIC) + 1));
+        for (const auto& each : {std::make_pair(functions_section.str(), true),
+                                 std::make_pair(blocks_section.str(), true),
+                                 std::make_pair(external_functions_section.str(), false),
+                                 std::make_pair(external_blocks_section.str(), false)}) {
+            const auto names = each.first.c_str() + sizeof(viua::internals::types::bytecode_size);
+            const auto names_size = each.first.size() - sizeof(viua::internals::types::bytecode_size);
+            out << viua::bytecode::symbol_index::build(names, names_size, each.second);
+        }
+    }
+
     out.close();
 }
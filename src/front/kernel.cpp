@@ -51,8 +51,13 @@ static bool usage(const string program, const vector<string>& args) {
     bool verbose = false;
     bool show_info = false;
     bool show_json = false;
+    bool skip_value = false;
 
     for (auto option : args) {
+        if (skip_value) {
+            skip_value = false;
+            continue;
+        }
         if (option == "--help" or option == "-h") {
             show_help = true;
             continue;
@@ -67,6 +72,11 @@ static bool usage(const string program, const vector<string>& args) {
             continue;
         } else if (option == "--json") {
             show_json = true;
+        } else if (option == "--image") {
+            continue;
+        } else if (option == "--dump-image") {
+            skip_value = true;
+            continue;
         } else if (str::startswith(option, "-")) {
             cerr << send_control_seq(COLOR_FG_RED) << "error" << send_control_seq(ATTR_RESET);
             cerr << ": unknown option: ";
@@ -103,7 +113,8 @@ static bool usage(const string program, const vector<string>& args) {
     }
     if (show_help) {
         cout << "\nUSAGE:\n";
-        cout << "    " << program << " [option...] <executable>\n" << endl;
+        cout << "    " << program << " [option...] <executable>\n";
+        cout << "    " << program << " [option...] --image <image>\n" << endl;
         cout << "OPTIONS:\n";
         cout << "    "
              << "-V, --version            - show version\n"
@@ -115,7 +126,12 @@ static bool usage(const string program, const vector<string>& args) {
              << "-i, --info               - show information about VM configuration (number of schedulers, "
                 "version etc.)\n"
              << "    "
-             << "    --json               - same as --info but in JSON format\n";
+             << "    --json               - same as --info but in JSON format\n"
+             << "    "
+             << "    --image              - run a kernel image instead of an executable\n"
+             << "    "
+             << "    --dump-image <path>  - link the executable and preloaded modules, write kernel image to "
+                "<path> and exit\n";
     }
 
     return (show_help or show_version or show_info);
@@ -132,6 +148,20 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    bool from_image = false;
+    string dump_image_path;
+    while (args.size()) {
+        if (args[0] == "--image") {
+            from_image = true;
+            args.erase(args.begin());
+        } else if (args[0] == "--dump-image" and args.size() > 1) {
+            dump_image_path = args[1];
+            args.erase(args.begin(), args.begin() + 2);
+        } else {
+            break;
+        }
+    }
+
     if (args.size() == 0) {
         cout << "fatal: no input file" << endl;
         return 1;
@@ -149,10 +179,24 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    try {
+        // values allocated before accounting is turned on could not be credited when freed
+        if (viua::kernel::Kernel::process_memory_limit() or viua::kernel::Kernel::is_telemetry_enabled()) {
+            viua::types::account_memory();
+        }
+    } catch (const string& e) {
+        cout << "fatal: " << e << endl;
+        return 1;
+    }
+
     viua::kernel::Kernel kernel;
 
     try {
-        viua::front::vm::initialise(&kernel, filename, args);
+        if (from_image) {
+            viua::front::vm::initialise_from_image(&kernel, filename, args, string(VERSION) + '.' + MICRO);
+        } else {
+            viua::front::vm::initialise(&kernel, filename, args);
+        }
     } catch (const char* e) {
         cout << "error: " << e << endl;
         return 1;
@@ -167,12 +211,30 @@ int main(int argc, char* argv[]) {
     } catch (const viua::types::Exception* e) {
         cout << "fatal: preload: " << e->what() << endl;
         return 1;
+    } catch (const unique_ptr<viua::types::Exception>& e) {
+        cout << "fatal: preload: " << e->what() << endl;
+        return 1;
+    }
+
+    if (dump_image_path.size()) {
+        try {
+            kernel.save_image(dump_image_path, string(VERSION) + '.' + MICRO);
+        } catch (const string& e) {
+            cout << "error: " << e << endl;
+            return 1;
+        }
+        return 0;
     }
 
     viua::front::vm::load_standard_prototypes(&kernel);
+    viua::front::vm::load_standard_functions(&kernel);
 
     try {
         kernel.run();
+    } catch (const string& e) {
+        // invalid configuration is reported before any process is started
+        cout << "fatal: " << e << endl;
+        return 1;
     } catch (const viua::types::Exception* e) {
         cout << "VM error: an irrecoverable VM exception occured: " << e->what() << endl;
         return 1;
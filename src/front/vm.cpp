@@ -19,6 +19,13 @@
 
 #include <memory>
 #include <viua/front/vm.h>
+#include <viua/kernel/frame.h>
+#include <viua/process.h>
+#include <viua/types/exception.h>
+#include <viua/types/integer.h>
+#include <viua/types/string.h>
+#include <viua/types/struct.h>
+#include <viua/types/vector.h>
 using namespace std;
 
 
@@ -27,19 +34,29 @@ void viua::front::vm::initialise(viua::kernel::Kernel* kernel, const string& pro
     loader.executable();
 
     uint64_t bytes = loader.getBytecodeSize();
-    unique_ptr<viua::internals::types::byte[]> bytecode = loader.getBytecode();
+    shared_ptr<viua::internals::types::byte[]> bytecode = loader.mapBytecode();
 
-    map<string, uint64_t> function_address_mapping = loader.getFunctionAddresses();
-    for (auto p : function_address_mapping) {
-        kernel->mapfunction(p.first, p.second);
-    }
-    for (auto p : loader.getBlockAddresses()) {
-        kernel->mapblock(p.first, p.second);
+    if (loader.hasSymbolIndex()) {
+        kernel->mapsymbols(loader.getSymbolIndex());
+    } else {
+        map<string, uint64_t> function_address_mapping = loader.getFunctionAddresses();
+        for (auto p : function_address_mapping) {
+            kernel->mapfunction(p.first, p.second);
+        }
+        for (auto p : loader.getBlockAddresses()) {
+            kernel->mapblock(p.first, p.second);
+        }
     }
 
     kernel->commandline_arguments = args;
 
-    kernel->load(std::move(bytecode)).bytes(bytes);
+    kernel->load(std::move(bytecode)).bytes(bytes).verify();
+}
+
+void viua::front::vm::initialise_from_image(viua::kernel::Kernel* kernel, const string& image,
+                                           vector<string> args, const string& vm_version) {
+    kernel->load_image(image, vm_version);
+    kernel->commandline_arguments = args;
 }
 
 void viua::front::vm::load_standard_prototypes(viua::kernel::Kernel* kernel) {
@@ -88,16 +105,108 @@ void viua::front::vm::load_standard_prototypes(viua::kernel::Kernel* kernel) {
                                   static_cast<ForeignMethodMemberPointer>(&viua::types::Pointer::expired));
 }
 
-void viua::front::vm::preload_libraries(viua::kernel::Kernel* kernel) {
-    /** This method preloads dynamic libraries specified by environment.
+static void process_memory_usage(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
+                                 viua::process::Process* process, viua::kernel::Kernel*) {
+    auto usage = static_cast<viua::types::Integer::underlying_type>(process->memory_usage());
+    frame->local_register_set->set(0, make_unique<viua::types::Integer>(usage));
+}
+
+static void process_hibernate(Frame*, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
+                              viua::process::Process* process, viua::kernel::Kernel*) {
+    process->request_hibernation();
+}
+
+static void process_message_latency(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
+                                    viua::process::Process* process, viua::kernel::Kernel*) {
+    /*  Returns a struct describing how long messages received by the calling process
+     *  were queued (all zeroes unless message timestamps are enabled).
+     */
+    auto const relaxed = std::memory_order_relaxed;
+    auto as_integer = [](const uint64_t n) {
+        return make_unique<viua::types::Integer>(static_cast<viua::types::Integer::underlying_type>(n));
+    };
+
+    auto const& histogram = process->message_latency_histogram();
+    auto latency = make_unique<viua::types::Struct>();
+    latency->insert("count", as_integer(histogram.count.load(relaxed)));
+    latency->insert("total_ns", as_integer(histogram.sum_ns.load(relaxed)));
+    latency->insert("max_ns", as_integer(histogram.max_ns.load(relaxed)));
+    frame->local_register_set->set(0, std::move(latency));
+}
+
+static void process_deepest_mailboxes(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
+                                      viua::process::Process*, viua::kernel::Kernel* kernel) {
+    /*  Returns a vector of at most N structs describing the deepest mailboxes,
+     *  deepest first.
      */
-    vector<string> preload_native = support::env::getpaths("VIUAPRELINK");
-    for (unsigned i = 0; i < preload_native.size(); ++i) {
-        kernel->loadNativeLibrary(preload_native[i]);
+    auto const requested = dynamic_cast<viua::types::Integer*>(frame->arguments->at(0));
+    if (requested == nullptr) {
+        throw make_unique<viua::types::Exception>("expected number of mailboxes (integer) as parameter 0");
     }
+    auto const limit = requested->value();
+    auto as_integer = [](const uint64_t n) {
+        return make_unique<viua::types::Integer>(static_cast<viua::types::Integer::underlying_type>(n));
+    };
 
-    vector<string> preload_foreign = support::env::getpaths("VIUAPREIMPORT");
-    for (unsigned i = 0; i < preload_foreign.size(); ++i) {
-        kernel->loadForeignLibrary(preload_foreign[i]);
+    auto mailboxes = make_unique<viua::types::Vector>();
+    auto listed = decltype(limit){0};
+    for (const auto& each : kernel->mailbox_depths()) {
+        if (listed++ >= limit) {
+            break;
+        }
+        auto mailbox = make_unique<viua::types::Struct>();
+        mailbox->insert("pid", make_unique<viua::types::String>(each.pid.str()));
+        mailbox->insert("depth", as_integer(each.depth));
+        mailbox->insert("high_water_mark", as_integer(each.high_water_mark));
+        mailboxes->push(std::move(mailbox));
     }
+    frame->local_register_set->set(0, std::move(mailboxes));
+}
+
+static void scheduler_statistics(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
+                                 viua::process::Process*, viua::kernel::Kernel* kernel) {
+    /*  Returns a vector with a struct of telemetry counters for each VP scheduler.
+     */
+    auto const relaxed = std::memory_order_relaxed;
+    auto as_integer = [](const uint64_t n) {
+        return make_unique<viua::types::Integer>(static_cast<viua::types::Integer::underlying_type>(n));
+    };
+
+    auto statistics = make_unique<viua::types::Vector>();
+    for (const auto each : kernel->telemetry()) {
+        auto s = make_unique<viua::types::Struct>();
+        s->insert("bursts", as_integer(each->bursts.load(relaxed)));
+        s->insert("quants", as_integer(each->quants.load(relaxed)));
+        s->insert("ticks", as_integer(each->ticks.load(relaxed)));
+        s->insert("busy_ns", as_integer(each->busy_ns.load(relaxed)));
+        s->insert("idle_ns", as_integer(each->idle_ns.load(relaxed)));
+        s->insert("spawned", as_integer(each->spawned.load(relaxed)));
+        s->insert("posted", as_integer(each->posted.load(relaxed)));
+        s->insert("grabbed", as_integer(each->grabbed.load(relaxed)));
+        s->insert("ffi_calls", as_integer(each->ffi_calls.load(relaxed)));
+        s->insert("run_queue", as_integer(each->run_queue.load(relaxed)));
+        s->insert("load", as_integer(each->load.load(relaxed)));
+        s->insert("process_memory", as_integer(each->process_memory.load(relaxed)));
+        statistics->push(std::move(s));
+    }
+    frame->local_register_set->set(0, std::move(statistics));
+}
+
+void viua::front::vm::load_standard_functions(viua::kernel::Kernel* kernel) {
+    kernel->registerExternalFunction("std::process::memory_usage/0", &process_memory_usage);
+    kernel->registerExternalFunction("std::process::hibernate/0", &process_hibernate);
+    kernel->registerExternalFunction("std::process::message_latency/0", &process_message_latency);
+    kernel->registerExternalFunction("std::process::deepest_mailboxes/1", &process_deepest_mailboxes);
+    kernel->registerExternalFunction("std::scheduler::statistics/0", &scheduler_statistics);
+}
+
+void viua::front::vm::preload_libraries(viua::kernel::Kernel* kernel) {
+    /** This method preloads dynamic libraries specified by environment.
+     *  Modules from each list are loaded as one batch so that they are read and
+     *  verified in parallel.
+     *  Names in VIUAPRELINK are looked up only as native modules, and names in
+     *  VIUAPREIMPORT only as foreign ones.
+     */
+    kernel->loadModules(support::env::getpaths("VIUAPRELINK"), viua::kernel::ModuleLookup::NATIVE);
+    kernel->loadModules(support::env::getpaths("VIUAPREIMPORT"), viua::kernel::ModuleLookup::FOREIGN);
 }
@@ -26,13 +26,34 @@ void Frame::setLocalRegisterSet(viua::kernel::RegisterSet* rs, bool receives_own
     local_register_set.reset(rs, receives_ownership);
 }
 
+std::size_t Frame::memory_footprint() const {
+    auto footprint = (sizeof(Frame) + viua::util::memory::heap_size(function_name));
+    footprint += (arguments ? arguments->memory_footprint() : 0);
+    if (local_register_set.owns() and local_register_set.get()) {
+        footprint += local_register_set.get()->memory_footprint();
+    }
+    footprint += deferred_calls.capacity() * sizeof(decltype(deferred_calls)::value_type);
+    for (const auto& each : deferred_calls) {
+        footprint += each->memory_footprint();
+    }
+    return footprint;
+}
+
 Frame::Frame(viua::internals::types::byte* ra, viua::internals::types::register_index argsize,
              viua::internals::types::register_index regsize)
-    : return_address(ra), arguments(nullptr), local_register_set(nullptr), return_register(nullptr) {
+    : return_address(ra),
+      arguments(nullptr),
+      local_register_set(nullptr),
+      return_register(nullptr),
+      entered_running_at(0),
+      entered_wall_at(0),
+      callees_running_time(0),
+      profiled(false) {
     arguments = make_unique<viua::kernel::RegisterSet>(argsize);
     local_register_set = make_unique<viua::kernel::RegisterSet>(regsize);
 }
-Frame::Frame(const Frame& that) {
+Frame::Frame(const Frame& that)
+    : entered_running_at(0), entered_wall_at(0), callees_running_time(0), profiled(false) {
     return_address = that.return_address;
 
     // FIXME: copy the registers maybe?
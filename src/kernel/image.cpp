@@ -0,0 +1,364 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include <viua/bytecode/maps.h>
+#include <viua/bytecode/symbol_index.h>
+#include <viua/bytecode/verifier.h>
+#include <viua/kernel/kernel.h>
+#include <viua/machine.h>
+#include <viua/support/string.h>
+#include <viua/types/exception.h>
+#include <viua/util/memory.h>
+#include <viua/util/parallel.h>
+using namespace std;
+
+using viua::util::memory::aligned_read;
+
+
+/*  Layout of an image:
+ *
+ *      VIUA_IMAGE_MAGIC (with the terminating NUL)
+ *      format version
+ *      version of the VM that wrote the image (NUL-terminated)
+ *      hash of the opcode set (numbers and names of all opcodes)
+ *      checksum of the payload (see viua::bytecode::symbol_index::hash())
+ *      payload:
+ *          unit for the executable (with an empty name)
+ *          number of linked modules
+ *          unit for each linked module
+ *          number of foreign libraries
+ *          name and path of each foreign library
+ *
+ *  A unit is the name of the module, size of its bytecode followed by the bytecode,
+ *  and a list of its functions and a list of its blocks (each being a number of entries
+ *  followed by NUL-terminated names and addresses).
+ *  All numbers are 64 bit words.
+ *
+ *  Images written by a different version of the VM, or for a different set of
+ *  opcodes, are rejected before their payload is read.
+ *
+ *  The checksum only detects corrupted files. It is computed one byte at a
+ *  time (FNV-1a) so checking it costs one multiplication per byte of the image,
+ *  on a single thread, before anything else in the payload is read.
+ *  Bytecode of every unit is verified
+ *  when an image is loaded (which also finds its atom literals) so that code from
+ *  an image runs without runtime checks just like freshly linked code.
+ */
+namespace {
+    const uint64_t IMAGE_FORMAT_VERSION = 3;
+
+    using viua::internals::types::byte;
+    using viua::internals::types::bytecode_size;
+
+    struct Unit {
+        string name;
+        bytecode_size size;
+        byte* code;
+        map<string, bytecode_size> functions;
+        map<string, bytecode_size> blocks;
+    };
+
+    auto write_size(ostream& out, const uint64_t value) -> void {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    auto write_string(ostream& out, const string& value) -> void {
+        out.write(value.c_str(), static_cast<streamsize>(value.size() + 1));
+    }
+    auto write_symbols(ostream& out, const map<string, bytecode_size>& symbols) -> void {
+        write_size(out, symbols.size());
+        for (const auto& each : symbols) {
+            write_string(out, each.first);
+            write_size(out, each.second);
+        }
+    }
+    auto write_unit(ostream& out, const Unit& unit) -> void {
+        write_string(out, unit.name);
+        write_size(out, unit.size);
+        out.write(reinterpret_cast<const char*>(unit.code), static_cast<streamsize>(unit.size));
+        write_symbols(out, unit.functions);
+        write_symbols(out, unit.blocks);
+    }
+
+    auto opcode_set_hash() -> uint64_t {
+        ostringstream oss;
+        for (const auto& each : OP_NAMES) {
+            oss << static_cast<unsigned>(each.first) << ' ' << each.second << '\n';
+        }
+        const auto opcodes = oss.str();
+        return viua::bytecode::symbol_index::hash(opcodes.c_str(), opcodes.size());
+    }
+
+    class ImageReader {
+        const string& path;
+        byte* image;
+        size_t image_size;
+        size_t cursor;
+
+      public:
+        auto take(const size_t n) -> byte* {
+            if (n > (image_size - cursor)) {
+                throw("truncated image: " + path);
+            }
+            auto taken = (image + cursor);
+            cursor += n;
+            return taken;
+        }
+        auto take_size() -> uint64_t {
+            uint64_t value = 0;
+            aligned_read(value) = take(sizeof(value));
+            return value;
+        }
+        auto take_string() -> string {
+            auto start = reinterpret_cast<const char*>(image + cursor);
+            auto length = strnlen(start, image_size - cursor);
+            take(length + 1);
+            return string(start, length);
+        }
+        auto take_symbols(const bytecode_size code_size) -> map<string, bytecode_size> {
+            map<string, bytecode_size> symbols;
+            for (auto n = take_size(); n; --n) {
+                auto name = take_string();
+                auto address = take_size();
+                if (address >= code_size) {
+                    throw("invalid image: " + path + ": address of " + name + " out of range");
+                }
+                symbols[name] = address;
+            }
+            return symbols;
+        }
+        auto take_unit() -> Unit {
+            Unit unit;
+            unit.name = take_string();
+            unit.size = take_size();
+            unit.code = take(unit.size);
+            unit.functions = take_symbols(unit.size);
+            unit.blocks = take_symbols(unit.size);
+            return unit;
+        }
+
+        auto remaining() const -> size_t { return (image_size - cursor); }
+        auto position() const -> byte* { return (image + cursor); }
+
+        ImageReader(const string& p, byte* i, const size_t s) : path(p), image(i), image_size(s), cursor(0) {}
+    };
+
+    auto map_image(const string& path, size_t& image_size) -> shared_ptr<byte[]> {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw("could not open image: " + path);
+        }
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == -1 or not S_ISREG(file_stat.st_mode) or file_stat.st_size == 0) {
+            close(fd);
+            throw("could not map image: " + path);
+        }
+        image_size = static_cast<size_t>(file_stat.st_size);
+
+        void* mapped = mmap(nullptr, image_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            throw("could not map image: " + path);
+        }
+
+        auto mapped_size = image_size;
+        return shared_ptr<byte[]>(static_cast<byte*>(mapped),
+                                  [mapped_size](byte* p) { munmap(p, mapped_size); });
+    }
+}
+
+
+auto viua::kernel::Kernel::save_image(const string& path, const string& vm_version) -> void {
+    /*  Modules imported lazily are linked before the image is written; an image
+     *  always contains fully linked code.
+     *  An executable that was not verified is verified here so that an image that
+     *  would be rejected when loaded is not written at all.
+     */
+    for (const auto& each : linked.load()->pending_modules) {
+        link_pending_module(each.first);
+    }
+    if (not bytecode_verified) {
+        verify();
+    }
+
+    unique_lock<mutex> lck{linking_mutex};
+    auto symbols = linked.load();
+
+    Unit executable;
+    executable.size = bytecode_size;
+    executable.code = bytecode.get();
+    executable.functions = function_addresses;
+    executable.blocks = block_addresses;
+    for (const auto& each : symbol_index.functions.entries()) {
+        executable.functions.insert(each);
+    }
+    for (const auto& each : symbol_index.blocks.entries()) {
+        executable.blocks.insert(each);
+    }
+
+    ostringstream payload;
+    write_unit(payload, executable);
+
+    write_size(payload, symbols->modules.size());
+    for (const auto& each : symbols->modules) {
+        Unit module;
+        module.name = each.first;
+        module.size = each.second.first;
+        module.code = each.second.second.get();
+        symbols->functions.for_each([&module](const auto& fn) {
+            if (fn.second.first == module.name) {
+                module.functions[fn.first] =
+                    static_cast<viua::internals::types::bytecode_size>(fn.second.second - module.code);
+            }
+        });
+        symbols->blocks.for_each([&module](const auto& bl) {
+            if (bl.second.first == module.name) {
+                module.blocks[bl.first] =
+                    static_cast<viua::internals::types::bytecode_size>(bl.second.second - module.code);
+            }
+        });
+        write_unit(payload, module);
+    }
+
+    write_size(payload, linked_foreign_modules.size());
+    for (const auto& each : linked_foreign_modules) {
+        write_string(payload, each.first);
+        write_string(payload, each.second);
+    }
+
+    const auto contents = payload.str();
+    ofstream out(path, ios::out | ios::binary | ios::trunc);
+    out.write(VIUA_IMAGE_MAGIC, static_cast<streamsize>(strlen(VIUA_IMAGE_MAGIC) + 1));
+    write_size(out, IMAGE_FORMAT_VERSION);
+    write_string(out, vm_version);
+    write_size(out, opcode_set_hash());
+    write_size(out, viua::bytecode::symbol_index::hash(contents.c_str(), contents.size()));
+    out.write(contents.c_str(), static_cast<streamsize>(contents.size()));
+    out.close();
+    if (not out) {
+        throw("could not write image: " + path);
+    }
+}
+
+auto viua::kernel::Kernel::load_image(const string& path, const string& vm_version) -> void {
+    size_t image_size = 0;
+    auto image = map_image(path, image_size);
+    ImageReader reader{path, image.get(), image_size};
+
+    const auto magic_size = strlen(VIUA_IMAGE_MAGIC) + 1;
+    if (memcmp(reader.take(magic_size), VIUA_IMAGE_MAGIC, magic_size) != 0) {
+        throw("not an image: " + path);
+    }
+    if (reader.take_size() != IMAGE_FORMAT_VERSION) {
+        throw("unsupported image format version: " + path);
+    }
+    if (auto written_by = reader.take_string(); written_by != vm_version) {
+        throw("image written by a different version of the VM (" + written_by + "): " + path);
+    }
+    if (reader.take_size() != opcode_set_hash()) {
+        throw("image written for a different set of opcodes: " + path);
+    }
+    const auto checksum = reader.take_size();
+    if (viua::bytecode::symbol_index::hash(reinterpret_cast<const char*>(reader.position()),
+                                           reader.remaining()) != checksum) {
+        throw("corrupted image: " + path);
+    }
+
+    auto executable = reader.take_unit();
+    vector<Unit> modules;
+    for (auto n = reader.take_size(); n; --n) {
+        modules.push_back(reader.take_unit());
+    }
+    vector<pair<string, string>> foreign_modules;
+    for (auto n = reader.take_size(); n; --n) {
+        auto name = reader.take_string();
+        foreign_modules.emplace_back(name, reader.take_string());
+    }
+
+    /*  Units are verified in parallel, like modules that are linked from files.
+     *  The executable is the unit at index 0.
+     */
+    vector<AtomLiteralSegment> resolved(modules.size() + 1);
+    viua::util::parallel::for_each_index(resolved.size(), [&](size_t i) {
+        const auto& unit = (i ? modules[i - 1] : executable);
+        vector<viua::internals::types::bytecode_size> entry_points;
+        for (const auto& each : unit.functions) {
+            entry_points.push_back(each.second);
+        }
+        for (const auto& each : unit.blocks) {
+            entry_points.push_back(each.second);
+        }
+        try {
+            auto literals = viua::bytecode::verifier::verify(unit.code, unit.size, std::move(entry_points));
+            auto interned =
+                make_shared<const AtomLiterals>(intern_atom_literals(unit.code, unit.size, literals));
+            resolved[i] = {unit.code, (unit.code + unit.size), std::move(interned)};
+        } catch (const string& e) {
+            throw("invalid image: " + path + ": " + (i ? unit.name : string("executable")) + ": " + e);
+        }
+    });
+
+    /*  Bytecode is not copied out of the image; each module keeps the whole
+     *  mapping alive.
+     */
+    load(shared_ptr<viua::internals::types::byte[]>(image, executable.code)).bytes(executable.size);
+    for (const auto& each : executable.functions) {
+        mapfunction(each.first, each.second);
+    }
+    for (const auto& each : executable.blocks) {
+        mapblock(each.first, each.second);
+    }
+    bytecode_verified = true;
+    publish_atom_literals(std::move(resolved));
+
+    unique_lock<mutex> lck{linking_mutex};
+    linked.update([&image, &modules](LinkedSymbols& symbols) {
+        for (const auto& module : modules) {
+            for (const auto& each : module.functions) {
+                symbols.functions.insert_or_assign(each.first,
+                                                   make_pair(module.name, (module.code + each.second)));
+            }
+            for (const auto& each : module.blocks) {
+                symbols.blocks.insert_or_assign(each.first,
+                                                make_pair(module.name, (module.code + each.second)));
+            }
+            symbols.modules[module.name] =
+                make_pair(module.size, shared_ptr<viua::internals::types::byte[]>(image, module.code));
+        }
+    });
+
+    for (const auto& each : foreign_modules) {
+        try {
+            loadForeignLibrary(each.first, each.second);
+        } catch (const unique_ptr<viua::types::Exception>& e) {
+            throw("could not load foreign library from image: " + path + ": " + e->what());
+        }
+    }
+}
@@ -18,16 +18,24 @@
  */
 
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <dlfcn.h>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
-#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <vector>
 #include <viua/bytecode/bytetypedef.h>
 #include <viua/bytecode/maps.h>
 #include <viua/bytecode/opcodes.h>
+#include <viua/bytecode/verifier.h>
 #include <viua/include/module.h>
 #include <viua/kernel/kernel.h>
 #include <viua/loader.h>
@@ -45,22 +53,36 @@
 #include <viua/types/string.h>
 #include <viua/types/value.h>
 #include <viua/types/vector.h>
+#include <viua/util/parallel.h>
 using namespace std;
 
 
-viua::kernel::Mailbox::Mailbox(Mailbox&& that) : messages(std::move(that.messages)) {}
+viua::kernel::Mailbox::Mailbox() : most_messages(0) {}
+viua::kernel::Mailbox::Mailbox(Mailbox&& that)
+    : messages(std::move(that.messages)),
+      sent_at(std::move(that.sent_at)),
+      most_messages(that.most_messages) {}
 
-auto viua::kernel::Mailbox::send(unique_ptr<viua::types::Value> message) -> void {
+auto viua::kernel::Mailbox::send(unique_ptr<viua::types::Value> message, const bool timestamp) -> void {
     unique_lock<mutex> lck{mailbox_mutex};
     messages.push_back(std::move(message));
+    if (timestamp) {
+        sent_at.push_back(std::chrono::steady_clock::now());
+    }
+    most_messages = std::max(most_messages, messages.size());
 }
 
-auto viua::kernel::Mailbox::receive(queue<unique_ptr<viua::types::Value>>& mq) -> void {
+auto viua::kernel::Mailbox::receive(queue<unique_ptr<viua::types::Value>>& mq,
+                                    queue<std::chrono::steady_clock::time_point>& timestamps) -> void {
     unique_lock<mutex> lck{mailbox_mutex};
     for (auto& message : messages) {
         mq.push(std::move(message));
     }
     messages.clear();
+    for (const auto each : sent_at) {
+        timestamps.push(each);
+    }
+    sent_at.clear();
 }
 
 auto viua::kernel::Mailbox::size() const -> decltype(messages)::size_type {
@@ -68,6 +90,11 @@ auto viua::kernel::Mailbox::size() const -> decltype(messages)::size_type {
     return messages.size();
 }
 
+auto viua::kernel::Mailbox::high_water_mark() const -> decltype(messages)::size_type {
+    unique_lock<mutex> lck{mailbox_mutex};
+    return most_messages;
+}
+
 
 viua::kernel::ProcessResult::ProcessResult(ProcessResult&& that) {
     value_returned = std::move(that.value_returned);
@@ -102,7 +129,7 @@ auto viua::kernel::ProcessResult::transfer_result() -> unique_ptr<viua::types::V
 }
 
 
-viua::kernel::Kernel& viua::kernel::Kernel::load(unique_ptr<viua::internals::types::byte[]> bc) {
+viua::kernel::Kernel& viua::kernel::Kernel::load(shared_ptr<viua::internals::types::byte[]> bc) {
     /*  Load bytecode into the viua::kernel::Kernel.
      *  viua::kernel::Kernel becomes owner of loaded bytecode - meaning it will consider itself responsible
      * for proper
@@ -112,6 +139,7 @@ viua::kernel::Kernel& viua::kernel::Kernel::load(unique_ptr<viua::internals::typ
      *  To free bytecode without loading anything new it is possible to call .load(nullptr).
      */
     bytecode = std::move(bc);
+    bytecode_verified = false;
     return (*this);
 }
 
@@ -140,12 +168,51 @@ viua::kernel::Kernel& viua::kernel::Kernel::mapblock(const string& name,
     return (*this);
 }
 
+viua::kernel::Kernel& viua::kernel::Kernel::mapsymbols(const viua::bytecode::symbol_index::Index& index) {
+    /** Uses symbol index of loaded bytecode to find functions and blocks.
+     *  The index must point into the bytecode loaded into the kernel.
+     */
+    symbol_index = index;
+    return (*this);
+}
+
+viua::kernel::Kernel& viua::kernel::Kernel::verify() {
+    vector<viua::internals::types::bytecode_size> entry_points;
+    for (const auto& each : function_addresses) {
+        entry_points.push_back(each.second);
+    }
+    for (const auto& each : block_addresses) {
+        entry_points.push_back(each.second);
+    }
+    for (const auto each : symbol_index.functions.values()) {
+        entry_points.push_back(each);
+    }
+    for (const auto each : symbol_index.blocks.values()) {
+        entry_points.push_back(each);
+    }
+
+    vector<viua::internals::types::bytecode_size> literals;
+    try {
+        literals = viua::bytecode::verifier::verify(bytecode.get(), bytecode_size, std::move(entry_points));
+    } catch (const string& e) { throw("bytecode verification failed: " + e); }
+
+    auto base = bytecode.get();
+    auto interned = make_shared<const AtomLiterals>(intern_atom_literals(base, bytecode_size, literals));
+    publish_atom_literals({{base, (base + bytecode_size), std::move(interned)}});
+    bytecode_verified = true;
+    return (*this);
+}
+
+auto viua::kernel::Kernel::is_verified_code(const viua::internals::types::byte* module_base) const -> bool {
+    return (module_base != bytecode.get() or bytecode_verified);
+}
+
 viua::kernel::Kernel& viua::kernel::Kernel::registerExternalFunction(const string& name,
                                                                      ForeignFunction* function_ptr) {
     /** Registers external function in viua::kernel::Kernel.
      */
-    unique_lock<mutex> lock(foreign_functions_mutex);
-    foreign_functions[name] = function_ptr;
+    foreign_functions.update(
+        [&name, function_ptr](auto& functions) { functions.insert_or_assign(name, function_ptr); });
     return (*this);
 }
 
@@ -165,96 +232,310 @@ viua::kernel::Kernel& viua::kernel::Kernel::registerForeignMethod(const string&
 }
 
 
-static auto is_native_module(string module) -> bool {
-    regex double_colon("::");
-    ostringstream oss;
-    oss << regex_replace(module, double_colon, "/");
-    string try_path = oss.str();
-    string path = support::env::viua::getmodpath(try_path, "vlib", support::env::getpaths("VIUAPATH"));
+static auto find_module(const string& module, const string& extension) -> string {
+    string path = support::env::viua::getmodpath(module, extension, support::env::getpaths("VIUAPATH"));
     if (path.size() == 0) {
-        path = support::env::viua::getmodpath(try_path, "vlib", VIUAPATH);
+        path = support::env::viua::getmodpath(module, extension, VIUAPATH);
     }
     if (path.size() == 0) {
-        path = support::env::viua::getmodpath(try_path, "vlib", support::env::getpaths("VIUAAFTERPATH"));
+        path = support::env::viua::getmodpath(module, extension, support::env::getpaths("VIUAAFTERPATH"));
     }
-    return (path.size() > 0);
+    return path;
 }
-static auto is_foreign_module(string module) -> bool {
-    string path = "";
-    path = support::env::viua::getmodpath(module, "so", support::env::getpaths("VIUAPATH"));
-    if (path.size() == 0) {
-        path = support::env::viua::getmodpath(module, "so", VIUAPATH);
-    }
-    if (path.size() == 0) {
-        path = support::env::viua::getmodpath(module, "so", support::env::getpaths("VIUAAFTERPATH"));
+static auto native_module_path(const string& module) -> string {
+    // native modules are nested in directories, foo::bar is found at foo/bar.vlib
+    string try_path;
+    try_path.reserve(module.size());
+    for (string::size_type i = 0; i < module.size(); ++i) {
+        if (module.compare(i, 2, "::") == 0) {
+            try_path += '/';
+            ++i;
+        } else {
+            try_path += module[i];
+        }
     }
-    return (path.size() > 0);
+    return find_module(try_path, "vlib");
 }
-void viua::kernel::Kernel::loadModule(string module) {
-    if (is_native_module(module)) {
-        loadNativeLibrary(module);
-    } else if (is_foreign_module(module)) {
-        loadForeignLibrary(module);
-    } else {
-        throw make_unique<viua::types::Exception>("LinkException", ("failed to link library: " + module));
+static auto foreign_module_path(const string& module) -> string { return find_module(module, "so"); }
+static auto file_identity(const string& path, uint64_t& inode, int64_t& mtime) -> bool {
+    struct stat file_stat;
+    if (stat(path.c_str(), &file_stat) == -1) {
+        return false;
     }
+    inode = file_stat.st_ino;
+    mtime = file_stat.st_mtim.tv_sec * 1000000000 + file_stat.st_mtim.tv_nsec;
+    return true;
 }
-void viua::kernel::Kernel::loadNativeLibrary(const string& module) {
-    regex double_colon("::");
+
+static auto current_module_search_path() -> string {
+    /*  The search path as a single string, in the order find_module() uses it.
+     */
     ostringstream oss;
-    oss << regex_replace(module, double_colon, "/");
-    string try_path = oss.str();
-    string path = support::env::viua::getmodpath(try_path, "vlib", support::env::getpaths("VIUAPATH"));
-    if (path.size() == 0) {
-        path = support::env::viua::getmodpath(try_path, "vlib", VIUAPATH);
+    auto append = [&oss](const vector<string>& paths) {
+        for (const auto& each : paths) {
+            oss << each << ':';
+        }
+    };
+    append(support::env::getpaths("VIUAPATH"));
+    append(VIUAPATH);
+    append(support::env::getpaths("VIUAAFTERPATH"));
+    return oss.str();
+}
+static auto lookup_name(const viua::kernel::ModuleLookup lookup) -> string {
+    switch (lookup) {
+        case viua::kernel::ModuleLookup::NATIVE:
+            return "native";
+        case viua::kernel::ModuleLookup::FOREIGN:
+            return "foreign";
+        default:
+            return "any";
     }
-    if (path.size() == 0) {
-        path = support::env::viua::getmodpath(try_path, "vlib", support::env::getpaths("VIUAAFTERPATH"));
+}
+
+auto viua::kernel::Kernel::resolve_module(const string& module, const ModuleLookup lookup)
+    -> const ResolvedModule& {
+    /*  Must be called with linking_mutex held.
+     */
+    const auto key = ModuleCacheKey{module_search_path, lookup_name(lookup), module};
+    if (auto found = resolved_modules.find(key); found != resolved_modules.end()) {
+        auto& resolved = found->second;
+        if (resolved.verified) {
+            return resolved;
+        }
+
+        // entries read from the cache file are used only if the file did not change
+        uint64_t inode = 0;
+        int64_t mtime = 0;
+        if (file_identity(resolved.path, inode, mtime) and inode == resolved.inode and
+            mtime == resolved.mtime) {
+            resolved.verified = true;
+            return resolved;
+        }
+        resolved_modules.erase(found);
     }
 
-    if (path.size()) {
-        Loader loader(path);
-        loader.load();
+    ResolvedModule resolved{true, "", 0, 0, true};
+    if (lookup != ModuleLookup::FOREIGN) {
+        resolved.path = native_module_path(module);
+    }
+    if (resolved.path.empty() and lookup != ModuleLookup::NATIVE) {
+        resolved.native = false;
+        resolved.path = foreign_module_path(module);
+    }
+    if (resolved.path.empty()) {
+        throw make_unique<viua::types::Exception>("LinkException", ("failed to link library: " + module));
+    }
+    file_identity(resolved.path, resolved.inode, resolved.mtime);
 
-        unique_ptr<viua::internals::types::byte[]> lnk_btcd{loader.getBytecode()};
+    module_cache_changed = true;
+    return (resolved_modules[key] = resolved);
+}
+auto viua::kernel::Kernel::load_module_cache() -> void {
+    /*  One module per line: search path, lookup, name, kind, inode, modification time, and path
+     *  separated by tabs.
+     */
+    if (module_cache_path.empty()) {
+        return;
+    }
 
-        vector<string> fn_names = loader.getFunctions();
-        map<string, viua::internals::types::bytecode_size> fn_addrs = loader.getFunctionAddresses();
-        for (unsigned i = 0; i < fn_names.size(); ++i) {
-            string fn_linkname = fn_names[i];
-            linked_functions[fn_linkname] =
-                pair<string, viua::internals::types::byte*>(module, (lnk_btcd.get() + fn_addrs[fn_names[i]]));
+    ifstream in(module_cache_path);
+    string line;
+    while (getline(in, line)) {
+        istringstream fields(line);
+        string search_path, lookup, name, kind, path;
+        ResolvedModule resolved{true, "", 0, 0, false};
+        if (getline(fields, search_path, '\t') and getline(fields, lookup, '\t') and
+            getline(fields, name, '\t') and getline(fields, kind, '\t') and (fields >> resolved.inode) and
+            fields.get() == '\t' and (fields >> resolved.mtime) and fields.get() == '\t' and
+            getline(fields, path)) {
+            resolved.native = (kind == "native");
+            resolved.path = path;
+            resolved_modules[ModuleCacheKey{search_path, lookup, name}] = resolved;
         }
+    }
+}
+auto viua::kernel::Kernel::save_module_cache() const -> void {
+    if (module_cache_path.empty()) {
+        return;
+    }
 
-        vector<string> bl_names = loader.getBlocks();
-        map<string, viua::internals::types::bytecode_size> bl_addrs = loader.getBlockAddresses();
-        for (unsigned i = 0; i < bl_names.size(); ++i) {
-            string bl_linkname = bl_names[i];
-            linked_blocks[bl_linkname] =
-                pair<string, viua::internals::types::byte*>(module, (lnk_btcd.get() + bl_addrs[bl_linkname]));
+    // write to a temporary file and rename it so that concurrently running VMs never read a partial cache
+    const auto temporary_path = module_cache_path + '.' + to_string(getpid());
+    {
+        ofstream out(temporary_path, ios::trunc);
+        for (const auto& each : resolved_modules) {
+            out << get<0>(each.first) << '\t' << get<1>(each.first) << '\t' << get<2>(each.first) << '\t'
+                << (each.second.native ? "native" : "foreign") << '\t' << each.second.inode << '\t'
+                << each.second.mtime << '\t' << each.second.path << '\n';
+        }
+        if (not out) {
+            return;
         }
+    }
+    rename(temporary_path.c_str(), module_cache_path.c_str());
+}
 
-        linked_modules[module] =
-            pair<viua::internals::types::bytecode_size, unique_ptr<viua::internals::types::byte[]>>(
-                loader.getBytecodeSize(), std::move(lnk_btcd));
+auto viua::kernel::Kernel::is_module_loaded(const string& module) const -> bool {
+    /*  Must be called with linking_mutex held.
+     */
+    auto symbols = linked.load();
+    return (symbols->modules.count(module) or symbols->pending_modules.count(module) or
+            linked_foreign_modules.count(module));
+}
+void viua::kernel::Kernel::loadModule(string module) { loadModules({module}); }
+void viua::kernel::Kernel::loadModules(const vector<string>& modules, const ModuleLookup lookup) {
+    /*  Modules may be imported concurrently by many processes.
+     *  Files of native modules are read, verified, and have their atom literals
+     *  resolved in parallel, and without holding the linking lock, so a batch of
+     *  modules loads in time proportional to the largest one and imports of
+     *  different modules do not wait for each other.
+     *  Modules are then published one by one in the order they were requested, so
+     *  the resulting symbols do not depend on the order in which files were read.
+     *  Lookups are never blocked by linking - they use the last published
+     *  symbols until the new modules are fully linked.
+     */
+    vector<pair<string, ResolvedModule>> requested;
+    {
+        unique_lock<mutex> lck{linking_mutex};
+        for (const auto& module : modules) {
+            auto already_requested = any_of(requested.begin(), requested.end(),
+                                            [&module](const auto& each) { return each.first == module; });
+            if (already_requested or is_module_loaded(module)) {
+                continue;
+            }
+            requested.emplace_back(module, resolve_module(module, lookup));
+        }
+    }
+
+    vector<PreparedModule> prepared(requested.size());
+    if (not lazy_linking) {
+        viua::util::parallel::for_each_index(requested.size(), [&requested, &prepared](size_t i) {
+            if (requested[i].second.native) {
+                prepared[i] = prepare_native_module(requested[i].first, requested[i].second.path);
+            }
+        });
+    }
+
+    unique_lock<mutex> lck{linking_mutex};
+    for (decltype(requested)::size_type i = 0; i < requested.size(); ++i) {
+        const auto& module = requested[i].first;
+        const auto& resolved = requested[i].second;
+
+        // another process may have loaded the module in the meantime
+        if (is_module_loaded(module)) {
+            continue;
+        }
+
+        if (not resolved.native) {
+            loadForeignLibrary(module, resolved.path);
+        } else if (lazy_linking) {
+            register_native_module(module, resolved.path);
+        } else {
+            publish_native_module(std::move(prepared[i]));
+        }
+    }
+}
+void viua::kernel::Kernel::loadNativeLibrary(const string& module, const string& path) {
+    if (lazy_linking) {
+        register_native_module(module, path);
     } else {
-        throw make_unique<viua::types::Exception>("failed to link: " + module);
+        link_native_module(module, path);
     }
 }
-void viua::kernel::Kernel::loadForeignLibrary(const string& module) {
-    string path = "";
-    path = support::env::viua::getmodpath(module, "so", support::env::getpaths("VIUAPATH"));
-    if (path.size() == 0) {
-        path = support::env::viua::getmodpath(module, "so", VIUAPATH);
+auto viua::kernel::Kernel::link_native_module(const string& module, const string& path) -> void {
+    publish_native_module(prepare_native_module(module, path));
+}
+auto viua::kernel::Kernel::prepare_native_module(const string& module, const string& path) -> PreparedModule {
+    Loader loader(path);
+    loader.load();
+
+    PreparedModule prepared;
+    prepared.name = module;
+    prepared.size = loader.getBytecodeSize();
+    prepared.bytecode = loader.mapBytecode();
+
+    vector<viua::internals::types::bytecode_size> entry_points;
+    auto fn_addrs = loader.getFunctionAddresses();
+    for (const auto& each : loader.getFunctions()) {
+        prepared.functions.emplace_back(each, fn_addrs.at(each));
+        entry_points.push_back(fn_addrs.at(each));
     }
-    if (path.size() == 0) {
-        path = support::env::viua::getmodpath(module, "so", support::env::getpaths("VIUAAFTERPATH"));
+    auto bl_addrs = loader.getBlockAddresses();
+    for (const auto& each : loader.getBlocks()) {
+        prepared.blocks.emplace_back(each, bl_addrs.at(each));
+        entry_points.push_back(bl_addrs.at(each));
     }
 
-    if (path.size() == 0) {
-        throw make_unique<viua::types::Exception>("LinkException", ("failed to link library: " + module));
+    vector<viua::internals::types::bytecode_size> literals;
+    try {
+        literals =
+            viua::bytecode::verifier::verify(prepared.bytecode.get(), prepared.size, std::move(entry_points));
+    } catch (const string& e) {
+        throw make_unique<viua::types::Exception>("LinkException", ("failed to link: " + module + ": " + e));
     }
 
+    prepared.atom_literals = intern_atom_literals(prepared.bytecode.get(), prepared.size, literals);
+
+    return prepared;
+}
+auto viua::kernel::Kernel::publish_native_module(PreparedModule prepared) -> void {
+    /*  Must be called with linking_mutex held.
+     *
+     *  Atom literals are published before the module's symbols so no process can
+     *  call into the module before its literals are known.
+     */
+    auto base = prepared.bytecode.get();
+    publish_atom_literals({{base, (base + prepared.size),
+                            make_shared<const AtomLiterals>(std::move(prepared.atom_literals))}});
+
+    linked.update([&prepared, base](LinkedSymbols& symbols) {
+        for (const auto& each : prepared.functions) {
+            symbols.functions.insert_or_assign(
+                each.first, pair<string, viua::internals::types::byte*>(prepared.name, (base + each.second)));
+        }
+        for (const auto& each : prepared.blocks) {
+            symbols.blocks.insert_or_assign(
+                each.first, pair<string, viua::internals::types::byte*>(prepared.name, (base + each.second)));
+        }
+
+        symbols.modules[prepared.name] =
+            pair<viua::internals::types::bytecode_size, shared_ptr<viua::internals::types::byte[]>>(
+                prepared.size, prepared.bytecode);
+        symbols.pending_modules.erase(prepared.name);
+    });
+}
+auto viua::kernel::Kernel::register_native_module(const string& module, const string& path) -> void {
+    /*  Only the names of functions and blocks are read here.
+     *  The module is linked (and its bytecode walked to resolve atom literals) when
+     *  one of them is entered for the first time.
+     */
+    Loader loader(path);
+    loader.load();
+
+    vector<string> fn_names = loader.getFunctions();
+    vector<string> bl_names = loader.getBlocks();
+
+    linked.update([&](LinkedSymbols& symbols) {
+        for (const auto& each : fn_names) {
+            symbols.functions.insert_or_assign(each,
+                                               pair<string, viua::internals::types::byte*>(module, nullptr));
+        }
+        for (const auto& each : bl_names) {
+            symbols.blocks.insert_or_assign(each, pair<string, viua::internals::types::byte*>(module, nullptr));
+        }
+        symbols.pending_modules[module] = path;
+    });
+}
+auto viua::kernel::Kernel::link_pending_module(const string& module) -> void {
+    unique_lock<mutex> lck{linking_mutex};
+
+    // another process may have entered the module first and linked it already
+    auto symbols = linked.load();
+    if (auto pending = symbols->pending_modules.find(module); pending != symbols->pending_modules.end()) {
+        link_native_module(module, pending->second);
+    }
+}
+void viua::kernel::Kernel::loadForeignLibrary(const string& module, const string& path) {
     void* handle = dlopen(path.c_str(), RTLD_LAZY);
 
     if (handle == nullptr) {
@@ -270,30 +551,33 @@ void viua::kernel::Kernel::loadForeignLibrary(const string& module) {
 
     const ForeignFunctionSpec* exported = (*exports)();
 
-    unsigned i = 0;
-    while (exported[i].name != nullptr) {
-        registerExternalFunction(exported[i].name, exported[i].fpointer);
-        ++i;
-    }
+    // all functions of the library are published in a single snapshot
+    foreign_functions.update([exported](auto& functions) {
+        for (auto each = exported; each->name != nullptr; ++each) {
+            functions.insert_or_assign(each->name, each->fpointer);
+        }
+    });
 
     cxx_dynamic_lib_handles.push_back(handle);
+    linked_foreign_modules[module] = path;
 }
 
 
-bool viua::kernel::Kernel::isClass(const string& name) const { return typesystem.count(name); }
+bool viua::kernel::Kernel::isClass(const string& name) const { return typesystem.load()->count(name); }
 
 bool viua::kernel::Kernel::classAccepts(const string& klass, const string& method_name) const {
-    return typesystem.at(klass)->accepts(method_name);
+    return typesystem.load()->at(klass)->accepts(method_name);
 }
 
 vector<string> viua::kernel::Kernel::inheritanceChainOf(const string& type_name) const {
     /** This methods returns full inheritance chain of a type.
      */
-    if (typesystem.count(type_name) == 0) {
+    auto types = typesystem.load();
+    if (types->count(type_name) == 0) {
         // FIXME: better exception message
         throw make_unique<viua::types::Exception>("unregistered type: " + type_name);
     }
-    vector<string> ichain = typesystem.at(type_name)->getAncestors();
+    vector<string> ichain = types->at(type_name)->getAncestors();
     for (unsigned i = 0; i < ichain.size(); ++i) {
         vector<string> sub_ichain = inheritanceChainOf(ichain[i]);
         for (unsigned j = 0; j < sub_ichain.size(); ++j) {
@@ -320,68 +604,165 @@ vector<string> viua::kernel::Kernel::inheritanceChainOf(const string& type_name)
     return ichain;
 }
 
+auto viua::kernel::Kernel::local_function_address(const string& name,
+                                                  viua::internals::types::bytecode_size& address) const
+    -> bool {
+    if (auto found = function_addresses.find(name); found != function_addresses.end()) {
+        address = found->second;
+        return true;
+    }
+    return symbol_index.functions.find(name, address);
+}
+
+auto viua::kernel::Kernel::local_block_address(const string& name,
+                                               viua::internals::types::bytecode_size& address) const
+    -> bool {
+    if (auto found = block_addresses.find(name); found != block_addresses.end()) {
+        address = found->second;
+        return true;
+    }
+    return symbol_index.blocks.find(name, address);
+}
+
 bool viua::kernel::Kernel::isLocalFunction(const string& name) const {
-    return function_addresses.count(name);
+    viua::internals::types::bytecode_size address = 0;
+    return local_function_address(name, address);
 }
 
-bool viua::kernel::Kernel::isLinkedFunction(const string& name) const { return linked_functions.count(name); }
+bool viua::kernel::Kernel::isLinkedFunction(const string& name) const {
+    return linked.load()->functions.count(name);
+}
 
 bool viua::kernel::Kernel::isNativeFunction(const string& name) const {
-    return (function_addresses.count(name) or linked_functions.count(name));
+    return (isLocalFunction(name) or isLinkedFunction(name));
 }
 
 bool viua::kernel::Kernel::isForeignMethod(const string& name) const { return foreign_methods.count(name); }
 
 bool viua::kernel::Kernel::isForeignFunction(const string& name) const {
-    return foreign_functions.count(name);
+    return foreign_functions.load()->count(name);
 }
 
 bool viua::kernel::Kernel::isBlock(const string& name) const {
-    return (block_addresses.count(name) or linked_blocks.count(name));
+    return (isLocalBlock(name) or isLinkedBlock(name));
 }
 
-bool viua::kernel::Kernel::isLocalBlock(const string& name) const { return block_addresses.count(name); }
+bool viua::kernel::Kernel::isLocalBlock(const string& name) const {
+    viua::internals::types::bytecode_size address = 0;
+    return local_block_address(name, address);
+}
 
-bool viua::kernel::Kernel::isLinkedBlock(const string& name) const { return linked_blocks.count(name); }
+bool viua::kernel::Kernel::isLinkedBlock(const string& name) const {
+    return linked.load()->blocks.count(name);
+}
 
 pair<viua::internals::types::byte*, viua::internals::types::byte*> viua::kernel::Kernel::getEntryPointOfBlock(
-    const std::string& name) const {
+    const std::string& name) {
     viua::internals::types::byte* entry_point = nullptr;
     viua::internals::types::byte* module_base = nullptr;
-    if (block_addresses.count(name)) {
-        entry_point = (bytecode.get() + block_addresses.at(name));
+    viua::internals::types::bytecode_size address = 0;
+    if (local_block_address(name, address)) {
+        entry_point = (bytecode.get() + address);
         module_base = bytecode.get();
     } else {
-        auto lf = linked_blocks.at(name);
+        auto symbols = linked.load();
+        if (symbols->blocks.at(name).second == nullptr) {
+            link_pending_module(symbols->blocks.at(name).first);
+            symbols = linked.load();
+        }
+        auto lf = symbols->blocks.at(name);
         entry_point = lf.second;
-        module_base = linked_modules.at(lf.first).second.get();
+        module_base = symbols->modules.at(lf.first).second.get();
     }
     return pair<viua::internals::types::byte*, viua::internals::types::byte*>(entry_point, module_base);
 }
 
 string viua::kernel::Kernel::resolveMethodName(const string& klass, const string& method_name) const {
-    return typesystem.at(klass)->resolvesTo(method_name);
+    return typesystem.load()->at(klass)->resolvesTo(method_name);
 }
 
 pair<viua::internals::types::byte*, viua::internals::types::byte*> viua::kernel::Kernel::getEntryPointOf(
-    const std::string& name) const {
+    const std::string& name) {
     viua::internals::types::byte* entry_point = nullptr;
     viua::internals::types::byte* module_base = nullptr;
-    if (function_addresses.count(name)) {
-        entry_point = (bytecode.get() + function_addresses.at(name));
+    viua::internals::types::bytecode_size address = 0;
+    if (local_function_address(name, address)) {
+        entry_point = (bytecode.get() + address);
         module_base = bytecode.get();
     } else {
-        auto lf = linked_functions.at(name);
+        auto symbols = linked.load();
+        if (symbols->functions.at(name).second == nullptr) {
+            link_pending_module(symbols->functions.at(name).first);
+            symbols = linked.load();
+        }
+        auto lf = symbols->functions.at(name);
         entry_point = lf.second;
-        module_base = linked_modules.at(lf.first).second.get();
+        module_base = symbols->modules.at(lf.first).second.get();
     }
     return pair<viua::internals::types::byte*, viua::internals::types::byte*>(entry_point, module_base);
 }
 
+auto viua::kernel::Kernel::intern_atom_literals(viua::internals::types::byte* code,
+                                                const viua::internals::types::bytecode_size code_size,
+                                                const vector<viua::internals::types::bytecode_size>& offsets)
+    -> AtomLiterals {
+    /*  Offsets of literals are found by the verifier so the bytecode is not walked
+     *  again here.
+     *  Literal address is used as the key so the lookup at runtime does not have to touch
+     *  the characters of the literal.
+     */
+    AtomLiterals resolved;
+    for (const auto each : offsets) {
+        auto literal = reinterpret_cast<const char*>(code + each);
+        resolved[code + each] =
+            viua::types::Atom::intern(str::strdecode(string(literal, strnlen(literal, code_size - each))));
+    }
+    return resolved;
+}
+auto viua::kernel::Kernel::publish_atom_literals(vector<AtomLiteralSegment> added) -> void {
+    /*  A segment for bytecode that already has one replaces it.
+     */
+    using viua::internals::types::byte;
+    atom_literals.update([&added](AtomLiteralSegments& segments) {
+        for (auto& each : added) {
+            auto at = lower_bound(segments.begin(), segments.end(), each.begin,
+                                  [](const AtomLiteralSegment& segment, const byte* begin) {
+                                      return less<const byte*>{}(segment.begin, begin);
+                                  });
+            if (at != segments.end() and at->begin == each.begin) {
+                *at = std::move(each);
+            } else {
+                segments.insert(at, std::move(each));
+            }
+        }
+    });
+}
+
+auto viua::kernel::Kernel::atom_literal_at(const viua::internals::types::byte* literal) const
+    -> viua::types::Atom::handle_type {
+    auto segments = atom_literals.load();
+    auto segment = upper_bound(segments->begin(), segments->end(), literal,
+                               [](const viua::internals::types::byte* address, const AtomLiteralSegment& each) {
+                                   return less<const viua::internals::types::byte*>{}(address, each.begin);
+                               });
+    if (segment == segments->begin()) {
+        return nullptr;
+    }
+    --segment;
+    if (not less<const viua::internals::types::byte*>{}(literal, segment->end)) {
+        return nullptr;
+    }
+    if (auto found = segment->literals->find(literal); found != segment->literals->end()) {
+        return found->second;
+    }
+    return nullptr;
+}
+
 void viua::kernel::Kernel::registerPrototype(const string& type_name,
                                              unique_ptr<viua::types::Prototype> proto) {
-    typesystem.emplace(type_name, nullptr);
-    typesystem.at(type_name) = std::move(proto);
+    shared_ptr<const viua::types::Prototype> registered = std::move(proto);
+    typesystem.update(
+        [&type_name, &registered](Typesystem& types) { types.insert_or_assign(type_name, registered); });
 }
 void viua::kernel::Kernel::registerPrototype(unique_ptr<viua::types::Prototype> proto) {
     auto type_name = proto->getTypeName();
@@ -499,10 +880,11 @@ void viua::kernel::Kernel::send(const viua::process::PID pid, unique_ptr<viua::t
     cerr << "[kernel:receive:send] pid = " << pid.get() << ", queued messages = " << mailboxes[pid].size()
          << "+1" << endl;
 #endif
-    mailboxes[pid].send(std::move(message));
+    mailboxes[pid].send(std::move(message), message_timestamps);
 }
 void viua::kernel::Kernel::receive(const viua::process::PID pid,
-                                   queue<unique_ptr<viua::types::Value>>& message_queue) {
+                                   queue<unique_ptr<viua::types::Value>>& message_queue,
+                                   queue<std::chrono::steady_clock::time_point>& timestamps) {
     unique_lock<mutex> lck(mailbox_mutex);
     if (mailboxes.count(pid) == 0) {
         throw make_unique<viua::types::Exception>("invalid PID");
@@ -512,7 +894,7 @@ void viua::kernel::Kernel::receive(const viua::process::PID pid,
     cerr << "[kernel:receive:pre] pid = " << pid.get() << ", queued messages = " << message_queue.size()
          << endl;
 #endif
-    mailboxes[pid].receive(message_queue);
+    mailboxes[pid].receive(message_queue, timestamps);
 #if VIUA_VM_DEBUG_LOG
     cerr << "[kernel:receive:post] pid = " << pid.get() << ", queued messages = " << message_queue.size()
          << endl;
@@ -521,6 +903,78 @@ void viua::kernel::Kernel::receive(const viua::process::PID pid,
 
 uint64_t viua::kernel::Kernel::pids() const { return running_processes; }
 
+auto viua::kernel::Kernel::mailbox_depths() const -> vector<MailboxDepth> {
+    vector<MailboxDepth> depths;
+    {
+        unique_lock<mutex> lck(mailbox_mutex);
+        for (const auto& each : mailboxes) {
+            depths.push_back(MailboxDepth{each.first, each.second.size(), each.second.high_water_mark()});
+        }
+    }
+    sort(depths.begin(), depths.end(), [](const MailboxDepth& lhs, const MailboxDepth& rhs) -> bool {
+        return (lhs.depth > rhs.depth or
+                (lhs.depth == rhs.depth and lhs.high_water_mark > rhs.high_water_mark));
+    });
+    return depths;
+}
+
+auto viua::kernel::Kernel::telemetry() const -> vector<const viua::scheduler::telemetry::Counters*> {
+    vector<const viua::scheduler::telemetry::Counters*> counters;
+    for (const auto& each : scheduler_counters) {
+        counters.push_back(each.get());
+    }
+    return counters;
+}
+
+auto viua::kernel::Kernel::linked_module_names() const -> vector<string> {
+    vector<string> names;
+    for (const auto& each : linked.load()->modules) {
+        names.push_back(each.first);
+    }
+    return names;
+}
+
+auto viua::kernel::Kernel::pending_module_names() const -> vector<string> {
+    vector<string> names;
+    for (const auto& each : linked.load()->pending_modules) {
+        names.push_back(each.first);
+    }
+    return names;
+}
+
+auto viua::kernel::Kernel::foreign_function_names() const -> vector<string> {
+    vector<string> names;
+    foreign_functions.load()->for_each([&names](const auto& each) { names.push_back(each.first); });
+    return names;
+}
+
+auto viua::kernel::Kernel::dump_metrics(const string& path) const -> void {
+    /*  Metrics are written to a temporary file which is then renamed so that
+     *  whoever scrapes the file never sees it half-written.
+     */
+    auto const temporary = (path + ".tmp");
+    {
+        ofstream out(temporary);
+        viua::scheduler::telemetry::write_prometheus(out, telemetry());
+
+        auto const depths = mailbox_depths();
+        auto most_messages = std::size_t{0};
+        for (const auto& each : depths) {
+            most_messages = std::max(most_messages, each.high_water_mark);
+        }
+        out << "# HELP viua_mailboxes Number of mailboxes.\n";
+        out << "# TYPE viua_mailboxes gauge\n";
+        out << "viua_mailboxes " << depths.size() << '\n';
+        out << "# HELP viua_mailbox_depth_max Messages waiting in the deepest mailbox.\n";
+        out << "# TYPE viua_mailbox_depth_max gauge\n";
+        out << "viua_mailbox_depth_max " << (depths.empty() ? 0 : depths.front().depth) << '\n';
+        out << "# HELP viua_mailbox_high_water_mark_max Most messages ever waiting in a live mailbox.\n";
+        out << "# TYPE viua_mailbox_high_water_mark_max gauge\n";
+        out << "viua_mailbox_high_water_mark_max " << most_messages << '\n';
+    }
+    std::rename(temporary.c_str(), path.c_str());
+}
+
 int viua::kernel::Kernel::exit() const { return return_code; }
 
 static auto no_of_schedulers(const char* env_name, viua::internals::types::schedulers_count default_limit)
@@ -550,6 +1004,131 @@ auto viua::kernel::Kernel::is_tracing_enabled() -> bool {
     return (viua_enable_tracing == "yes" or viua_enable_tracing == "true" or viua_enable_tracing == "1");
 }
 
+auto viua::kernel::Kernel::is_message_timestamping_enabled() -> bool {
+    string viua_message_timestamps;
+    char* env_text = getenv("VIUA_MESSAGE_TIMESTAMPS");
+    if (env_text) {
+        viua_message_timestamps = string(env_text);
+    }
+    return (viua_message_timestamps == "yes" or viua_message_timestamps == "true" or
+            viua_message_timestamps == "1");
+}
+
+auto viua::kernel::Kernel::is_lazy_linking_enabled() -> bool {
+    string viua_lazy_linking;
+    char* env_text = getenv("VIUA_LAZY_LINKING");
+    if (env_text) {
+        viua_lazy_linking = string(env_text);
+    }
+    return (viua_lazy_linking == "yes" or viua_lazy_linking == "true" or viua_lazy_linking == "1");
+}
+
+auto viua::kernel::Kernel::process_memory_limit() -> std::size_t {
+    /*  Limit is given in bytes, optionally with a K, M, or G suffix.
+     *  Zero means "no limit".
+     */
+    return support::env::getnumber("VIUA_PROCESS_MEMORY_LIMIT", 0,
+                                   {{"K", 1024}, {"M", (1024 * 1024)}, {"G", (1024 * 1024 * 1024)}});
+}
+
+auto viua::kernel::Kernel::hibernation_threshold() -> std::chrono::milliseconds {
+    /*  Number of milliseconds a process must spend waiting for a message before
+     *  it is hibernated.
+     *  Zero means "never hibernate automatically".
+     */
+    return std::chrono::milliseconds{support::env::getnumber("VIUA_HIBERNATE_AFTER", 0)};
+}
+
+auto viua::kernel::Kernel::trace_file() -> string {
+    char* env_text = getenv("VIUA_TRACE_FILE");
+    return (env_text ? string(env_text) : string("viua.trace"));
+}
+
+auto viua::kernel::Kernel::opcode_profile_file() -> string {
+    /*  Opcode profile is written as JSON if the file name ends with ".json", and
+     *  as a table otherwise.
+     *  Empty name means "do not profile opcodes".
+     */
+    char* env_text = getenv("VIUA_OPCODE_PROFILE");
+    return (env_text ? string(env_text) : string(""));
+}
+
+auto viua::kernel::Kernel::opcode_profile_sampling_interval() -> uint64_t {
+    /*  Cycles are measured for every n-th executed instruction.
+     *  Zero means "only count executions".
+     */
+    return support::env::getnumber("VIUA_OPCODE_PROFILE_SAMPLING", 0);
+}
+
+auto viua::kernel::Kernel::stack_profile_file() -> string {
+    /*  Sampled stacks are written in collapsed-stack format, ready to be
+     *  turned into a flamegraph.
+     *  Empty name means "do not sample stacks".
+     */
+    char* env_text = getenv("VIUA_STACK_PROFILE");
+    return (env_text ? string(env_text) : string(""));
+}
+
+auto viua::kernel::Kernel::stack_profile_sampling_interval() -> std::chrono::microseconds {
+    return std::chrono::microseconds{support::env::getnumber("VIUA_STACK_PROFILE_INTERVAL", 1000)};
+}
+
+auto viua::kernel::Kernel::allocation_profile_file() -> string {
+    /*  Empty name means "do not profile allocations".
+     */
+    char* env_text = getenv("VIUA_ALLOCATION_PROFILE");
+    return (env_text ? string(env_text) : string(""));
+}
+
+auto viua::kernel::Kernel::allocation_profile_sampling_interval() -> uint64_t {
+    /*  Only every n-th allocation is recorded.
+     */
+    return support::env::getnumber("VIUA_ALLOCATION_PROFILE_SAMPLING", 1);
+}
+
+auto viua::kernel::Kernel::call_profile_file() -> string {
+    /*  Empty name means "do not profile calls".
+     */
+    char* env_text = getenv("VIUA_CALL_PROFILE");
+    return (env_text ? string(env_text) : string(""));
+}
+
+auto viua::kernel::Kernel::metrics_file() -> string {
+    /*  Scheduler telemetry is periodically dumped to this file in Prometheus
+     *  text format.
+     *  Empty name means "do not dump metrics".
+     */
+    char* env_text = getenv("VIUA_METRICS_FILE");
+    return (env_text ? string(env_text) : string(""));
+}
+
+auto viua::kernel::Kernel::metrics_interval() -> std::chrono::milliseconds {
+    return std::chrono::milliseconds{support::env::getnumber("VIUA_METRICS_INTERVAL", 1000)};
+}
+
+auto viua::kernel::Kernel::introspection_socket() -> string {
+    /*  Path of a Unix domain socket on which the kernel answers queries about
+     *  its processes, modules, and schedulers while it is running.
+     *  Empty path means "do not serve introspection queries".
+     */
+    char* env_text = getenv("VIUA_INTROSPECTION_SOCKET");
+    return (env_text ? string(env_text) : string(""));
+}
+
+auto viua::kernel::Kernel::is_telemetry_enabled() -> bool {
+    /*  Schedulers keep telemetry counters only if somebody can read them: the
+     *  metrics file, the introspection socket, or std::scheduler::statistics/0
+     *  (enabled by VIUA_SCHEDULER_TELEMETRY).
+     */
+    string viua_scheduler_telemetry;
+    char* env_text = getenv("VIUA_SCHEDULER_TELEMETRY");
+    if (env_text) {
+        viua_scheduler_telemetry = string(env_text);
+    }
+    return (viua_scheduler_telemetry == "yes" or viua_scheduler_telemetry == "true" or
+            viua_scheduler_telemetry == "1" or metrics_file().size() or introspection_socket().size());
+}
+
 int viua::kernel::Kernel::run() {
     /*  VM viua::kernel::Kernel implementation.
      */
@@ -558,7 +1137,86 @@ int viua::kernel::Kernel::run() {
     }
 
     vp_schedulers_limit = no_of_vp_schedulers();
-    bool enable_tracing = is_tracing_enabled();
+    if (is_tracing_enabled()) {
+        trace_sink = make_unique<viua::scheduler::tracing::Sink>(trace_file());
+    }
+    auto memory_limit = process_memory_limit();
+    auto hibernate_after = hibernation_threshold();
+
+    auto const profile_file = opcode_profile_file();
+    vector<viua::scheduler::profiling::OpcodeProfile> opcode_profiles;
+    if (profile_file.size()) {
+        opcode_profiles.resize(vp_schedulers_limit,
+                               viua::scheduler::profiling::OpcodeProfile{opcode_profile_sampling_interval()});
+    }
+    auto opcode_profile_for = [&opcode_profiles](const decltype(opcode_profiles)::size_type i) {
+        return (opcode_profiles.empty() ? nullptr : &opcode_profiles.at(i));
+    };
+
+    auto const stacks_file = stack_profile_file();
+    vector<viua::scheduler::profiling::StackProfile> stack_profiles;
+    if (stacks_file.size()) {
+        stack_profiles.resize(vp_schedulers_limit,
+                              viua::scheduler::profiling::StackProfile{stack_profile_sampling_interval()});
+    }
+    auto stack_profile_for = [&stack_profiles](const decltype(stack_profiles)::size_type i) {
+        return (stack_profiles.empty() ? nullptr : &stack_profiles.at(i));
+    };
+
+    auto const allocations_file = allocation_profile_file();
+    vector<viua::scheduler::profiling::AllocationProfile> allocation_profiles;
+    if (allocations_file.size()) {
+        allocation_profiles.resize(
+            vp_schedulers_limit,
+            viua::scheduler::profiling::AllocationProfile{allocation_profile_sampling_interval()});
+    }
+    auto allocation_profile_for = [&allocation_profiles](const decltype(allocation_profiles)::size_type i) {
+        return (allocation_profiles.empty() ? nullptr : &allocation_profiles.at(i));
+    };
+
+    auto const calls_file = call_profile_file();
+    vector<viua::scheduler::profiling::CallProfiles> call_profiles;
+    if (calls_file.size()) {
+        call_profiles.resize(vp_schedulers_limit);
+    }
+    auto call_profiles_for = [&call_profiles](const decltype(call_profiles)::size_type i) {
+        return (call_profiles.empty() ? nullptr : &call_profiles.at(i));
+    };
+
+    auto const metrics_path = metrics_file();
+    auto const metrics_period = metrics_interval();
+    scheduler_counters.clear();
+    if (is_telemetry_enabled()) {
+        for (auto i = vp_schedulers_limit; i; --i) {
+            scheduler_counters.emplace_back(make_unique<viua::scheduler::telemetry::Counters>());
+        }
+    }
+    auto counters_for = [this](const decltype(scheduler_counters)::size_type i) {
+        return (scheduler_counters.empty() ? nullptr : scheduler_counters.at(i).get());
+    };
+
+    auto const introspection_path = introspection_socket();
+    vector<unique_ptr<viua::scheduler::introspection::Board>> introspection_boards;
+    if (introspection_path.size()) {
+        for (auto i = vp_schedulers_limit; i; --i) {
+            introspection_boards.emplace_back(make_unique<viua::scheduler::introspection::Board>());
+        }
+    }
+    auto introspection_board_for = [&introspection_boards](const decltype(introspection_boards)::size_type i) {
+        return (introspection_boards.empty() ? nullptr : introspection_boards.at(i).get());
+    };
+
+    auto instrumentation_for = [&](const std::size_t i) {
+        viua::scheduler::Instrumentation instrumentation;
+        instrumentation.trace_sink = trace_sink.get();
+        instrumentation.opcode_profile = opcode_profile_for(i);
+        instrumentation.stack_profile = stack_profile_for(i);
+        instrumentation.allocation_profile = allocation_profile_for(i);
+        instrumentation.call_profiles = call_profiles_for(i);
+        instrumentation.counters = counters_for(i);
+        instrumentation.introspection_board = introspection_board_for(i);
+        return instrumentation;
+    };
 
     vector<viua::scheduler::VirtualProcessScheduler> vp_schedulers;
 
@@ -566,25 +1224,102 @@ int viua::kernel::Kernel::run() {
     vp_schedulers.reserve(vp_schedulers_limit);
 
     vp_schedulers.emplace_back(this, &free_virtual_processes, &free_virtual_processes_mutex,
-                               &free_virtual_processes_cv, enable_tracing);
+                               &free_virtual_processes_cv, memory_limit, hibernate_after,
+                               instrumentation_for(0));
     vp_schedulers.front().bootstrap(commandline_arguments);
 
     for (auto i = (vp_schedulers_limit - 1); i; --i) {
         vp_schedulers.emplace_back(this, &free_virtual_processes, &free_virtual_processes_mutex,
-                                   &free_virtual_processes_cv);
+                                   &free_virtual_processes_cv, memory_limit, hibernate_after,
+                                   instrumentation_for(vp_schedulers.size()));
     }
 
     for (auto& sched : vp_schedulers) {
         sched.launch();
     }
 
+    std::mutex metrics_mutex;
+    std::condition_variable metrics_cv;
+    bool metrics_done = false;
+    std::thread metrics_exporter;
+    if (metrics_path.size()) {
+        metrics_exporter = std::thread([this, &metrics_path, metrics_period, &metrics_mutex, &metrics_cv,
+                                        &metrics_done]() -> void {
+            std::unique_lock<std::mutex> lck{metrics_mutex};
+            while (not metrics_cv.wait_for(lck, metrics_period, [&metrics_done] { return metrics_done; })) {
+                dump_metrics(metrics_path);
+            }
+        });
+    }
+
+    unique_ptr<viua::scheduler::introspection::Server> introspection_server;
+    if (introspection_path.size()) {
+        introspection_server = make_unique<viua::scheduler::introspection::Server>(
+            *this, introspection_boards, introspection_path);
+        introspection_server->start();
+    }
+
     for (auto& sched : vp_schedulers) {
         sched.shutdown();
         sched.join();
     }
 
+    if (introspection_server) {
+        introspection_server->stop();
+    }
+
+    if (metrics_exporter.joinable()) {
+        {
+            std::unique_lock<std::mutex> lck{metrics_mutex};
+            metrics_done = true;
+        }
+        metrics_cv.notify_one();
+        metrics_exporter.join();
+    }
+    if (metrics_path.size()) {
+        dump_metrics(metrics_path);
+    }
+
     return_code = vp_schedulers.front().exit();
 
+    if (profile_file.size()) {
+        for (auto i = decltype(opcode_profiles)::size_type{1}; i < opcode_profiles.size(); ++i) {
+            opcode_profiles.front().merge(opcode_profiles.at(i));
+        }
+        ofstream out(profile_file);
+        if (profile_file.size() > 5 and profile_file.substr(profile_file.size() - 5) == ".json") {
+            opcode_profiles.front().write_json(out);
+        } else {
+            opcode_profiles.front().write_table(out);
+        }
+    }
+    if (stacks_file.size()) {
+        for (auto i = decltype(stack_profiles)::size_type{1}; i < stack_profiles.size(); ++i) {
+            stack_profiles.front().merge(stack_profiles.at(i));
+        }
+        ofstream out(stacks_file);
+        stack_profiles.front().write_collapsed(out);
+    }
+    if (allocations_file.size()) {
+        for (auto i = decltype(allocation_profiles)::size_type{1}; i < allocation_profiles.size(); ++i) {
+            allocation_profiles.front().merge(allocation_profiles.at(i));
+        }
+        ofstream out(allocations_file);
+        allocation_profiles.front().write_report(out);
+    }
+    if (calls_file.size()) {
+        /*  Processes hand their call profiles over when they are destroyed
+         *  so the schedulers (and the processes they still hold) must go
+         *  first.
+         */
+        vp_schedulers.clear();
+        for (auto i = decltype(call_profiles)::size_type{1}; i < call_profiles.size(); ++i) {
+            call_profiles.front().merge(call_profiles.at(i));
+        }
+        ofstream out(calls_file);
+        call_profiles.front().write_report(out);
+    }
+
     return return_code;
 }
 
@@ -592,16 +1327,26 @@ viua::kernel::Kernel::Kernel()
     : bytecode(nullptr),
       bytecode_size(0),
       executable_offset(0),
+      lazy_linking(is_lazy_linking_enabled()),
+      message_timestamps(is_message_timestamping_enabled()),
+      module_search_path(current_module_search_path()),
+      module_cache_changed(false),
+      bytecode_verified(false),
       return_code(0),
       vp_schedulers_limit(default_vp_schedulers_limit),
       ffi_schedulers_limit(default_ffi_schedulers_limit),
       debug(false),
       errors(false) {
+    if (auto cache = getenv("VIUA_MODULE_CACHE"); cache != nullptr) {
+        module_cache_path = cache;
+        load_module_cache();
+    }
+
     ffi_schedulers_limit = no_of_ffi_schedulers();
     for (auto i = ffi_schedulers_limit; i; --i) {
         foreign_call_workers.emplace_back(make_unique<std::thread>(
             viua::scheduler::ffi::ff_call_processor, &foreign_call_queue, &foreign_functions,
-            &foreign_functions_mutex, &foreign_call_queue_mutex, &foreign_call_queue_condition));
+            &foreign_call_queue_mutex, &foreign_call_queue_condition));
     }
 }
 
@@ -642,4 +1387,9 @@ viua::kernel::Kernel::~Kernel() {
     for (unsigned i = 0; i < cxx_dynamic_lib_handles.size(); ++i) {
         dlclose(cxx_dynamic_lib_handles[i]);
     }
+
+    // written once, instead of after every new module, so imports do not wait for the disk
+    if (module_cache_changed) {
+        save_module_cache();
+    }
 }
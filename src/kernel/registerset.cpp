@@ -39,6 +39,10 @@ void viua::kernel::Register::reset(unique_ptr<viua::types::Value> o) {
 
 bool viua::kernel::Register::empty() const { return value == nullptr; }
 
+std::size_t viua::kernel::Register::memory_footprint() const {
+    return (value ? value->memory_footprint() : 0);
+}
+
 viua::types::Value* viua::kernel::Register::get() { return value.get(); }
 
 viua::types::Value* viua::kernel::Register::release() {
@@ -355,6 +359,37 @@ void viua::kernel::RegisterSet::drop() {
 }
 
 
+std::size_t viua::kernel::RegisterSet::memory_footprint() const {
+    auto footprint = (sizeof(RegisterSet) + registers.capacity() * sizeof(Register));
+    for (const auto& each : registers) {
+        footprint += each.memory_footprint();
+    }
+    return footprint;
+}
+
+void viua::kernel::RegisterSet::compact() {
+    auto last = registers.size();
+    while (last and registers.at(last - 1).empty() and not registers.at(last - 1).get_mask()) {
+        --last;
+    }
+    registers.erase(registers.begin() + static_cast<decltype(registers)::difference_type>(last),
+                    registers.end());
+    registers.shrink_to_fit();
+}
+
+void viua::kernel::RegisterSet::expand() {
+    if (registers.size() < registerset_size) {
+        registers.resize(registerset_size);
+    }
+}
+
+bool viua::kernel::RegisterSet::contains(const Register* r) const {
+    if (registers.empty()) {
+        return false;
+    }
+    return (r >= registers.data()) and (r < (registers.data() + registers.size()));
+}
+
 unique_ptr<viua::kernel::RegisterSet> viua::kernel::RegisterSet::copy() {
     auto rscopy = make_unique<viua::kernel::RegisterSet>(size());
     for (decltype(size()) i = 0; i < size(); ++i) {
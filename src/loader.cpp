@@ -18,13 +18,17 @@
  */
 
 #include <cstdint>
-#include <fstream>
+#include <cstring>
+#include <fcntl.h>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <tuple>
+#include <unistd.h>
 #include <vector>
 #include <viua/bytecode/bytetypedef.h>
 #include <viua/loader.h>
@@ -35,21 +39,22 @@ using namespace std;
 using viua::util::memory::aligned_read;
 
 
-IdToAddressMapping Loader::loadmap(char* bytedump, const uint64_t& bytedump_size) {
+IdToAddressMapping Loader::loadmap(const char* bytedump, const uint64_t& bytedump_size) {
     vector<string> order;
     map<string, uint64_t> mapping;
 
-    char* lib_function_ids_map = bytedump;
-
     long unsigned i = 0;
     string lib_fn_name;
     uint64_t lib_fn_address;
     while (i < bytedump_size) {
-        lib_fn_name = string(lib_function_ids_map);
+        auto name_length = strnlen(bytedump + i, bytedump_size - i);
+        if (i + name_length + 1 + sizeof(decltype(lib_fn_address)) > bytedump_size) {
+            throw("truncated symbol table in file: " + path);
+        }
+        lib_fn_name = string(bytedump + i, name_length);
         i += lib_fn_name.size() + 1;  // one for null character
         aligned_read(lib_fn_address) = (bytedump + i);
         i += sizeof(decltype(lib_fn_address));
-        lib_function_ids_map = bytedump + i;
         mapping[lib_fn_name] = lib_fn_address;
         order.emplace_back(lib_fn_name);
     }
@@ -74,10 +79,102 @@ void Loader::calculateFunctionSizes() {
         function_sizes[name] = el_size;
     }
 }
+void Loader::decodeFunctions() {
+    if (functions_decoded) {
+        return;
+    }
+
+    vector<string> order;
+    map<string, uint64_t> mapping;
+
+    tie(order, mapping) =
+        loadmap(reinterpret_cast<const char*>(functions_section.data), functions_section.size);
+
+    for (string p : order) {
+        functions.emplace_back(p);
+        function_addresses[p] = mapping[p];
+    }
+    calculateFunctionSizes();
+
+    functions_decoded = true;
+}
+void Loader::decodeBlocks() {
+    if (blocks_decoded) {
+        return;
+    }
+
+    vector<string> order;
+    map<string, uint64_t> mapping;
+
+    tie(order, mapping) = loadmap(reinterpret_cast<const char*>(blocks_section.data), blocks_section.size);
+
+    for (string p : order) {
+        blocks.emplace_back(p);
+        block_addresses[p] = mapping[p];
+    }
+
+    blocks_decoded = true;
+}
+
+void Loader::mapImage() {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1 or not S_ISREG(file_stat.st_mode)) {
+        close(fd);
+        return;
+    }
+    image_size = static_cast<size_t>(file_stat.st_size);
+
+    void* mapped = MAP_FAILED;
+    if (image_size) {
+        mapped = mmap(nullptr, image_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    if (mapped != MAP_FAILED) {
+        auto mapped_size = image_size;
+        image = shared_ptr<byte[]>(static_cast<byte*>(mapped),
+                                   [mapped_size](byte* p) { munmap(p, mapped_size); });
+    } else {
+        auto buffer = make_unique<byte[]>(image_size);
+        size_t got = 0;
+        while (got < image_size) {
+            auto n = read(fd, buffer.get() + got, image_size - got);
+            if (n <= 0) {
+                break;
+            }
+            got += static_cast<size_t>(n);
+        }
+        image_size = got;
+        image = std::move(buffer);
+    }
+
+    close(fd);
+}
+const Loader::byte* Loader::take(size_t n) {
+    if (n > image_size or cursor > (image_size - n)) {
+        throw("truncated file: " + path);
+    }
+    auto data = image.get() + cursor;
+    cursor += n;
+    return data;
+}
+uint64_t Loader::takeSize() {
+    uint64_t value = 0;
+    aligned_read(value) = take(sizeof(decltype(value)));
+    return value;
+}
+Loader::Section Loader::takeSection() {
+    auto section_size = takeSize();
+    return Section{take(section_size), section_size};
+}
 
-void Loader::loadMagicNumber(ifstream& in) {
+void Loader::loadMagicNumber() {
     char magic_number[5];
-    in.read(magic_number, sizeof(char) * 5);
+    memcpy(magic_number, take(sizeof(char) * 5), sizeof(char) * 5);
     if (magic_number[4] != '\0') {
         throw "invalid magic number";
     }
@@ -86,9 +183,8 @@ void Loader::loadMagicNumber(ifstream& in) {
     }
 }
 
-void Loader::assumeBinaryType(ifstream& in, ViuaBinaryType assumed_binary_type) {
-    char bt;
-    in.read(&bt, sizeof(decltype(bt)));
+void Loader::assumeBinaryType(ViuaBinaryType assumed_binary_type) {
+    char bt = static_cast<char>(*take(sizeof(decltype(bt))));
     if (bt != assumed_binary_type) {
         ostringstream error;
         error << "not a " << (assumed_binary_type == VIUA_LINKABLE ? "linkable" : "executable")
@@ -97,144 +193,132 @@ void Loader::assumeBinaryType(ifstream& in, ViuaBinaryType assumed_binary_type)
     }
 }
 
-static map<string, string> load_meta_information_map(ifstream& in) {
-    uint64_t meta_information_map_size = 0;
-    readinto(in, &meta_information_map_size);
-
-    auto meta_information_map_buffer = make_unique<char[]>(meta_information_map_size);
-    in.read(meta_information_map_buffer.get(), static_cast<std::streamsize>(meta_information_map_size));
-
-    map<string, string> meta_information_map;
+static auto section_string(const char* buffer, uint64_t i, uint64_t section_size) -> string {
+    return string(buffer + i, strnlen(buffer + i, section_size - i));
+}
+void Loader::loadMetaInformation() {
+    auto section = takeSection();
+    auto buffer = reinterpret_cast<const char*>(section.data);
 
-    char* buffer = meta_information_map_buffer.get();
     uint64_t i = 0;
     string key, value;
-    while (i < meta_information_map_size) {
-        key = string(buffer + i);
+    while (i < section.size) {
+        key = section_string(buffer, i, section.size);
         i += (key.size() + 1);
-        value = string(buffer + i);
+        if (i >= section.size) {
+            break;
+        }
+        value = section_string(buffer, i, section.size);
         i += (value.size() + 1);
-        meta_information_map[key] = value;
+        meta_information[key] = value;
     }
-
-    return meta_information_map;
 }
-void Loader::loadMetaInformation(ifstream& in) { meta_information = load_meta_information_map(in); }
-
-static vector<string> load_string_list(ifstream& in) {
-    uint64_t signatures_section_size = 0;
-    readinto(in, &signatures_section_size);
-
-    auto signatures_section_buffer = make_unique<char[]>(signatures_section_size);
-    in.read(signatures_section_buffer.get(), static_cast<std::streamsize>(signatures_section_size));
 
+static vector<string> load_string_list(const char* buffer, const uint64_t signatures_section_size) {
     uint64_t i = 0;
-    char* buffer = signatures_section_buffer.get();
     string sig;
     vector<string> strings_list;
     while (i < signatures_section_size) {
-        sig = string(buffer + i);
+        sig = section_string(buffer, i, signatures_section_size);
         i += (sig.size() + 1);
         strings_list.emplace_back(sig);
     }
 
     return strings_list;
 }
-void Loader::loadExternalSignatures(ifstream& in) { external_signatures = load_string_list(in); }
-void Loader::loadExternalBlockSignatures(ifstream& in) { external_signatures_block = load_string_list(in); }
+void Loader::loadExternalSignatures() {
+    auto section = external_functions_section = takeSection();
+    external_signatures = load_string_list(reinterpret_cast<const char*>(section.data), section.size);
+}
+void Loader::loadExternalBlockSignatures() {
+    auto section = external_blocks_section = takeSection();
+    external_signatures_block = load_string_list(reinterpret_cast<const char*>(section.data), section.size);
+}
 
-void Loader::loadJumpTable(ifstream& in) {
+void Loader::loadJumpTable() {
     // load jump table
-    uint64_t lib_total_jumps;
-    readinto(in, &lib_total_jumps);
+    uint64_t lib_total_jumps = takeSize();
+    if (lib_total_jumps > (image_size - cursor) / sizeof(uint64_t)) {
+        throw("truncated file: " + path);
+    }
 
-    uint64_t lib_jmp;
+    jumps.reserve(lib_total_jumps);
     for (uint64_t i = 0; i < lib_total_jumps; ++i) {
-        readinto(in, &lib_jmp);
-        jumps.push_back(lib_jmp);
+        jumps.push_back(takeSize());
     }
 }
-void Loader::loadFunctionsMap(ifstream& in) {
-    uint64_t lib_function_ids_section_size = 0;
-    readinto(in, &lib_function_ids_section_size);
-
-    auto lib_buffer_function_ids = make_unique<char[]>(lib_function_ids_section_size);
-    in.read(lib_buffer_function_ids.get(), static_cast<std::streamsize>(lib_function_ids_section_size));
-
-    vector<string> order;
-    map<string, uint64_t> mapping;
-
-    tie(order, mapping) = loadmap(lib_buffer_function_ids.get(), lib_function_ids_section_size);
-
-    for (string p : order) {
-        functions.emplace_back(p);
-        function_addresses[p] = mapping[p];
-    }
+void Loader::loadFunctionsMap() { functions_section = takeSection(); }
+void Loader::loadBlocksMap() { blocks_section = takeSection(); }
+void Loader::loadBytecode() {
+    size = takeSize();
+    // the mapping is read-only; the const is only cast away to fit the kernel's interface
+    bytecode = const_cast<byte*>(take(size));
 }
-void Loader::loadBlocksMap(ifstream& in) {
-    uint64_t lib_block_ids_section_size = 0;
-    readinto(in, &lib_block_ids_section_size);
-
-    auto lib_buffer_block_ids = make_unique<char[]>(lib_block_ids_section_size);
-    in.read(lib_buffer_block_ids.get(), static_cast<std::streamsize>(lib_block_ids_section_size));
-
-    vector<string> order;
-    map<string, uint64_t> mapping;
-
-    tie(order, mapping) = loadmap(lib_buffer_block_ids.get(), lib_block_ids_section_size);
-
-    for (string p : order) {
-        blocks.emplace_back(p);
-        block_addresses[p] = mapping[p];
+void Loader::loadSymbolIndex() {
+    /*  The index is optional, and binaries without it end right after the bytecode.
+     */
+    const auto magic_size = strlen(VIUA_SYMBOL_INDEX_MAGIC) + 1;
+    if ((image_size - cursor) < magic_size or
+        memcmp(image.get() + cursor, VIUA_SYMBOL_INDEX_MAGIC, magic_size) != 0) {
+        return;
     }
-}
-void Loader::loadBytecode(ifstream& in) {
-    in.read(reinterpret_cast<char*>(&size), sizeof(decltype(size)));
-    bytecode = make_unique<viua::internals::types::byte[]>(size);
-    in.read(reinterpret_cast<char*>(bytecode.get()), static_cast<std::streamsize>(size));
+    take(magic_size);
+
+    using viua::bytecode::symbol_index::Table;
+    for (auto each : {make_pair(&symbol_index.functions, functions_section),
+                      make_pair(&symbol_index.blocks, blocks_section),
+                      make_pair(&symbol_index.external_functions, external_functions_section),
+                      make_pair(&symbol_index.external_blocks, external_blocks_section)}) {
+        try {
+            *each.first = Table(image.get() + cursor, image_size - cursor,
+                                reinterpret_cast<const char*>(each.second.data), each.second.size);
+        } catch (const string& e) { throw(e + " in file: " + path); }
+        take(each.first->size());
+    }
+    symbol_index.present = true;
 }
 
 Loader& Loader::load() {
-    ifstream in(path, ios::in | ios::binary);
-    if (!in) {
+    mapImage();
+    if (not image) {
         throw("failed to open file: " + path);
     }
 
-    loadMagicNumber(in);
-    assumeBinaryType(in, VIUA_LINKABLE);
+    loadMagicNumber();
+    assumeBinaryType(VIUA_LINKABLE);
 
-    loadMetaInformation(in);
+    loadMetaInformation();
 
     // jump table must be loaded if loading a library
-    loadJumpTable(in);
+    loadJumpTable();
 
-    loadExternalSignatures(in);
-    loadExternalBlockSignatures(in);
-    loadBlocksMap(in);
-    loadFunctionsMap(in);
-    loadBytecode(in);
-    calculateFunctionSizes();
+    loadExternalSignatures();
+    loadExternalBlockSignatures();
+    loadBlocksMap();
+    loadFunctionsMap();
+    loadBytecode();
+    loadSymbolIndex();
 
     return (*this);
 }
 
 Loader& Loader::executable() {
-    ifstream in(path, ios::in | ios::binary);
-    if (!in) {
+    mapImage();
+    if (not image) {
         throw("fatal: failed to open file: " + path);
     }
 
-    loadMagicNumber(in);
-    assumeBinaryType(in, VIUA_EXECUTABLE);
+    loadMagicNumber();
+    assumeBinaryType(VIUA_EXECUTABLE);
 
-    loadMetaInformation(in);
+    loadMetaInformation();
 
-    loadExternalSignatures(in);
-    loadExternalBlockSignatures(in);
-    loadBlocksMap(in);
-    loadFunctionsMap(in);
-    loadBytecode(in);
-    calculateFunctionSizes();
+    loadExternalSignatures();
+    loadExternalBlockSignatures();
+    loadBlocksMap();
+    loadFunctionsMap();
+    loadBytecode();
+    loadSymbolIndex();
 
     return (*this);
 }
@@ -242,11 +326,14 @@ Loader& Loader::executable() {
 uint64_t Loader::getBytecodeSize() { return size; }
 unique_ptr<viua::internals::types::byte[]> Loader::getBytecode() {
     auto copy = make_unique<viua::internals::types::byte[]>(size);
-    for (uint64_t i = 0; i < size; ++i) {
-        copy[i] = bytecode[i];
+    if (size) {
+        memcpy(copy.get(), bytecode, size);
     }
     return copy;
 }
+shared_ptr<viua::internals::types::byte[]> Loader::mapBytecode() {
+    return shared_ptr<viua::internals::types::byte[]>(image, bytecode);
+}
 
 vector<uint64_t> Loader::getJumps() { return jumps; }
 
@@ -256,9 +343,27 @@ vector<string> Loader::getExternalSignatures() { return external_signatures; }
 
 vector<string> Loader::getExternalBlockSignatures() { return external_signatures_block; }
 
-map<string, uint64_t> Loader::getFunctionAddresses() { return function_addresses; }
-map<string, uint64_t> Loader::getFunctionSizes() { return function_sizes; }
-vector<string> Loader::getFunctions() { return functions; }
+map<string, uint64_t> Loader::getFunctionAddresses() {
+    decodeFunctions();
+    return function_addresses;
+}
+map<string, uint64_t> Loader::getFunctionSizes() {
+    decodeFunctions();
+    return function_sizes;
+}
+vector<string> Loader::getFunctions() {
+    decodeFunctions();
+    return functions;
+}
+
+map<string, uint64_t> Loader::getBlockAddresses() {
+    decodeBlocks();
+    return block_addresses;
+}
+vector<string> Loader::getBlocks() {
+    decodeBlocks();
+    return blocks;
+}
 
-map<string, uint64_t> Loader::getBlockAddresses() { return block_addresses; }
-vector<string> Loader::getBlocks() { return blocks; }
+bool Loader::hasSymbolIndex() const { return symbol_index.present; }
+const viua::bytecode::symbol_index::Index& Loader::getSymbolIndex() const { return symbol_index; }
@@ -21,6 +21,9 @@
 
 const char* ENTRY_FUNCTION_NAME = "__entry";
 const char* VIUA_MAGIC_NUMBER = "VIUA";
+const char* VIUA_SYMBOL_INDEX_MAGIC = "SYMIDX";
+const char* VIUA_IMAGE_MAGIC = "VIUAIMG";
+const char* VIUA_TRACE_MAGIC = "VIUATRC";
 
 const ViuaBinaryType VIUA_LINKABLE = 'L';
 const ViuaBinaryType VIUA_EXECUTABLE = 'E';
@@ -18,6 +18,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <viua/bytecode/maps.h>
@@ -32,34 +33,34 @@
 using namespace std;
 
 
-viua::process::PID::PID(const viua::process::Process* p) : associated_process(p) {}
-bool viua::process::PID::operator==(const viua::process::PID& that) const {
-    return (associated_process == that.associated_process);
-}
-bool viua::process::PID::operator==(const viua::process::Process* that) const {
-    return (associated_process == that);
-}
+static std::atomic<uint64_t> next_pid_serial{0};
+
+viua::process::PID::PID(const viua::process::Process* p)
+    : associated_process(p), serial(next_pid_serial.fetch_add(1, std::memory_order_relaxed)) {}
+bool viua::process::PID::operator==(const viua::process::PID& that) const { return (serial == that.serial); }
 bool viua::process::PID::operator<(const viua::process::PID& that) const {
     // PIDs can't really have a less-than relation
     // they are either equal or not, and that's it
     // less-than relation is implemented only so that viua::process::PID objects may be used as
     // keys in std::map<>
-    return (reinterpret_cast<uint64_t>(associated_process) <
-            reinterpret_cast<uint64_t>(that.associated_process));
+    return (serial < that.serial);
 }
 bool viua::process::PID::operator>(const viua::process::PID& that) const {
     // PIDs can't really have a greater-than relation
     // they are either equal or not, and that's it
     // greater-than relation is implemented only so that viua::process::PID objects may be used as
     // keys in std::map<>
-    return (reinterpret_cast<uint64_t>(associated_process) >
-            reinterpret_cast<uint64_t>(that.associated_process));
+    return (serial > that.serial);
 }
 
 auto viua::process::PID::get() const -> decltype(associated_process) { return associated_process; }
+auto viua::process::PID::serial_number() const -> uint64_t { return serial; }
 
 auto viua::process::PID::str() const -> string {
+    /*  Addresses of processes are reused so the serial is what tells apart a
+     *  process from an earlier one that lived at the same address.
+     */
     ostringstream oss;
-    oss << hex << associated_process;
+    oss << hex << associated_process << dec << '#' << serial;
     return oss.str();
 }
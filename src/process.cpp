@@ -29,6 +29,7 @@
 #include <viua/types/integer.h>
 #include <viua/types/process.h>
 #include <viua/types/reference.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 
@@ -156,6 +157,10 @@ viua::internals::types::byte* viua::process::Process::callForeign(
     stack->frame_new->return_address = return_address;
     stack->frame_new->return_register = return_register;
 
+    if (call_profile) {
+        profile_enter(stack->frame_new.get(), stack->frame_new->function_name);
+    }
+
     suspend();
     scheduler->requestForeignFunctionCall(stack->frame_new.release(), this);
 
@@ -224,7 +229,13 @@ auto viua::process::Process::push_deferred(string call_name) -> void {
     stack->back()->deferred_calls.push_back(std::move(stack->frame_new));
 }
 
-void viua::process::Process::handleActiveException() { stack->unwind(); }
+void viua::process::Process::handleActiveException() {
+    // an exception thrown into a process waiting for a message or a join ends the wait
+    timeout_active = false;
+    wait_until_infinity = false;
+    waiting_for_message = false;
+    stack->unwind();
+}
 viua::internals::types::byte* viua::process::Process::tick() {
     viua::internals::types::byte* previous_instruction_pointer = stack->instruction_pointer;
 
@@ -283,8 +294,12 @@ viua::internals::types::byte* viua::process::Process::tick() {
      *      - the offending opcode is RECEIVE (as this means that a process is waiting for a message),
      *      - an object has been thrown, as the instruction pointer will be adjusted by
      *        catchers or execution will be halted on unhandled types,
+     *
+     *  Verified code cannot get stuck on a single instruction (the verifier rejects
+     *  jumps that point to the instruction they appear in) so the check is only
+     *  done for code that was not verified.
      */
-    if (stack->instruction_pointer == previous_instruction_pointer and
+    if (not stack->verified_code and stack->instruction_pointer == previous_instruction_pointer and
         stack->state_of() == viua::process::Stack::STATE::RUNNING and
         (OPCODE(*stack->instruction_pointer) != RETURN and OPCODE(*stack->instruction_pointer) != JOIN and
          OPCODE(*stack->instruction_pointer) != RECEIVE) and
@@ -384,6 +399,10 @@ viua::internals::types::byte* viua::process::Process::become(const string& funct
         throw make_unique<viua::types::Exception>("process from undefined function: " + function_name);
     }
 
+    // frames of the function that died are dropped as if they returned now
+    if (call_profile) {
+        profile_leave_all();
+    }
     stack->clear();
     stack->thrown.reset(nullptr);
     stack->caught.reset(nullptr);
@@ -422,11 +441,226 @@ void viua::process::Process::hidden(bool state) { is_hidden = state; }
 
 bool viua::process::Process::empty() const { return message_queue.empty(); }
 
+auto viua::process::Process::memory_usage() -> std::size_t {
+    auto usage = sizeof(Process);
+    usage += global_register_set->memory_footprint();
+    for (const auto& each : static_registers) {
+        usage += viua::util::memory::node_size<decltype(static_registers)::value_type>();
+        usage += each.second->memory_footprint();
+    }
+    for (const auto& each : stacks) {
+        usage += viua::util::memory::node_size<decltype(stacks)::value_type>();
+        usage += each.second->memory_footprint();
+    }
+
+    // std::queue cannot be iterated so every message is rotated through it once
+    for (auto i = message_queue.size(); i; --i) {
+        auto message = std::move(message_queue.front());
+        message_queue.pop();
+        usage += message->memory_footprint();
+        message_queue.push(std::move(message));
+    }
+
+    return usage;
+}
+
+auto viua::process::Process::allocated_memory() const -> std::size_t {
+    return (memory_account ? memory_account->bytes() : 0);
+}
+auto viua::process::Process::allocation_account() const -> viua::types::MemoryAccount* { return memory_account; }
+
+auto viua::process::Process::collect_messages() -> void {
+    if (not memory_account) {
+        scheduler->receive(process_id, message_queue, message_timestamps);
+        return;
+    }
+
+    /*  Messages are still charged to the processes that sent them so received ones
+     *  are moved to the account of this process.
+     */
+    queue<unique_ptr<viua::types::Value>> received;
+    scheduler->receive(process_id, received, message_timestamps);
+    while (not received.empty()) {
+        received.front()->charge_to(memory_account);
+        message_queue.push(std::move(received.front()));
+        received.pop();
+    }
+}
+
+auto viua::process::Process::hibernatable_register_sets() -> vector<viua::kernel::RegisterSet*> {
+    /*  Register sets containing return registers of frames on the stacks are not
+     *  compacted because compacting would invalidate the return registers.
+     */
+    vector<viua::kernel::RegisterSet*> register_sets;
+    vector<const viua::kernel::Register*> return_registers;
+
+    register_sets.push_back(global_register_set.get());
+    for (auto& each : static_registers) {
+        register_sets.push_back(each.second.get());
+    }
+    for (auto& each : stacks) {
+        for (const auto& frame : *each.second) {
+            register_sets.push_back(frame->arguments.get());
+            register_sets.push_back(frame->local_register_set.get());
+            return_registers.push_back(frame->return_register);
+        }
+        if (each.second->frame_new) {
+            register_sets.push_back(each.second->frame_new->arguments.get());
+            register_sets.push_back(each.second->frame_new->local_register_set.get());
+        }
+    }
+
+    vector<viua::kernel::RegisterSet*> hibernatable;
+    for (auto each : register_sets) {
+        if (each == nullptr) {
+            continue;
+        }
+        auto holds_return_register = false;
+        for (const auto r : return_registers) {
+            holds_return_register = (holds_return_register or each->contains(r));
+        }
+        if (not holds_return_register) {
+            hibernatable.push_back(each);
+        }
+    }
+    return hibernatable;
+}
+
+auto viua::process::Process::request_hibernation() -> void { hibernation_requested = true; }
+
+auto viua::process::Process::should_hibernate(const std::chrono::milliseconds threshold) const -> bool {
+    if (hibernated or is_hidden or (not waiting_for_message) or (not message_queue.empty())) {
+        return false;
+    }
+    return (hibernation_requested or
+            (threshold.count() and ((std::chrono::steady_clock::now() - waiting_since) >= threshold)));
+}
+
+auto viua::process::Process::hibernate() -> void {
+    for (auto each : hibernatable_register_sets()) {
+        each->compact();
+    }
+    hibernated = true;
+}
+
+auto viua::process::Process::hibernating() const -> bool { return hibernated; }
+
+auto viua::process::Process::blocked_in_receive() const -> bool { return waiting_for_message; }
+
+auto viua::process::Process::queued_messages() const -> std::size_t { return message_queue.size(); }
+
+auto viua::process::Process::message_latency_histogram() const -> const viua::scheduler::telemetry::Histogram& {
+    return message_latency;
+}
+
+auto viua::process::Process::record_message_latency() -> void {
+    /*  Must be called just before the message at the front of the queue is
+     *  popped.
+     *  Messages and their timestamps are queued in lockstep so if the queues
+     *  have different lengths the messages were not timestamped.
+     */
+    if (message_timestamps.empty() or message_timestamps.size() != message_queue.size()) {
+        return;
+    }
+    auto const latency = (std::chrono::steady_clock::now() - message_timestamps.front());
+    message_timestamps.pop();
+
+    message_latency.record(latency);
+    if (auto counters = scheduler->telemetry(); counters) {
+        counters->message_latency.record(latency);
+    }
+}
+
+auto viua::process::Process::profile_clocks() const -> std::pair<uint64_t, uint64_t> {
+    /*  Returns running time and wall time of the process, in nanoseconds.
+     */
+    auto const now = std::chrono::steady_clock::now();
+    auto const running = (quant_started_at == decltype(quant_started_at){})
+                             ? std::chrono::nanoseconds{0}
+                             : std::chrono::duration_cast<std::chrono::nanoseconds>(now - quant_started_at);
+    return {
+        running_time + static_cast<uint64_t>(running.count()),
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count())};
+}
+
+auto viua::process::Process::profile_enter(Frame* frame, const string& function_name) -> void {
+    auto const [running, wall] = profile_clocks();
+    call_profile->enter(frame, function_name, running, wall);
+}
+
+auto viua::process::Process::profile_leave(Frame* callee, Frame* caller) -> void {
+    auto const [running, wall] = profile_clocks();
+    call_profile->leave(callee, caller, running, wall);
+}
+auto viua::process::Process::profile_leave_all() -> void {
+    auto const [running, wall] = profile_clocks();
+    for (auto i = stack->size(); i; --i) {
+        call_profile->leave(stack->at(i - 1).get(), (i > 1 ? stack->at(i - 2).get() : nullptr), running, wall);
+    }
+}
+
+auto viua::process::Process::begin_quant() -> void {
+    if (call_profile) {
+        quant_started_at = std::chrono::steady_clock::now();
+    }
+}
+
+auto viua::process::Process::end_quant() -> void {
+    if (not call_profile) {
+        return;
+    }
+
+    running_time = profile_clocks().first;
+    quant_started_at = {};
+
+    /*  Frames left on the stack of a stopped process (e.g. the one of the entry
+     *  function, which halts instead of returning) are closed as if they
+     *  returned now.
+     */
+    if (stopped()) {
+        profile_leave_all();
+    }
+}
+
+auto viua::process::Process::profile_foreign_call_finished(Frame* frame) -> void {
+    if (not call_profile) {
+        return;
+    }
+    // the process was not running while the foreign function was so its running clock did not advance
+    auto const wall = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                std::chrono::steady_clock::now().time_since_epoch())
+                                                .count());
+    call_profile->leave(frame, (stack->size() ? stack->back().get() : nullptr), frame->entered_running_at,
+                        wall);
+}
+
+auto viua::process::Process::ready_to_wake_up() -> bool {
+    collect_messages();
+    if (not message_queue.empty()) {
+        return true;
+    }
+    return (timeout_active and (not wait_until_infinity) and
+            (waiting_until < std::chrono::steady_clock::now()));
+}
+
+auto viua::process::Process::rehydrate() -> void {
+    for (auto each : hibernatable_register_sets()) {
+        each->expand();
+    }
+    hibernated = false;
+    hibernation_requested = false;
+}
+
 void viua::process::Process::migrate_to(viua::scheduler::VirtualProcessScheduler* sch) { scheduler = sch; }
 
 viua::process::Process::Process(unique_ptr<Frame> frm, viua::scheduler::VirtualProcessScheduler* sch,
                                 viua::process::Process* pt, const bool enable_tracing)
     : tracing_enabled(enable_tracing),
+      call_profile((sch and sch->call_profiles()) ? make_unique<viua::scheduler::profiling::CallProfile>()
+                                                  : nullptr),
+      running_time(0),
+      quant_started_at(),
       scheduler(sch),
       parent_process(pt),
       global_register_set(nullptr),
@@ -438,6 +672,9 @@ viua::process::Process::Process(unique_ptr<Frame> frm, viua::scheduler::VirtualP
       process_priority(512),
       process_id(this),
       is_hidden(false) {
+    if (viua::types::accounting_memory()) {
+        memory_account = new viua::types::MemoryAccount();
+    }
     global_register_set = make_unique<viua::kernel::RegisterSet>(DEFAULT_REGISTER_SIZE);
     currently_used_register_set = frm->local_register_set.get();
     auto s = make_unique<Stack>(frm->function_name, this, &currently_used_register_set,
@@ -448,4 +685,11 @@ viua::process::Process::Process(unique_ptr<Frame> frm, viua::scheduler::VirtualP
     stacks[s.get()] = std::move(s);
 }
 
-viua::process::Process::~Process() {}
+viua::process::Process::~Process() {
+    if (memory_account) {
+        memory_account->release();
+    }
+    if (call_profile and scheduler->call_profiles()) {
+        scheduler->call_profiles()->record(starting_function(), *call_profile);
+    }
+}
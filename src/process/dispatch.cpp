@@ -23,72 +23,16 @@
 #include <viua/bytecode/maps.h>
 #include <viua/kernel/kernel.h>
 #include <viua/process.h>
+#include <viua/scheduler/vps.h>
 #include <viua/types/exception.h>
 using namespace std;
 
 
-auto viua::process::Process::get_trace_line(viua::internals::types::byte* for_address) const -> string {
-    ostringstream trace_line;
-
-    trace_line << "[";
-    trace_line << " scheduler = " << hex << scheduler << dec;
-    trace_line << ", process = " << hex << this << dec;
-    trace_line << ", stack = " << hex << stack << dec;
-    trace_line << ", frame = 0x" << hex << reinterpret_cast<unsigned long>(stack->back().get()) << dec;
-    trace_line << ", jump_base = 0x" << hex << reinterpret_cast<unsigned long>(stack->jump_base) << dec;
-    trace_line << ", address = 0x" << hex << reinterpret_cast<unsigned long>(for_address) << dec;
-    trace_line << ", depth = " << stack->size();
-    if (stack->thrown) {
-        trace_line << ", thrown = 0x" << hex << reinterpret_cast<unsigned long>(stack->thrown.get()) << dec;
-    }
-    if (stack->caught) {
-        trace_line << ", caught = 0x" << hex << reinterpret_cast<unsigned long>(stack->caught.get()) << dec;
-    }
-    trace_line << " ] ";
-
-    try {
-        trace_line << OP_NAMES.at(static_cast<OPCODE>(*for_address));
-    } catch (std::out_of_range& e) {
-        trace_line << "<unrecognised instruction byte = " << static_cast<unsigned>(*for_address) << '>';
-        return trace_line.str();
-    }
-
-    if (static_cast<OPCODE>(*for_address) == CALL or static_cast<OPCODE>(*for_address) == PROCESS or
-        static_cast<OPCODE>(*for_address) == MSG) {
-        auto working_address = for_address + 1;
-        if (viua::bytecode::decoder::operands::is_void(working_address)) {
-            ++working_address;
-        } else {
-            working_address += sizeof(viua::internals::types::byte);  // for opcode type
-            working_address += sizeof(viua::internals::types::register_index);
-            working_address += sizeof(viua::internals::types::registerset_type_marker);
-        }
-        trace_line << ' ' << string(reinterpret_cast<char*>(working_address));
-    }
-    if (static_cast<OPCODE>(*for_address) == TAILCALL or static_cast<OPCODE>(*for_address) == DEFER) {
-        trace_line << ' ';
-        trace_line << string(reinterpret_cast<char*>(for_address + 1));
-    }
-    if (static_cast<OPCODE>(*for_address) == RETURN) {
-        trace_line << " from " + stack->back()->function_name;
-        if (stack->state_of() == viua::process::Stack::STATE::RUNNING) {
-            trace_line << (stack->back()->deferred_calls.size() ? " before deferred" : " with no deferred");
-        } else if (stack->state_of() == viua::process::Stack::STATE::SUSPENDED_BY_DEFERRED_ON_FRAME_POP) {
-            trace_line << " after deferred";
-        }
-    }
-
-    return trace_line.str();
-}
-auto viua::process::Process::emit_trace_line(viua::internals::types::byte* for_address) const -> void {
-    // FIXME conditionally enable duplicate trace lines
-    static string previous_trace_line;
-    string line = get_trace_line(for_address);
-
-    if (line != previous_trace_line) {
-        cerr << (line + "\n");
-        previous_trace_line = line;
-    }
+auto viua::process::Process::emit_trace_record(viua::internals::types::byte* for_address) const -> void {
+    scheduler->tracer().record(process_id.serial_number(),
+                               static_cast<uint64_t>(for_address - stack->jump_base),
+                               static_cast<uint32_t>(stack->size()), *for_address,
+                               (stack->thrown ? viua::scheduler::tracing::RECORD_EXCEPTION_ACTIVE : 0));
 }
 
 
@@ -96,7 +40,16 @@ viua::internals::types::byte* viua::process::Process::dispatch(viua::internals::
     /** Dispatches instruction at a pointer to its handler.
      */
     if (tracing_enabled) {
-        emit_trace_line(addr);
+        emit_trace_record(addr);
+    }
+    auto const opcode_profile = scheduler->opcode_profile();
+    auto const opcode = *addr;
+    if (opcode_profile) {
+        opcode_profile->begin(opcode);
+    }
+    auto const allocation_profile = scheduler->allocation_profile();
+    if (allocation_profile) {
+        allocation_profile->at(&stack->back()->function_name, static_cast<uint64_t>(addr - stack->jump_base));
     }
     switch (static_cast<OPCODE>(*addr)) {
         case IZERO:
@@ -198,6 +151,33 @@ viua::internals::types::byte* viua::process::Process::dispatch(viua::internals::
         case VLEN:
             addr = opvlen(addr + 1);
             break;
+        case VSUM:
+            addr = opvsum(addr + 1);
+            break;
+        case VMIN:
+            addr = opvmin(addr + 1);
+            break;
+        case VMAX:
+            addr = opvmax(addr + 1);
+            break;
+        case VDOT:
+            addr = opvdot(addr + 1);
+            break;
+        case VADD:
+            addr = opvadd(addr + 1);
+            break;
+        case VSUB:
+            addr = opvsub(addr + 1);
+            break;
+        case VMUL:
+            addr = opvmul(addr + 1);
+            break;
+        case VDIV:
+            addr = opvdiv(addr + 1);
+            break;
+        case VSORT:
+            addr = opvsort(addr + 1);
+            break;
         case NOT:
             addr = opnot(addr + 1);
             break;
@@ -444,6 +424,27 @@ viua::internals::types::byte* viua::process::Process::dispatch(viua::internals::
         case STRUCTKEYS:
             addr = opstructkeys(addr + 1);
             break;
+        case DICT:
+            addr = opdict(addr + 1);
+            break;
+        case DICTINSERT:
+            addr = opdictinsert(addr + 1);
+            break;
+        case DICTAT:
+            addr = opdictat(addr + 1);
+            break;
+        case DICTHAS:
+            addr = opdicthas(addr + 1);
+            break;
+        case DICTREMOVE:
+            addr = opdictremove(addr + 1);
+            break;
+        case DICTSIZE:
+            addr = opdictsize(addr + 1);
+            break;
+        case DICTKEYS:
+            addr = opdictkeys(addr + 1);
+            break;
         case NEW:
             addr = opnew(addr + 1);
             break;
@@ -470,5 +471,11 @@ viua::internals::types::byte* viua::process::Process::dispatch(viua::internals::
             }
             throw make_unique<viua::types::Exception>(error.str());
     }
+    if (opcode_profile) {
+        opcode_profile->end(opcode);
+    }
+    if (allocation_profile) {
+        allocation_profile->settle();
+    }
     return addr;
 }
@@ -17,9 +17,12 @@
  *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
 #include <viua/bytecode/bytetypedef.h>
 #include <viua/bytecode/decoder/operands.h>
+#include <viua/kernel/kernel.h>
 #include <viua/process.h>
+#include <viua/scheduler/vps.h>
 #include <viua/support/string.h>
 #include <viua/types/atom.h>
 #include <viua/types/boolean.h>
@@ -30,6 +33,17 @@ viua::internals::types::byte* viua::process::Process::opatom(viua::internals::ty
     viua::kernel::Register* target = nullptr;
     tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
 
+    /*
+     * Atom literals are resolved to interned handles when the bytecode is loaded.
+     * Only literals the kernel did not see (which should not happen) are decoded here.
+     */
+    if (auto resolved = scheduler->atom_literal_at(addr)) {
+        *target = make_unique<viua::types::Atom>(resolved);
+        // the literal in bytecode is encoded so its length may differ from the length of the atom
+        addr += (strlen(reinterpret_cast<const char*>(addr)) + 1);
+        return addr;
+    }
+
     string s;
     tie(addr, s) = viua::bytecode::decoder::operands::fetch_primitive_string(addr, this);
 
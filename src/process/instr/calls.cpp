@@ -228,6 +228,15 @@ viua::internals::types::byte* viua::process::Process::optailcall(viua::internals
     // FIXME tailcalled functions should not inherit local register set of the frame they replace
     stack->back()->arguments = std::move(stack->frame_new->arguments);
 
+    /*
+     * For the call profiler a tail call is a return from the replaced function
+     * followed by a call to the new one made by the same caller.
+     */
+    if (call_profile) {
+        profile_leave(stack->back().get(), (stack->size() > 1 ? stack->at(stack->size() - 2).get() : nullptr));
+        profile_enter(stack->back().get(), call_name);
+    }
+
     // new frame must be deleted to prevent future errors
     // it's a simulated "push-and-pop" from the stack
     stack->frame_new.reset(nullptr);
@@ -171,18 +171,24 @@ viua::internals::types::byte* viua::process::Process::opreceive(viua::internals:
     }
 
     if (not is_hidden) {
-        scheduler->receive(process_id, message_queue);
+        collect_messages();
     }
 
     if (not message_queue.empty()) {
+        record_message_latency();
         if (not target_is_void) {
             *target = std::move(message_queue.front());
         }
         message_queue.pop();
         timeout_active = false;
         wait_until_infinity = false;
+        waiting_for_message = false;
         return_addr = addr;
     } else {
+        if (not waiting_for_message) {
+            waiting_since = std::chrono::steady_clock::now();
+            waiting_for_message = true;
+        }
         if (is_hidden) {
             suspend();
         }
@@ -190,6 +196,7 @@ viua::internals::types::byte* viua::process::Process::opreceive(viua::internals:
             (waiting_until < std::chrono::steady_clock::now())) {
             timeout_active = false;
             wait_until_infinity = false;
+            waiting_for_message = false;
             stack->thrown = make_unique<viua::types::Exception>("no message received");
             return_addr = addr;
         }
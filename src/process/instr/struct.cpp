@@ -92,6 +92,7 @@ viua::internals::types::byte* viua::process::Process::opstructkeys(viua::interna
 
     auto struct_keys = struct_operand->keys();
     auto keys = make_unique<viua::types::Vector>();
+    keys->value().reserve(struct_keys.size());
     for (const auto& each : struct_keys) {
         keys->push(make_unique<viua::types::Atom>(each));
     }
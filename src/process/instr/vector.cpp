@@ -182,3 +182,118 @@ viua::internals::types::byte* viua::process::Process::opvlen(viua::internals::ty
 
     return addr;
 }
+
+viua::internals::types::byte* viua::process::Process::opvsum(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* source = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, source) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = source->sum();
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvmin(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* source = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, source) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = source->min();
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvmax(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* source = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, source) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = source->max();
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvdot(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* lhs = nullptr;
+    viua::types::Vector* rhs = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, lhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+    tie(addr, rhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = lhs->dot(*rhs);
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvadd(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* lhs = nullptr;
+    viua::types::Vector* rhs = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, lhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+    tie(addr, rhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = lhs->add(*rhs);
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvsub(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* lhs = nullptr;
+    viua::types::Vector* rhs = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, lhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+    tie(addr, rhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = lhs->sub(*rhs);
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvmul(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* lhs = nullptr;
+    viua::types::Vector* rhs = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, lhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+    tie(addr, rhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = lhs->mul(*rhs);
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvdiv(viua::internals::types::byte* addr) {
+    viua::kernel::Register* target = nullptr;
+    viua::types::Vector* lhs = nullptr;
+    viua::types::Vector* rhs = nullptr;
+
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_register(addr, this);
+    tie(addr, lhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+    tie(addr, rhs) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    *target = lhs->div(*rhs);
+
+    return addr;
+}
+
+viua::internals::types::byte* viua::process::Process::opvsort(viua::internals::types::byte* addr) {
+    viua::types::Vector* target = nullptr;
+    tie(addr, target) = viua::bytecode::decoder::operands::fetch_object_of<viua::types::Vector>(addr, this);
+
+    target->sort();
+
+    return addr;
+}
@@ -32,6 +32,7 @@ viua::process::Stack::Stack(string fn, Process* pp, viua::kernel::RegisterSet**
       parent_process(pp),
       jump_base(nullptr),
       instruction_pointer(nullptr),
+      verified_code(false),
       frame_new(nullptr),
       try_frame_new(nullptr),
       thrown(nullptr),
@@ -106,6 +107,10 @@ auto viua::process::Stack::pop() -> unique_ptr<Frame> {
     unique_ptr<Frame> frame{std::move(frames.back())};
     frames.pop_back();
 
+    if (parent_process->call_profile) {
+        parent_process->profile_leave(frame.get(), (frames.empty() ? nullptr : frames.back().get()));
+    }
+
     for (viua::internals::types::register_index i = 0; i < frame->arguments->size(); ++i) {
         if (frame->arguments->at(i) != nullptr and frame->arguments->isflagged(i, MOVED)) {
             throw make_unique<viua::types::Exception>("unused pass-by-move parameter");
@@ -129,7 +134,23 @@ auto viua::process::Stack::size() const -> decltype(frames)::size_type { return
 
 auto viua::process::Stack::clear() -> void { frames.clear(); }
 
+auto viua::process::Stack::memory_footprint() const -> std::size_t {
+    auto footprint = (sizeof(Stack) + frames.capacity() * sizeof(decltype(frames)::value_type));
+    for (const auto& each : frames) {
+        footprint += each->memory_footprint();
+    }
+    footprint += (frame_new ? frame_new->memory_footprint() : 0);
+    footprint += (tryframes.size() * sizeof(TryFrame));
+    footprint += (thrown ? thrown->memory_footprint() : 0);
+    footprint += (caught ? caught->memory_footprint() : 0);
+    footprint += (return_value ? return_value->memory_footprint() : 0);
+    return footprint;
+}
+
 auto viua::process::Stack::emplace_back(unique_ptr<Frame> frame) -> decltype(frames.emplace_back(frame)) {
+    if (parent_process->call_profile) {
+        parent_process->profile_enter(frame.get(), frame->function_name);
+    }
     return frames.emplace_back(std::move(frame));
 }
 
@@ -138,6 +159,7 @@ viua::internals::types::byte* viua::process::Stack::adjust_jump_base_for_block(c
     auto ep = scheduler->getEntryPointOfBlock(call_name);
     entry_point = ep.first;
     jump_base = ep.second;
+    verified_code = scheduler->is_verified_code(jump_base);
     return entry_point;
 }
 viua::internals::types::byte* viua::process::Stack::adjust_jump_base_for(const string& call_name) {
@@ -145,6 +167,7 @@ viua::internals::types::byte* viua::process::Stack::adjust_jump_base_for(const s
     auto ep = scheduler->getEntryPointOf(call_name);
     entry_point = ep.first;
     jump_base = ep.second;
+    verified_code = scheduler->is_verified_code(jump_base);
     return entry_point;
 }
 
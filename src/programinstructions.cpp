@@ -225,6 +225,51 @@ Program& Program::opvlen(int_op vec, int_op reg) {
     return (*this);
 }
 
+Program& Program::opvsum(int_op target, int_op vec) {
+    addr_ptr = cg::bytecode::opvsum(addr_ptr, target, vec);
+    return (*this);
+}
+
+Program& Program::opvmin(int_op target, int_op vec) {
+    addr_ptr = cg::bytecode::opvmin(addr_ptr, target, vec);
+    return (*this);
+}
+
+Program& Program::opvmax(int_op target, int_op vec) {
+    addr_ptr = cg::bytecode::opvmax(addr_ptr, target, vec);
+    return (*this);
+}
+
+Program& Program::opvdot(int_op target, int_op lhs, int_op rhs) {
+    addr_ptr = cg::bytecode::opvdot(addr_ptr, target, lhs, rhs);
+    return (*this);
+}
+
+Program& Program::opvadd(int_op target, int_op lhs, int_op rhs) {
+    addr_ptr = cg::bytecode::opvadd(addr_ptr, target, lhs, rhs);
+    return (*this);
+}
+
+Program& Program::opvsub(int_op target, int_op lhs, int_op rhs) {
+    addr_ptr = cg::bytecode::opvsub(addr_ptr, target, lhs, rhs);
+    return (*this);
+}
+
+Program& Program::opvmul(int_op target, int_op lhs, int_op rhs) {
+    addr_ptr = cg::bytecode::opvmul(addr_ptr, target, lhs, rhs);
+    return (*this);
+}
+
+Program& Program::opvdiv(int_op target, int_op lhs, int_op rhs) {
+    addr_ptr = cg::bytecode::opvdiv(addr_ptr, target, lhs, rhs);
+    return (*this);
+}
+
+Program& Program::opvsort(int_op vec) {
+    addr_ptr = cg::bytecode::opvsort(addr_ptr, vec);
+    return (*this);
+}
+
 Program& Program::opnot(int_op target, int_op source) {
     addr_ptr = cg::bytecode::opnot(addr_ptr, target, source);
     return (*this);
@@ -865,6 +910,41 @@ Program& Program::opstructkeys(int_op a, int_op b) {
     return (*this);
 }
 
+Program& Program::opdict(int_op regno) {
+    addr_ptr = cg::bytecode::opdict(addr_ptr, regno);
+    return (*this);
+}
+
+Program& Program::opdictinsert(int_op target, int_op key, int_op source) {
+    addr_ptr = cg::bytecode::opdictinsert(addr_ptr, target, key, source);
+    return (*this);
+}
+
+Program& Program::opdictat(int_op target, int_op source, int_op key) {
+    addr_ptr = cg::bytecode::opdictat(addr_ptr, target, source, key);
+    return (*this);
+}
+
+Program& Program::opdicthas(int_op target, int_op source, int_op key) {
+    addr_ptr = cg::bytecode::opdicthas(addr_ptr, target, source, key);
+    return (*this);
+}
+
+Program& Program::opdictremove(int_op target, int_op source, int_op key) {
+    addr_ptr = cg::bytecode::opdictremove(addr_ptr, target, source, key);
+    return (*this);
+}
+
+Program& Program::opdictsize(int_op target, int_op source) {
+    addr_ptr = cg::bytecode::opdictsize(addr_ptr, target, source);
+    return (*this);
+}
+
+Program& Program::opdictkeys(int_op target, int_op source) {
+    addr_ptr = cg::bytecode::opdictkeys(addr_ptr, target, source);
+    return (*this);
+}
+
 Program& Program::opnew(int_op reg, const string& class_name) {
     addr_ptr = cg::bytecode::opnew(addr_ptr, reg, class_name);
     return (*this);
@@ -58,6 +58,7 @@ void viua::scheduler::ffi::ForeignFunctionCallRequest::call(ForeignFunction* cal
         caller_process->raise(std::move(exception));
         caller_process->handleActiveException();
     }
+    caller_process->profile_foreign_call_finished(frame.get());
 }
 void viua::scheduler::ffi::ForeignFunctionCallRequest::raise(unique_ptr<viua::types::Value> object) {
     caller_process->raise(std::move(object));
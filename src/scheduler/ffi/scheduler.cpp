@@ -29,7 +29,8 @@ using namespace std;
 
 void viua::scheduler::ffi::ff_call_processor(
     vector<unique_ptr<viua::scheduler::ffi::ForeignFunctionCallRequest>>* requests,
-    map<string, ForeignFunction*>* foreign_functions, mutex* ff_map_mtx, mutex* mtx, condition_variable* cv) {
+    const viua::util::Published<viua::util::PersistentMap<string, ForeignFunction*>>* foreign_functions,
+    mutex* mtx, condition_variable* cv) {
     while (true) {
         unique_lock<mutex> lock(*mtx);
 
@@ -50,14 +51,12 @@ void viua::scheduler::ffi::ff_call_processor(
         }
 
         string call_name = request->functionName();
-        unique_lock<mutex> ff_map_lock(*ff_map_mtx);
-        if (foreign_functions->count(call_name) == 0) {
+        auto functions = foreign_functions->load();
+        if (functions->count(call_name) == 0) {
             request->raise(
                 make_unique<viua::types::Exception>("call to unregistered foreign function: " + call_name));
         } else {
-            auto function = foreign_functions->at(call_name);
-            ff_map_lock.unlock();  // unlock the mutex - foreign call can block for unspecified period of time
-            request->call(function);
+            request->call(functions->at(call_name));
         }
 
         request->wakeup();
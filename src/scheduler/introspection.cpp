@@ -0,0 +1,363 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <viua/kernel/kernel.h>
+#include <viua/scheduler/introspection.h>
+using namespace std;
+
+
+using viua::scheduler::introspection::Board;
+using viua::scheduler::introspection::Server;
+using viua::scheduler::introspection::Snapshot;
+
+viua::scheduler::introspection::Board::Board() : latest(make_shared<const Snapshot>()) {}
+
+auto Board::request() -> uint64_t { return (requested_generation.fetch_add(1, memory_order_acq_rel) + 1); }
+auto Board::requested() const -> uint64_t { return requested_generation.load(memory_order_acquire); }
+auto Board::published() const -> uint64_t { return published_generation.load(memory_order_acquire); }
+
+auto Board::wanted() const -> bool { return (requested() > published()); }
+
+auto Board::publish(Snapshot snapshot, const uint64_t generation) -> void {
+    atomic_store_explicit(&latest, shared_ptr<const Snapshot>(make_shared<Snapshot>(std::move(snapshot))),
+                          memory_order_release);
+    published_generation.store(generation, memory_order_release);
+}
+
+auto Board::load() const -> shared_ptr<const Snapshot> {
+    return atomic_load_explicit(&latest, memory_order_acquire);
+}
+
+
+// how long a query waits for schedulers to publish fresh snapshots
+static const auto SNAPSHOT_WAIT = chrono::milliseconds{100};
+
+// how often the server thread checks if it should stop (in milliseconds, for poll())
+static const int POLL_INTERVAL = 100;
+
+// clients that stay silent for this long are disconnected so that they do not keep others out
+static const auto CLIENT_IDLE_LIMIT = chrono::seconds{10};
+
+// longest accepted query
+static const string::size_type QUERY_LIMIT = 4096;
+
+static const string HELP = "processes      list processes with their state, priority, mailbox depth,\n"
+                           "               scheduler, stack depth, and the function they are in\n"
+                           "stack <pid>    show the stack of a process\n"
+                           "modules        list linked modules\n"
+                           "foreign        list foreign functions\n"
+                           "schedulers     show statistics of schedulers\n"
+                           "quit           close the connection\n";
+
+static auto milliseconds_between(const chrono::steady_clock::time_point since,
+                                 const chrono::steady_clock::time_point until) -> int64_t {
+    return chrono::duration_cast<chrono::milliseconds>(until - since).count();
+}
+
+static auto send_all(const int peer, const string& data) -> bool {
+    auto sent = string::size_type{0};
+    while (sent < data.size()) {
+        auto const n = ::send(peer, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n == -1 and errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<string::size_type>(n);
+    }
+    return true;
+}
+
+
+auto Server::snapshots() -> vector<shared_ptr<const Snapshot>> {
+    vector<uint64_t> generations;
+    for (const auto& each : boards) {
+        generations.push_back(each->request());
+    }
+
+    auto fresh = [this, &generations]() -> bool {
+        for (decltype(generations)::size_type i = 0; i < generations.size(); ++i) {
+            if (boards.at(i)->published() < generations.at(i)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto const deadline = (chrono::steady_clock::now() + SNAPSHOT_WAIT);
+    while (not fresh() and chrono::steady_clock::now() < deadline) {
+        this_thread::sleep_for(chrono::milliseconds{1});
+    }
+
+    vector<shared_ptr<const Snapshot>> taken;
+    for (const auto& each : boards) {
+        taken.push_back(each->load());
+    }
+    return taken;
+}
+
+auto Server::list_processes() -> string {
+    auto const taken = snapshots();
+    auto const now = chrono::steady_clock::now();
+
+    // messages that were sent but are not yet taken by their receivers
+    map<string, size_t> mailboxes;
+    for (const auto& each : kernel.mailbox_depths()) {
+        mailboxes[each.pid.str()] = each.depth;
+    }
+
+    ostringstream out;
+    out << left << setw(24) << "pid" << setw(11) << "scheduler" << setw(13) << "state" << setw(10) << "priority"
+        << setw(9) << "mailbox" << setw(7) << "stack"
+        << "function\n";
+    for (decltype(taken)::size_type i = 0; i < taken.size(); ++i) {
+        for (const auto& each : taken.at(i)->processes) {
+            auto const mailbox = mailboxes.find(each.pid);
+            out << setw(24) << each.pid << setw(11) << i << setw(13) << each.state << setw(10) << each.priority
+                << setw(9) << (each.queued_messages + (mailbox == mailboxes.end() ? 0 : mailbox->second))
+                << setw(7) << each.stack.size() << (each.stack.empty() ? string{"-"} : each.stack.back())
+                << '\n';
+        }
+    }
+    for (decltype(taken)::size_type i = 0; i < taken.size(); ++i) {
+        auto const age = milliseconds_between(taken.at(i)->taken_at, now);
+        if (age >= SNAPSHOT_WAIT.count()) {
+            out << "note: processes of scheduler " << i << " are shown as they were " << age
+                << " ms ago (the scheduler did not answer in time)\n";
+        }
+    }
+    return out.str();
+}
+
+auto Server::stack_of(const string& pid) -> string {
+    if (pid.empty()) {
+        return "error: expected a pid\n";
+    }
+
+    auto const taken = snapshots();
+    for (decltype(taken)::size_type i = 0; i < taken.size(); ++i) {
+        for (const auto& each : taken.at(i)->processes) {
+            if (each.pid != pid) {
+                continue;
+            }
+
+            ostringstream out;
+            out << "process " << pid << " on scheduler " << i << " (" << each.state
+                << "), most recent call last:\n";
+            for (const auto& frame : each.stack) {
+                out << "  " << frame << '\n';
+            }
+            return out.str();
+        }
+    }
+    return ("error: no such process: " + pid + '\n');
+}
+
+auto Server::list_modules() const -> string {
+    ostringstream out;
+    for (const auto& each : kernel.linked_module_names()) {
+        out << each << '\n';
+    }
+    for (const auto& each : kernel.pending_module_names()) {
+        out << each << " (not linked until first used)\n";
+    }
+    return out.str();
+}
+
+auto Server::list_foreign_functions() const -> string {
+    ostringstream out;
+    for (const auto& each : kernel.foreign_function_names()) {
+        out << each << '\n';
+    }
+    return out.str();
+}
+
+auto Server::list_schedulers() -> string {
+    ostringstream out;
+    out << "vp schedulers: " << boards.size() << '\n';
+    out << "ffi schedulers: " << kernel.no_of_ffi_schedulers() << '\n';
+    out << "processes: " << kernel.pids() << '\n';
+
+    auto const counters = kernel.telemetry();
+    out << left << setw(11) << "scheduler" << right << setw(10) << "run queue" << setw(7) << "load" << setw(11)
+        << "bursts" << setw(13) << "quants" << setw(15) << "ticks" << setw(12) << "busy ms" << setw(12)
+        << "idle ms" << setw(10) << "spawned" << setw(10) << "posted" << setw(10) << "grabbed" << setw(11)
+        << "ffi calls" << setw(12) << "memory KiB" << '\n';
+    for (decltype(counters)::size_type i = 0; i < counters.size(); ++i) {
+        const auto& each = *counters.at(i);
+        auto value = [](const atomic<uint64_t>& counter) -> uint64_t {
+            return counter.load(memory_order_relaxed);
+        };
+        out << left << setw(11) << i << right << setw(10) << value(each.run_queue) << setw(7)
+            << value(each.load) << setw(11) << value(each.bursts) << setw(13) << value(each.quants) << setw(15)
+            << value(each.ticks) << setw(12) << (value(each.busy_ns) / 1000000) << setw(12)
+            << (value(each.idle_ns) / 1000000) << setw(10) << value(each.spawned) << setw(10)
+            << value(each.posted) << setw(10) << value(each.grabbed) << setw(11) << value(each.ffi_calls)
+            << setw(12) << (value(each.process_memory) / 1024) << '\n';
+    }
+    return out.str();
+}
+
+auto Server::answer(const string& query) -> string {
+    istringstream words(query);
+    string command;
+    string argument;
+    words >> command >> argument;
+
+    if (command == "processes") {
+        return list_processes();
+    } else if (command == "stack") {
+        return stack_of(argument);
+    } else if (command == "modules") {
+        return list_modules();
+    } else if (command == "foreign") {
+        return list_foreign_functions();
+    } else if (command == "schedulers") {
+        return list_schedulers();
+    } else if (command == "help" or command.empty()) {
+        return HELP;
+    }
+    return ("error: unknown query: " + command + " (try: help)\n");
+}
+
+
+auto Server::converse(const int peer) -> void {
+    string buffered;
+    auto last_heard_from = chrono::steady_clock::now();
+    char chunk[512];
+
+    while (not done.load(memory_order_acquire)) {
+        pollfd waiting{peer, POLLIN, 0};
+        auto const ready = poll(&waiting, 1, POLL_INTERVAL);
+        if (ready == -1 and errno == EINTR) {
+            continue;
+        }
+        if (ready == -1) {
+            return;
+        }
+        if (ready == 0) {
+            if ((chrono::steady_clock::now() - last_heard_from) > CLIENT_IDLE_LIMIT) {
+                return;
+            }
+            continue;
+        }
+
+        auto const n = read(peer, chunk, sizeof(chunk));
+        if (n <= 0) {
+            return;
+        }
+        last_heard_from = chrono::steady_clock::now();
+        buffered.append(chunk, static_cast<string::size_type>(n));
+
+        auto end_of_line = buffered.find('\n');
+        while (end_of_line != string::npos) {
+            auto query = buffered.substr(0, end_of_line);
+            buffered.erase(0, end_of_line + 1);
+            if (query.size() and query.back() == '\r') {
+                query.pop_back();
+            }
+            if (query == "quit") {
+                return;
+            }
+            if (not send_all(peer, answer(query) + '\n')) {
+                return;
+            }
+            end_of_line = buffered.find('\n');
+        }
+        if (buffered.size() > QUERY_LIMIT) {
+            send_all(peer, "error: query too long\n\n");
+            return;
+        }
+    }
+}
+
+auto Server::serve() -> void {
+    while (not done.load(memory_order_acquire)) {
+        pollfd waiting{listening_socket, POLLIN, 0};
+        if (poll(&waiting, 1, POLL_INTERVAL) < 1) {
+            continue;
+        }
+
+        auto const peer = accept4(listening_socket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (peer == -1) {
+            continue;
+        }
+        converse(peer);
+        close(peer);
+    }
+}
+
+auto Server::start() -> void {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << ("error: introspection socket path is too long: " + path + '\n');
+        return;
+    }
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, path.size());
+
+    // a socket left behind by a kernel that did not exit cleanly, but never any other kind of file
+    struct stat existing;
+    if (lstat(path.c_str(), &existing) == 0 and S_ISSOCK(existing.st_mode)) {
+        unlink(path.c_str());
+    }
+
+    listening_socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listening_socket == -1 or
+        bind(listening_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) or
+        listen(listening_socket, 4)) {
+        cerr << ("error: cannot serve introspection queries on " + path + ": " + strerror(errno) + '\n');
+        if (listening_socket != -1) {
+            close(listening_socket);
+            listening_socket = -1;
+        }
+        return;
+    }
+
+    server_thread = thread([this]() -> void { serve(); });
+}
+
+auto Server::stop() -> void {
+    done.store(true, memory_order_release);
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+    if (listening_socket != -1) {
+        close(listening_socket);
+        listening_socket = -1;
+        unlink(path.c_str());
+    }
+}
+
+viua::scheduler::introspection::Server::Server(viua::kernel::Kernel& k, const vector<unique_ptr<Board>>& b,
+                                               string p)
+    : kernel(k), boards(b), path(std::move(p)), listening_socket(-1), done(false) {}
+
+viua::scheduler::introspection::Server::~Server() { stop(); }
@@ -0,0 +1,361 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <vector>
+#include <viua/bytecode/maps.h>
+#include <viua/kernel/frame.h>
+#include <viua/scheduler/profiling.h>
+using namespace std;
+
+
+using Entry = viua::scheduler::profiling::OpcodeProfile::Entry;
+
+static auto opcode_name(const std::size_t opcode) -> string {
+    auto found = OP_NAMES.find(static_cast<OPCODE>(opcode));
+    return (found == OP_NAMES.end() ? ("<byte " + to_string(opcode) + ">") : found->second);
+}
+
+static auto mean_cycles(const Entry& entry) -> double {
+    return (entry.samples ? (static_cast<double>(entry.cycles) / static_cast<double>(entry.samples)) : 0.0);
+}
+
+static auto executed_opcodes(const array<Entry, 256>& entries) -> vector<pair<string, Entry>> {
+    vector<pair<string, Entry>> executed;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].executions) {
+            executed.emplace_back(opcode_name(i), entries[i]);
+        }
+    }
+    stable_sort(executed.begin(), executed.end(),
+                [](const pair<string, Entry>& lhs, const pair<string, Entry>& rhs) -> bool {
+                    return (lhs.second.executions > rhs.second.executions);
+                });
+    return executed;
+}
+
+
+auto viua::scheduler::profiling::OpcodeProfile::merge(const OpcodeProfile& that) -> void {
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        entries[i].executions += that.entries[i].executions;
+        entries[i].samples += that.entries[i].samples;
+        entries[i].cycles += that.entries[i].cycles;
+    }
+}
+
+auto viua::scheduler::profiling::OpcodeProfile::write_table(ostream& out) const -> void {
+    uint64_t total = 0;
+    for (const auto& each : entries) {
+        total += each.executions;
+    }
+
+    out << left << setw(16) << "opcode" << right << setw(16) << "executions" << setw(10) << "share"
+        << setw(12) << "samples" << setw(14) << "mean cycles" << '\n';
+    for (const auto& each : executed_opcodes(entries)) {
+        out << left << setw(16) << each.first << right << setw(16) << each.second.executions;
+        out << setw(9) << fixed << setprecision(2)
+            << (100.0 * static_cast<double>(each.second.executions) / static_cast<double>(total)) << '%';
+        out << setw(12) << each.second.samples;
+        out << setw(14) << fixed << setprecision(1) << mean_cycles(each.second) << '\n';
+    }
+    out << left << setw(16) << "total" << right << setw(16) << total << '\n';
+}
+
+auto viua::scheduler::profiling::OpcodeProfile::write_json(ostream& out) const -> void {
+    out << "{\"opcodes\": [";
+    auto first = true;
+    for (const auto& each : executed_opcodes(entries)) {
+        out << (first ? "" : ", ");
+        out << "{\"opcode\": \"" << each.first << "\"";
+        out << ", \"executions\": " << each.second.executions;
+        out << ", \"samples\": " << each.second.samples;
+        out << ", \"cycles\": " << each.second.cycles;
+        out << ", \"mean_cycles\": " << fixed << setprecision(1) << mean_cycles(each.second) << "}";
+        first = false;
+    }
+    out << "]}\n";
+}
+
+viua::scheduler::profiling::OpcodeProfile::OpcodeProfile(const uint64_t interval)
+    : entries{}, sampling_interval(interval), until_next_sample(interval), sample_started(0), sampling(false) {}
+
+
+auto viua::scheduler::profiling::StackProfile::record(const string& stack) -> void { ++stacks[stack]; }
+
+auto viua::scheduler::profiling::StackProfile::merge(const StackProfile& that) -> void {
+    for (const auto& each : that.stacks) {
+        stacks[each.first] += each.second;
+    }
+}
+
+auto viua::scheduler::profiling::StackProfile::write_collapsed(ostream& out) const -> void {
+    // sorted so that profiles of the same workload are easy to diff
+    vector<pair<string, uint64_t>> sorted(stacks.begin(), stacks.end());
+    sort(sorted.begin(), sorted.end());
+    for (const auto& each : sorted) {
+        out << each.first << ' ' << each.second << '\n';
+    }
+}
+
+viua::scheduler::profiling::StackProfile::StackProfile(const std::chrono::microseconds sampling_interval)
+    : interval(sampling_interval), next_sample_at(std::chrono::steady_clock::now() + sampling_interval) {}
+
+
+auto viua::scheduler::profiling::AllocationProfile::account(const Pending& allocation, const string& type)
+    -> void {
+    auto& by_type = types[type];
+    by_type.count += sampling_interval;
+    by_type.bytes += (allocation.size * sampling_interval);
+
+    auto& by_site = sites[make_tuple(allocation.function, allocation.offset, type)];
+    by_site.count += sampling_interval;
+    by_site.bytes += (allocation.size * sampling_interval);
+}
+
+auto viua::scheduler::profiling::AllocationProfile::settle_pending() -> void {
+    for (const auto& each : pending) {
+        account(each, each.value->type());
+    }
+    pending.clear();
+}
+
+auto viua::scheduler::profiling::AllocationProfile::allocated(viua::types::Value* value,
+                                                              const std::size_t size) -> void {
+    if (--until_next_sample) {
+        return;
+    }
+    until_next_sample = sampling_interval;
+    pending.push_back(Pending{value, size, (site_function ? *site_function : string{"(vm)"}), site_offset});
+}
+
+auto viua::scheduler::profiling::AllocationProfile::released(viua::types::Value* value) -> void {
+    // values are usually freed in reverse order of allocation
+    for (auto each = pending.rbegin(); each != pending.rend(); ++each) {
+        if (each->value == value) {
+            account(*each, "(temporary)");
+            pending.erase(std::next(each).base());
+            return;
+        }
+    }
+}
+
+auto viua::scheduler::profiling::AllocationProfile::merge(const AllocationProfile& that) -> void {
+    for (const auto& each : that.types) {
+        types[each.first].count += each.second.count;
+        types[each.first].bytes += each.second.bytes;
+    }
+    for (const auto& each : that.sites) {
+        sites[each.first].count += each.second.count;
+        sites[each.first].bytes += each.second.bytes;
+    }
+}
+
+auto viua::scheduler::profiling::AllocationProfile::write_report(ostream& out) const -> void {
+    using AllocationEntry = viua::scheduler::profiling::AllocationProfile::Entry;
+    auto by_bytes = [](const auto& lhs, const auto& rhs) -> bool {
+        return (lhs.second.bytes > rhs.second.bytes or
+                (lhs.second.bytes == rhs.second.bytes and lhs.first < rhs.first));
+    };
+
+    if (sampling_interval > 1) {
+        out << "# one in every " << sampling_interval
+            << " allocations sampled, counts and sizes are estimates\n";
+    }
+
+    vector<pair<string, AllocationEntry>> sorted_types(types.begin(), types.end());
+    sort(sorted_types.begin(), sorted_types.end(), by_bytes);
+    out << left << setw(24) << "type" << right << setw(16) << "allocations" << setw(16) << "bytes" << '\n';
+    for (const auto& each : sorted_types) {
+        out << left << setw(24) << each.first << right << setw(16) << each.second.count << setw(16)
+            << each.second.bytes << '\n';
+    }
+
+    vector<pair<tuple<string, uint64_t, string>, AllocationEntry>> sorted_sites(sites.begin(), sites.end());
+    sort(sorted_sites.begin(), sorted_sites.end(), by_bytes);
+    out << '\n';
+    out << left << setw(40) << "site" << setw(24) << "type" << right << setw(16) << "allocations"
+        << setw(16) << "bytes" << '\n';
+    for (const auto& each : sorted_sites) {
+        auto site = get<0>(each.first);
+        if (site != "(vm)") {
+            ostringstream offset;
+            offset << "+0x" << hex << get<1>(each.first);
+            site += offset.str();
+        }
+        out << left << setw(40) << site << setw(24) << get<2>(each.first) << right << setw(16)
+            << each.second.count << setw(16) << each.second.bytes << '\n';
+    }
+}
+
+viua::scheduler::profiling::AllocationProfile::AllocationProfile(const uint64_t interval)
+    : types{},
+      sites{},
+      pending{},
+      sampling_interval(interval ? interval : 1),
+      until_next_sample(sampling_interval),
+      site_function(nullptr),
+      site_offset(0) {}
+
+
+auto viua::scheduler::profiling::CallProfile::enter(Frame* frame, const string& function_name,
+                                                    const uint64_t running, const uint64_t wall) -> void {
+    frame->profiled_function_name = function_name;
+    frame->entered_running_at = running;
+    frame->entered_wall_at = wall;
+    frame->callees_running_time = 0;
+    frame->profiled = true;
+}
+
+auto viua::scheduler::profiling::CallProfile::leave(Frame* callee, Frame* caller, const uint64_t running,
+                                                    const uint64_t wall) -> void {
+    if (not callee->profiled) {
+        return;
+    }
+    callee->profiled = false;
+
+    auto const inclusive = (running - callee->entered_running_at);
+    auto const waiting = ((wall - callee->entered_wall_at) - inclusive);
+
+    auto& entry = functions[callee->profiled_function_name];
+    ++entry.calls;
+    entry.inclusive += inclusive;
+    entry.exclusive += (inclusive - std::min(inclusive, callee->callees_running_time));
+    entry.waiting += waiting;
+
+    auto& arc = arcs[make_pair((caller ? caller->profiled_function_name : string{"(process)"}),
+                               callee->profiled_function_name)];
+    ++arc.calls;
+    arc.inclusive += inclusive;
+    arc.waiting += waiting;
+
+    if (caller) {
+        caller->callees_running_time += inclusive;
+    }
+}
+
+static auto merge_entry(viua::scheduler::profiling::CallProfile::Entry& into,
+                        const viua::scheduler::profiling::CallProfile::Entry& from) -> void {
+    into.calls += from.calls;
+    into.inclusive += from.inclusive;
+    into.exclusive += from.exclusive;
+    into.waiting += from.waiting;
+}
+
+auto viua::scheduler::profiling::CallProfile::merge(const CallProfile& that) -> void {
+    for (const auto& each : that.functions) {
+        merge_entry(functions[each.first], each.second);
+    }
+    for (const auto& each : that.arcs) {
+        merge_entry(arcs[each.first], each.second);
+    }
+}
+
+
+auto viua::scheduler::profiling::CallProfiles::record(const string& process, const CallProfile& profile)
+    -> void {
+    all.merge(profile);
+    auto& by_process = processes[process];
+    ++by_process.first;
+    by_process.second.merge(profile);
+}
+
+auto viua::scheduler::profiling::CallProfiles::merge(const CallProfiles& that) -> void {
+    all.merge(that.all);
+    for (const auto& each : that.processes) {
+        auto& by_process = processes[each.first];
+        by_process.first += each.second.first;
+        by_process.second.merge(each.second.second);
+    }
+}
+
+using CallEntry = viua::scheduler::profiling::CallProfile::Entry;
+
+static auto milliseconds(const uint64_t nanoseconds) -> double {
+    return (static_cast<double>(nanoseconds) / 1e6);
+}
+
+static auto by_exclusive_time(const unordered_map<string, CallEntry>& functions)
+    -> vector<pair<string, CallEntry>> {
+    vector<pair<string, CallEntry>> sorted(functions.begin(), functions.end());
+    sort(sorted.begin(), sorted.end(),
+         [](const pair<string, CallEntry>& lhs, const pair<string, CallEntry>& rhs) -> bool {
+             return (lhs.second.exclusive > rhs.second.exclusive or
+                     (lhs.second.exclusive == rhs.second.exclusive and lhs.first < rhs.first));
+         });
+    return sorted;
+}
+
+static auto write_flat_profile(ostream& out, const unordered_map<string, CallEntry>& functions) -> void {
+    uint64_t total = 0;
+    for (const auto& each : functions) {
+        total += each.second.exclusive;
+    }
+
+    out << right << setw(8) << "% time" << setw(14) << "exclusive ms" << setw(14) << "inclusive ms"
+        << setw(14) << "waiting ms" << setw(12) << "calls" << setw(14) << "us/call" << "  " << "name\n";
+    for (const auto& each : by_exclusive_time(functions)) {
+        auto const& entry = each.second;
+        out << fixed << setprecision(2) << setw(8)
+            << (total ? (100.0 * static_cast<double>(entry.exclusive) / static_cast<double>(total)) : 0.0);
+        out << setprecision(3) << setw(14) << milliseconds(entry.exclusive) << setw(14)
+            << milliseconds(entry.inclusive) << setw(14) << milliseconds(entry.waiting);
+        out << setw(12) << entry.calls;
+        out << setw(14)
+            << (static_cast<double>(entry.inclusive) / 1e3 / static_cast<double>(std::max<uint64_t>(entry.calls, 1)));
+        out << "  " << each.first << '\n';
+    }
+}
+
+auto viua::scheduler::profiling::CallProfiles::write_report(ostream& out) const -> void {
+    out << "Flat profile (all processes):\n\n";
+    write_flat_profile(out, all.functions);
+
+    /*  Call graph lists every function with its callers above it, and the functions
+     *  it called below it.
+     */
+    out << "\nCall graph (all processes):\n\n";
+    out << right << setw(12) << "calls" << setw(14) << "inclusive ms" << setw(14) << "waiting ms" << "  "
+        << "name\n";
+    for (const auto& each : by_exclusive_time(all.functions)) {
+        for (const auto& arc : all.arcs) {
+            if (arc.first.second == each.first) {
+                out << setw(12) << arc.second.calls << setw(14) << fixed << setprecision(3)
+                    << milliseconds(arc.second.inclusive) << setw(14) << milliseconds(arc.second.waiting)
+                    << "      " << arc.first.first << '\n';
+            }
+        }
+        out << setw(12) << each.second.calls << setw(14) << milliseconds(each.second.inclusive) << setw(14)
+            << milliseconds(each.second.waiting) << "  " << each.first << '\n';
+        for (const auto& arc : all.arcs) {
+            if (arc.first.first == each.first) {
+                out << setw(12) << arc.second.calls << setw(14) << milliseconds(arc.second.inclusive)
+                    << setw(14) << milliseconds(arc.second.waiting) << "      " << arc.first.second << '\n';
+            }
+        }
+        out << string(60, '-') << '\n';
+    }
+
+    for (const auto& each : processes) {
+        out << "\nFlat profile (" << each.second.first << " process" << (each.second.first == 1 ? "" : "es")
+            << " started with " << each.first << "):\n\n";
+        write_flat_profile(out, each.second.second.functions);
+    }
+}
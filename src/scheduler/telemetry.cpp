@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <functional>
+#include <string>
+#include <viua/scheduler/telemetry.h>
+using namespace std;
+
+
+auto viua::scheduler::telemetry::Histogram::record(const std::chrono::steady_clock::duration duration)
+    -> void {
+    auto const ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    bump(count);
+    bump(sum_ns, ns);
+    if (ns > max_ns.load(std::memory_order_relaxed)) {
+        max_ns.store(ns, std::memory_order_relaxed);
+    }
+
+    auto bucket = decltype(DURATION_BUCKETS)::size_type{0};
+    while (bucket < DURATION_BUCKETS.size() and (ns / 1000) >= DURATION_BUCKETS[bucket]) {
+        ++bucket;
+    }
+    bump(buckets[bucket]);
+}
+
+auto viua::scheduler::telemetry::Counters::record_burst(const std::chrono::steady_clock::duration duration)
+    -> void {
+    bump(bursts);
+    bump(busy_ns, duration);
+    burst_duration.record(duration);
+}
+
+
+using viua::scheduler::telemetry::Counters;
+using viua::scheduler::telemetry::Histogram;
+
+static auto write_metric(ostream& out, const string& name, const string& type, const string& help,
+                         const vector<const Counters*>& schedulers,
+                         function<uint64_t(const Counters&)> value) -> void {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+    for (vector<const Counters*>::size_type i = 0; i < schedulers.size(); ++i) {
+        out << name << "{scheduler=\"" << i << "\"} " << value(*schedulers[i]) << '\n';
+    }
+}
+
+static auto write_seconds(ostream& out, const string& name, const string& help,
+                          const vector<const Counters*>& schedulers,
+                          function<uint64_t(const Counters&)> ns) -> void {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << " counter\n";
+    for (vector<const Counters*>::size_type i = 0; i < schedulers.size(); ++i) {
+        out << name << "{scheduler=\"" << i << "\"} " << (static_cast<double>(ns(*schedulers[i])) / 1e9)
+            << '\n';
+    }
+}
+
+static auto write_histogram(ostream& out, const string& name, const string& help,
+                            const vector<const Counters*>& schedulers,
+                            function<const Histogram&(const Counters&)> histogram_of) -> void {
+    using viua::scheduler::telemetry::DURATION_BUCKETS;
+    auto const relaxed = std::memory_order_relaxed;
+
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << " histogram\n";
+    for (vector<const Counters*>::size_type i = 0; i < schedulers.size(); ++i) {
+        auto const& histogram = histogram_of(*schedulers[i]);
+        auto const label = ("scheduler=\"" + to_string(i) + "\"");
+        uint64_t cumulative = 0;
+        for (decltype(DURATION_BUCKETS)::size_type b = 0; b < DURATION_BUCKETS.size(); ++b) {
+            cumulative += histogram.buckets[b].load(relaxed);
+            out << name << "_bucket{" << label << ",le=\"" << (static_cast<double>(DURATION_BUCKETS[b]) / 1e6)
+                << "\"} " << cumulative << '\n';
+        }
+        cumulative += histogram.buckets.back().load(relaxed);
+        out << name << "_bucket{" << label << ",le=\"+Inf\"} " << cumulative << '\n';
+        out << name << "_sum{" << label << "} " << (static_cast<double>(histogram.sum_ns.load(relaxed)) / 1e9)
+            << '\n';
+        out << name << "_count{" << label << "} " << histogram.count.load(relaxed) << '\n';
+    }
+}
+
+auto viua::scheduler::telemetry::write_prometheus(ostream& out, const vector<const Counters*>& schedulers)
+    -> void {
+    auto const relaxed = std::memory_order_relaxed;
+
+    write_metric(out, "viua_scheduler_bursts_total", "counter", "Bursts run by the scheduler.", schedulers,
+                 [relaxed](const Counters& c) { return c.bursts.load(relaxed); });
+    write_metric(out, "viua_scheduler_quants_total", "counter", "Quants processes were run for.", schedulers,
+                 [relaxed](const Counters& c) { return c.quants.load(relaxed); });
+    write_metric(out, "viua_scheduler_ticks_total", "counter", "Instructions executed.", schedulers,
+                 [relaxed](const Counters& c) { return c.ticks.load(relaxed); });
+    write_seconds(out, "viua_scheduler_busy_seconds_total", "Time spent running bursts.", schedulers,
+                  [relaxed](const Counters& c) { return c.busy_ns.load(relaxed); });
+    write_seconds(out, "viua_scheduler_idle_seconds_total", "Time spent sleeping or waiting for processes.",
+                  schedulers, [relaxed](const Counters& c) { return c.idle_ns.load(relaxed); });
+    write_metric(out, "viua_scheduler_spawned_total", "counter", "Processes spawned.", schedulers,
+                 [relaxed](const Counters& c) { return c.spawned.load(relaxed); });
+    write_metric(out, "viua_scheduler_posted_total", "counter", "Processes posted to the kernel.", schedulers,
+                 [relaxed](const Counters& c) { return c.posted.load(relaxed); });
+    write_metric(out, "viua_scheduler_grabbed_total", "counter", "Processes taken from the kernel.",
+                 schedulers, [relaxed](const Counters& c) { return c.grabbed.load(relaxed); });
+    write_metric(out, "viua_scheduler_ffi_calls_total", "counter",
+                 "Foreign calls processes were suspended for.", schedulers,
+                 [relaxed](const Counters& c) { return c.ffi_calls.load(relaxed); });
+    write_metric(out, "viua_scheduler_run_queue", "gauge", "Processes owned by the scheduler.", schedulers,
+                 [relaxed](const Counters& c) { return c.run_queue.load(relaxed); });
+    write_metric(out, "viua_scheduler_load", "gauge", "Processes that were runnable after the last burst.",
+                 schedulers, [relaxed](const Counters& c) { return c.load.load(relaxed); });
+    write_metric(out, "viua_scheduler_process_memory_bytes", "gauge",
+                 "Bytes of values allocated by processes of the scheduler.", schedulers,
+                 [relaxed](const Counters& c) { return c.process_memory.load(relaxed); });
+
+    write_histogram(out, "viua_scheduler_burst_duration_seconds", "Duration of bursts.", schedulers,
+                    [](const Counters& c) -> const Histogram& { return c.burst_duration; });
+    write_histogram(out, "viua_message_latency_seconds", "Time messages spent queued before being received.",
+                    schedulers, [](const Counters& c) -> const Histogram& { return c.message_latency; });
+}
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstring>
+#include <viua/machine.h>
+#include <viua/scheduler/tracing.h>
+using namespace std;
+
+
+viua::scheduler::tracing::Sink::Sink(const string& path)
+    : out(path, ios::out | ios::binary | ios::trunc),
+      buffers(0),
+      closing(false),
+      started(std::chrono::steady_clock::now()) {
+    if (not out) {
+        throw("cannot open trace file: " + path);
+    }
+
+    out.write(VIUA_TRACE_MAGIC, static_cast<std::streamsize>(strlen(VIUA_TRACE_MAGIC) + 1));
+    const auto record_size = static_cast<uint32_t>(sizeof(Record));
+    out.write(reinterpret_cast<const char*>(&TRACE_FORMAT_VERSION), sizeof(TRACE_FORMAT_VERSION));
+    out.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+
+    writer = thread([this] { write_buffers(); });
+}
+
+viua::scheduler::tracing::Sink::~Sink() {
+    {
+        unique_lock<mutex> lck{queue_mtx};
+        closing = true;
+    }
+    queue_cv.notify_one();
+    writer.join();
+    out.flush();
+}
+
+auto viua::scheduler::tracing::Sink::write_buffers() -> void {
+    unique_lock<mutex> lck{queue_mtx};
+    while (true) {
+        queue_cv.wait(lck, [this] { return (closing or not written.empty()); });
+        if (written.empty()) {
+            return;
+        }
+
+        auto buffer = std::move(written.front());
+        written.pop();
+
+        // the disk is written to without holding the lock so schedulers can keep
+        // submitting buffers
+        lck.unlock();
+        out.write(reinterpret_cast<const char*>(buffer.first.data()),
+                  static_cast<std::streamsize>(buffer.second * sizeof(Record)));
+        lck.lock();
+
+        spare.push_back(std::move(buffer.first));
+    }
+}
+
+auto viua::scheduler::tracing::Sink::submit(vector<Record> records, const std::size_t n) -> vector<Record> {
+    const auto capacity = records.size();
+    vector<Record> empty;
+    {
+        unique_lock<mutex> lck{queue_mtx};
+        written.emplace(std::move(records), n);
+        if (not spare.empty()) {
+            empty = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    queue_cv.notify_one();
+
+    empty.resize(capacity);
+    return empty;
+}
+
+auto viua::scheduler::tracing::Sink::register_buffer() -> uint16_t { return buffers++; }
+
+
+viua::scheduler::tracing::Buffer::Buffer(Sink* s, const std::size_t capacity)
+    : sink(s), records(s ? capacity : 0), next(0), scheduler_id(s ? s->register_buffer() : 0) {}
+
+viua::scheduler::tracing::Buffer::Buffer(Buffer&& that)
+    : sink(that.sink), records(std::move(that.records)), next(that.next), scheduler_id(that.scheduler_id) {
+    that.sink = nullptr;
+    that.next = 0;
+}
+
+viua::scheduler::tracing::Buffer::~Buffer() { flush(); }
+
+auto viua::scheduler::tracing::Buffer::flush() -> void {
+    if (sink and next) {
+        records = sink->submit(std::move(records), next);
+    }
+    next = 0;
+}
@@ -194,7 +194,17 @@ bool viua::scheduler::VirtualProcessScheduler::executeQuant(
         // do not execute suspended processes
         return true;
     }
+    if (th->hibernating()) {
+        // hibernated processes are not ticked until there is something to do for them
+        if (not th->ready_to_wake_up()) {
+            return true;
+        }
+        th->rehydrate();
+    }
 
+    th->begin_quant();
+    viua::types::charge_allocations_to(th->allocation_account());
+    uint64_t ticks = 0;
     for (decltype(priority) j = 0; (priority == 0 or j < priority); ++j) {
         if (th->stopped()) {
             // remember to break if the process stopped
@@ -211,6 +221,32 @@ bool viua::scheduler::VirtualProcessScheduler::executeQuant(
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 #endif
         th->tick();
+        ++ticks;
+        if (th->blocked_in_receive()) {
+            // spinning on an empty mailbox for the rest of the quant would only
+            // take time away from processes that could send the message
+            break;
+        }
+    }
+    th->end_quant();
+    viua::types::charge_allocations_to(nullptr);
+    if (counters) {
+        viua::scheduler::telemetry::bump(counters->quants);
+        viua::scheduler::telemetry::bump(counters->ticks, ticks);
+    }
+
+    if (process_memory_limit and not(th->stopped() or th->suspended())) {
+        auto const usage = th->allocated_memory();
+        if (usage > process_memory_limit) {
+            th->raise(make_unique<viua::types::Exception>(
+                "MemoryLimitExceeded", ("process memory limit exceeded: " + to_string(usage) + " > " +
+                                        to_string(process_memory_limit) + " bytes")));
+            th->handleActiveException();
+        }
+    }
+
+    if (th->should_hibernate(hibernation_threshold)) {
+        th->hibernate();
     }
 
     return true;
@@ -278,18 +314,34 @@ pair<viua::internals::types::byte*, viua::internals::types::byte*> viua::schedul
     return attached_kernel->getEntryPointOf(name);
 }
 
+auto viua::scheduler::VirtualProcessScheduler::is_verified_code(
+    const viua::internals::types::byte* module_base) const -> bool {
+    return attached_kernel->is_verified_code(module_base);
+}
+
+auto viua::scheduler::VirtualProcessScheduler::atom_literal_at(const viua::internals::types::byte* literal) const
+    -> viua::types::Atom::handle_type {
+    return attached_kernel->atom_literal_at(literal);
+}
+
 void viua::scheduler::VirtualProcessScheduler::registerPrototype(unique_ptr<viua::types::Prototype> proto) {
     attached_kernel->registerPrototype(std::move(proto));
 }
 
 void viua::scheduler::VirtualProcessScheduler::requestForeignFunctionCall(Frame* frame,
                                                                           viua::process::Process* p) const {
+    if (counters) {
+        viua::scheduler::telemetry::bump(counters->ffi_calls);
+    }
     attached_kernel->requestForeignFunctionCall(frame, p);
 }
 
 void viua::scheduler::VirtualProcessScheduler::requestForeignMethodCall(
     const string& name, viua::types::Value* object, Frame* frame, viua::kernel::RegisterSet*,
     viua::kernel::RegisterSet*, viua::process::Process* p) {
+    if (counters) {
+        viua::scheduler::telemetry::bump(counters->ffi_calls);
+    }
     attached_kernel->requestForeignMethodCall(name, object, frame, nullptr, nullptr, p);
 }
 
@@ -330,6 +382,9 @@ viua::process::Process* viua::scheduler::VirtualProcessScheduler::spawn(unique_p
         attached_kernel->create_result_slot_for(process_ptr->pid());
     }
     const auto running_schedulers = attached_kernel->no_of_vp_schedulers();
+    if (counters) {
+        viua::scheduler::telemetry::bump(counters->spawned);
+    }
 
     /*
      * Determine if this scheduler is overburdened and should post processes to kernel.
@@ -351,6 +406,12 @@ viua::process::Process* viua::scheduler::VirtualProcessScheduler::spawn(unique_p
         viua_err("[scheduler:vps:", this, "] posting process ", p.get(), ":", p->starting_function(),
                  " to kernel");
 #endif
+        if (counters) {
+            viua::scheduler::telemetry::bump(counters->posted);
+        }
+        if (allocation_profile_of_scheduler) {
+            allocation_profile_of_scheduler->settle();
+        }
         attached_kernel->postFreeProcess(std::move(p));
     } else {
 #if VIUA_VM_DEBUG_LOG
@@ -367,15 +428,20 @@ void viua::scheduler::VirtualProcessScheduler::send(const viua::process::PID pid
 #if VIUA_VM_DEBUG_LOG
     viua_err("[sched:vps:send] pid = ", pid.get());
 #endif
+    if (allocation_profile_of_scheduler) {
+        // the message may be freed by its receiver before the sending instruction finishes
+        allocation_profile_of_scheduler->settle();
+    }
     attached_kernel->send(pid, std::move(message));
 }
 
 void viua::scheduler::VirtualProcessScheduler::receive(const viua::process::PID pid,
-                                                       queue<unique_ptr<viua::types::Value>>& message_queue) {
+                                                       queue<unique_ptr<viua::types::Value>>& message_queue,
+                                                       queue<std::chrono::steady_clock::time_point>& timestamps) {
 #if VIUA_VM_DEBUG_LOG
     viua_err("[sched:vps:receive] pid = ", pid.get());
 #endif
-    attached_kernel->receive(pid, message_queue);
+    attached_kernel->receive(pid, message_queue, timestamps);
 }
 
 auto viua::scheduler::VirtualProcessScheduler::is_joinable(const viua::process::PID pid) const -> bool {
@@ -396,12 +462,92 @@ auto viua::scheduler::VirtualProcessScheduler::transfer_result_of(const viua::pr
     return attached_kernel->transfer_result_of(pid);
 }
 
+auto viua::scheduler::VirtualProcessScheduler::sample_stacks() -> void {
+    /*  Processes that are not running are also sampled so the profile shows
+     *  where time is spent waiting.
+     *  Such processes get a pseudo-frame on top of their stacks telling what
+     *  they are waiting for.
+     */
+    for (const auto& each : processes) {
+        if (each->stopped()) {
+            continue;
+        }
+
+        string stack;
+        for (const auto frame : each->trace()) {
+            stack += ((stack.empty() ? "" : ";") + frame->function_name);
+        }
+        if (each->suspended()) {
+            stack += ";[ffi]";
+        } else if (each->blocked_in_receive()) {
+            stack += ";[receive]";
+        }
+        stack_profile->record(stack);
+    }
+}
+
+auto viua::scheduler::VirtualProcessScheduler::update_gauges() -> void {
+    counters->run_queue.store(processes.size(), std::memory_order_relaxed);
+    counters->load.store(current_load, std::memory_order_relaxed);
+
+    // accounts are kept up to date as processes run so reading them is cheap
+    uint64_t memory = 0;
+    for (const auto& each : processes) {
+        memory += each->allocated_memory();
+    }
+    counters->process_memory.store(memory, std::memory_order_relaxed);
+}
+
+auto viua::scheduler::VirtualProcessScheduler::publish_snapshot() -> void {
+    /*  Called between bursts so none of the processes is running.
+     *  Suspended processes are described too, but only their stacks are
+     *  looked at (FFI schedulers do not push or pop frames).
+     */
+    auto const generation = introspection_board->requested();
+
+    viua::scheduler::introspection::Snapshot snapshot;
+    snapshot.taken_at = std::chrono::steady_clock::now();
+    for (const auto& each : processes) {
+        viua::scheduler::introspection::ProcessInfo info;
+        info.pid = each->pid().str();
+        if (each->stopped()) {
+            info.state = (each->terminated() ? "terminated" : "stopped");
+        } else if (each->suspended()) {
+            info.state = "ffi";
+        } else if (each->hibernating()) {
+            info.state = "hibernating";
+        } else if (each->blocked_in_receive()) {
+            info.state = "receive";
+        } else {
+            info.state = "running";
+        }
+        info.priority = each->priority();
+        info.queued_messages = each->queued_messages();
+        for (const auto frame : each->trace()) {
+            info.stack.push_back(frame->function_name);
+        }
+        snapshot.processes.push_back(std::move(info));
+    }
+
+    introspection_board->publish(std::move(snapshot), generation);
+}
+
 bool viua::scheduler::VirtualProcessScheduler::burst() {
+    if (introspection_board and introspection_board->wanted()) {
+        publish_snapshot();
+    }
+
     if (not processes.size()) {
         // make kernel stop if there are no processes_list to run
         return false;
     }
 
+    auto const burst_started_at = std::chrono::steady_clock::now();
+
+    if (stack_profile and stack_profile->due()) {
+        sample_stacks();
+    }
+
     bool ticked = false;
     bool any_active = false;
 
@@ -547,19 +693,80 @@ bool viua::scheduler::VirtualProcessScheduler::burst() {
     processes.erase(processes.begin(), processes.end());
     processes.swap(running_processes_list);
 
+    if (counters) {
+        counters->record_burst(std::chrono::steady_clock::now() - burst_started_at);
+        update_gauges();
+    }
+
     // FIXME scheduler should sleep only after checking if there are no free processes to run and rebalancing
     if (not any_active) {
+        auto const idle_since = std::chrono::steady_clock::now();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (counters) {
+            viua::scheduler::telemetry::bump(counters->idle_ns, std::chrono::steady_clock::now() - idle_since);
+        }
     }
 
     return ticked;
 }
+auto viua::scheduler::VirtualProcessScheduler::fetch_free_processes() -> void {
+    /*
+     * Determine if this scheduler should fetch processes from kernel if any
+     * are available.
+     * Must be called with free processes mutex locked.
+     *
+     * The algorithm is simple: if current load is less than our fair share,
+     * fetch a process.
+     * Repeat until we're a good, hardworking scheduler.
+     */
+    const auto total_processes = attached_kernel->pids();
+    const auto running_schedulers = attached_kernel->no_of_vp_schedulers();
+    /*
+     * The "<=" check is *FREAKIN' IMPORTANT* because if:
+     *
+     *  - schedulers load is zero, and
+     *  - wanted load (total processes / number of schedulers) is zero
+     *
+     * VM would deadlock as current load would not be *less* than wanted, which
+     * is a prerequisite for fetching processes.
+     * Such a situation could occur if you'd run the VM with high number of
+     * schedulers, and low number of processes.
+     *
+     * *REMEMBER* about corner cases, or they will come back to bite you when
+     * you least expect it.
+     */
+    while (current_load <= (total_processes / running_schedulers) and not free_processes->empty()) {
+        processes.emplace_back(std::move(free_processes->front()));
+        free_processes->erase(free_processes->begin());
+        processes.back()->migrate_to(this);
+        if (counters) {
+            viua::scheduler::telemetry::bump(counters->grabbed);
+        }
+#if VIUA_VM_DEBUG_LOG
+        viua_err("[scheduler:vps:", this, ":process-grab] grabbed process ", processes.back().get(), ':',
+                 processes.back()->starting_function());
+#endif
+        ++current_load;
+    }
+}
+
 void viua::scheduler::VirtualProcessScheduler::operator()() {
+    viua::types::observe_allocations(allocation_profile_of_scheduler);
+
     while (true) {
-        // FIXME perform a single burst at a time - if scheduler keeps bursting for a long time some free
-        // processes may wait "forever" before being migrated to a scheduler
-        while (burst())
-            ;
+        while (burst()) {
+            /*
+             * Processes posted to the kernel must not wait until this scheduler runs
+             * out of work.
+             * If one of our processes is waiting for a message from a free process
+             * the burst never ends and, with no other scheduler to take the free
+             * process, the two would wait for each other forever.
+             */
+            unique_lock<mutex> lock(*free_processes_mutex, std::try_to_lock);
+            if (lock.owns_lock() and not free_processes->empty()) {
+                fetch_free_processes();
+            }
+        }
 
 #if VIUA_VM_DEBUG_LOG
         viua_err("[scheduler:vps:", this, "] burst finished");
@@ -567,6 +774,7 @@ void viua::scheduler::VirtualProcessScheduler::operator()() {
 
         // FIXME MEMORY this is accessing kernel-specific variables by pointer
         // rewrite this so it's the kernel that gives the scheduler a lock
+        auto const idle_since = std::chrono::steady_clock::now();
         unique_lock<mutex> lock(*free_processes_mutex);
         // FIXME don't wait forever after single-bursting is implemented, wait one time, then continue to
         // rebalancing and just run again
@@ -574,8 +782,14 @@ void viua::scheduler::VirtualProcessScheduler::operator()() {
             auto scheduler_should_shut_down = shut_down.load(std::memory_order_acquire);
             auto there_are_free_processes = (not free_processes->empty());
             return (there_are_free_processes or scheduler_should_shut_down);
-        }))
-            ;
+        })) {
+            if (introspection_board and introspection_board->wanted()) {
+                publish_snapshot();
+            }
+        }
+        if (counters) {
+            viua::scheduler::telemetry::bump(counters->idle_ns, std::chrono::steady_clock::now() - idle_since);
+        }
 
         // FIXME XXX this exit condition is dubious - scheduler should exit when the shut_dow is true, not
         // when there are no free processes
@@ -589,44 +803,16 @@ void viua::scheduler::VirtualProcessScheduler::operator()() {
             break;
         }
 
-        /*
-         * Determine if this scheduler should fetch processes from kernel if any
-         * are available.
-         *
-         * The algorithm is simple: if current load is less than our fair share,
-         * fetch a process.
-         * Repeat until we're a good, hardworking scheduler.
-         */
-        const auto total_processes = attached_kernel->pids();
-        const auto running_schedulers = attached_kernel->no_of_vp_schedulers();
-        /*
-         * The "<=" check is *FREAKIN' IMPORTANT* because if:
-         *
-         *  - schedulers load is zero, and
-         *  - wanted load (total processes / number of schedulers) is zero
-         *
-         * VM would deadlock as current load would not be *less* than wanted, which
-         * is a prerequisite for fetching processes.
-         * Such a situation could occur if you'd run the VM with high number of
-         * schedulers, and low number of processes.
-         *
-         * *REMEMBER* about corner cases, or they will come back to bite you when
-         * you least expect it.
-         */
-        while (current_load <= (total_processes / running_schedulers) and not free_processes->empty()) {
-            processes.emplace_back(std::move(free_processes->front()));
-            free_processes->erase(free_processes->begin());
-            processes.back()->migrate_to(this);
-#if VIUA_VM_DEBUG_LOG
-            viua_err("[scheduler:vps:", this, ":process-grab] grabbed process ", processes.back().get(), ':',
-                     processes.back()->starting_function());
-#endif
-            ++current_load;
-        }
+        fetch_free_processes();
     }
 #if VIUA_VM_DEBUG_LOG
     viua_err("[scheduler:vps:", this, "] shut down with ", processes.size(), " local processes");
 #endif
+
+    if (allocation_profile_of_scheduler) {
+        allocation_profile_of_scheduler->settle();
+    }
+    viua::types::observe_allocations(nullptr);
 }
 
 void viua::scheduler::VirtualProcessScheduler::bootstrap(const vector<string>& commandline_arguments) {
@@ -658,9 +844,19 @@ int viua::scheduler::VirtualProcessScheduler::exit() const { return exit_code; }
 
 viua::scheduler::VirtualProcessScheduler::VirtualProcessScheduler(
     viua::kernel::Kernel* akernel, vector<unique_ptr<viua::process::Process>>* fp, mutex* fp_mtx,
-    condition_variable* fp_cv, const bool enable_tracing)
+    condition_variable* fp_cv, const std::size_t memory_limit, const std::chrono::milliseconds hibernate_after,
+    const Instrumentation& instrumentation)
     : attached_kernel(akernel),
-      tracing_enabled(enable_tracing),
+      tracing_enabled(instrumentation.trace_sink != nullptr),
+      trace_buffer(instrumentation.trace_sink),
+      process_memory_limit(memory_limit),
+      hibernation_threshold(hibernate_after),
+      opcode_profile_of_scheduler(instrumentation.opcode_profile),
+      stack_profile(instrumentation.stack_profile),
+      allocation_profile_of_scheduler(instrumentation.allocation_profile),
+      call_profiles_of_scheduler(instrumentation.call_profiles),
+      counters(instrumentation.counters),
+      introspection_board(instrumentation.introspection_board),
       free_processes(fp),
       free_processes_mutex(fp_mtx),
       free_processes_cv(fp_cv),
@@ -671,7 +867,16 @@ viua::scheduler::VirtualProcessScheduler::VirtualProcessScheduler(
       shut_down(false) {}
 
 viua::scheduler::VirtualProcessScheduler::VirtualProcessScheduler(VirtualProcessScheduler&& that)
-    : tracing_enabled(that.tracing_enabled) {
+    : tracing_enabled(that.tracing_enabled),
+      trace_buffer(std::move(that.trace_buffer)),
+      process_memory_limit(that.process_memory_limit),
+      hibernation_threshold(that.hibernation_threshold),
+      opcode_profile_of_scheduler(that.opcode_profile_of_scheduler),
+      stack_profile(that.stack_profile),
+      allocation_profile_of_scheduler(that.allocation_profile_of_scheduler),
+      call_profiles_of_scheduler(that.call_profiles_of_scheduler),
+      counters(that.counters),
+      introspection_board(that.introspection_board) {
     attached_kernel = that.attached_kernel;
 
     free_processes = that.free_processes;
@@ -17,6 +17,7 @@
  *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <sstream>
 #include <viua/support/env.h>
 using namespace std;
@@ -27,6 +28,39 @@ namespace support {
             const char* VAR = getenv(var.c_str());
             return (VAR == nullptr ? string("") : string(VAR));
         }
+        uint64_t getnumber(const string& var, const uint64_t default_value,
+                           const map<string, uint64_t>& multipliers) {
+            const char* VAR = getenv(var.c_str());
+            if (VAR == nullptr) {
+                return default_value;
+            }
+
+            const string text{VAR};
+            const auto too_big = ("value of " + var + " is too big: " + text);
+            uint64_t value = 0;
+            string::size_type i = 0;
+            for (; i < text.size() and text[i] >= '0' and text[i] <= '9'; ++i) {
+                auto const digit = static_cast<uint64_t>(text[i] - '0');
+                if (value > ((numeric_limits<uint64_t>::max() - digit) / 10)) {
+                    throw too_big;
+                }
+                value = (value * 10) + digit;
+            }
+            if (i == 0) {
+                throw("invalid value of " + var + ": \"" + text + "\" (expected a number)");
+            }
+            if (i < text.size()) {
+                auto const multiplier = multipliers.find(text.substr(i));
+                if (multiplier == multipliers.end()) {
+                    throw("invalid suffix in " + var + ": \"" + text.substr(i) + "\"");
+                }
+                if (value > (numeric_limits<uint64_t>::max() / multiplier->second)) {
+                    throw too_big;
+                }
+                value *= multiplier->second;
+            }
+            return value;
+        }
         vector<string> getpaths(const string& var) {
             string PATH = getvar(var);
             vector<string> paths;
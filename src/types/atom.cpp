@@ -17,12 +17,50 @@
  *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
 #include <viua/support/string.h>
 #include <viua/types/atom.h>
 using namespace std;
 
 const string viua::types::Atom::type_name = "viua::types::Atom";
 
+namespace {
+    /*
+     * Elements of an unordered_set are never moved in memory (rehashing only
+     * relinks the nodes) so pointers to them are stable and may be used as handles.
+     * The table only ever grows; atoms are never removed from it.
+     */
+    struct AtomTable {
+        unordered_set<string> atoms;
+        shared_mutex atoms_mutex;
+    };
+    auto atom_table() -> AtomTable& {
+        static AtomTable table;
+        return table;
+    }
+}
+
+auto viua::types::Atom::intern(const string& s) -> handle_type {
+    if (auto found = find(s)) {
+        return found;
+    }
+
+    auto& table = atom_table();
+    unique_lock<shared_mutex> lck{table.atoms_mutex};
+    return &*table.atoms.insert(s).first;
+}
+
+auto viua::types::Atom::find(const string& s) -> handle_type {
+    auto& table = atom_table();
+    shared_lock<shared_mutex> lck{table.atoms_mutex};
+    if (auto found = table.atoms.find(s); found != table.atoms.end()) {
+        return &*found;
+    }
+    return nullptr;
+}
+
 vector<string> viua::types::Atom::bases() const { return {"Value"}; }
 
 vector<string> viua::types::Atom::inheritancechain() const { return {"Value"}; }
@@ -31,14 +69,19 @@ string viua::types::Atom::type() const { return "viua::types::Atom"; }
 
 bool viua::types::Atom::boolean() const { return true; }
 
-string viua::types::Atom::str() const { return str::enquote(value, '\''); }
+std::size_t viua::types::Atom::memory_footprint() const { return sizeof(Atom); }
+
+string viua::types::Atom::str() const { return str::enquote(*value, '\''); }
 
 string viua::types::Atom::repr() const { return str(); }
 
-viua::types::Atom::operator string() const { return value; }
+viua::types::Atom::operator string() const { return *value; }
+
+auto viua::types::Atom::handle() const -> handle_type { return value; }
 
 unique_ptr<viua::types::Value> viua::types::Atom::copy() const { return make_unique<Atom>(value); }
 
 auto viua::types::Atom::operator==(const Atom& that) const -> bool { return (value == that.value); }
 
-viua::types::Atom::Atom(string s) : value(s) {}
+viua::types::Atom::Atom(string s) : value(intern(s)) {}
+viua::types::Atom::Atom(handle_type h) : value(h) {}
@@ -1236,6 +1236,10 @@ string viua::types::Bits::str() const { return to_string(underlying_array); }
 
 bool viua::types::Bits::boolean() const { return binary_to_bool(underlying_array); }
 
+std::size_t viua::types::Bits::memory_footprint() const {
+    return (sizeof(Bits) + underlying_array.capacity() / 8);
+}
+
 unique_ptr<viua::types::Value> viua::types::Bits::copy() const { return make_unique<Bits>(underlying_array); }
 
 auto viua::types::Bits::size() const -> size_type { return underlying_array.size(); }
@@ -28,6 +28,8 @@ string viua::types::Boolean::str() const { return (b ? "true" : "false"); }
 
 bool viua::types::Boolean::boolean() const { return b; }
 
+std::size_t viua::types::Boolean::memory_footprint() const { return sizeof(Boolean); }
+
 bool& viua::types::Boolean::value() { return b; }
 
 vector<string> viua::types::Boolean::bases() const { return vector<string>{"Number"}; }
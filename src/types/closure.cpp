@@ -21,6 +21,7 @@
 #include <string>
 #include <viua/types/closure.h>
 #include <viua/types/value.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Closure::type_name = "Closure";
@@ -44,10 +45,27 @@ string viua::types::Closure::repr() const { return str(); }
 
 bool viua::types::Closure::boolean() const { return true; }
 
+std::size_t viua::types::Closure::memory_footprint() const {
+    return (sizeof(Closure) + viua::util::memory::heap_size(function_name) +
+            (local_register_set ? local_register_set->memory_footprint() : 0));
+}
+
 unique_ptr<viua::types::Value> viua::types::Closure::copy() const {
     return make_unique<Closure>(function_name, local_register_set->copy());
 }
 
+auto viua::types::Closure::charge_to(MemoryAccount* account) -> void {
+    Value::charge_to(account);
+    if (not local_register_set) {
+        return;
+    }
+    for (viua::internals::types::register_index i = 0; i < local_register_set->size(); ++i) {
+        if (auto const each = local_register_set->at(i)) {
+            each->charge_to(account);
+        }
+    }
+}
+
 
 string viua::types::Closure::name() const { return function_name; }
 
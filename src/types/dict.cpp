@@ -0,0 +1,362 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <functional>
+#include <sstream>
+#include <viua/types/bits.h>
+#include <viua/types/dict.h>
+#include <viua/types/exception.h>
+#include <viua/types/integer.h>
+#include <viua/types/string.h>
+#include <viua/types/text.h>
+#include <viua/util/memory.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+const string viua::types::Dict::type_name = "Dict";
+
+namespace {
+    using control_type = int8_t;
+
+    constexpr size_t GROUP_WIDTH = 16;
+    constexpr control_type EMPTY = -128;
+    constexpr control_type DELETED = -2;
+
+    /*
+     * Low 7 bits of a hash are stored in the control byte of a slot (so full
+     * slots are never negative), the rest selects the group to start probing
+     * from.
+     */
+    auto h1(const size_t hash) -> size_t { return (hash >> 7); }
+    auto h2(const size_t hash) -> control_type { return static_cast<control_type>(hash & 0x7f); }
+
+    auto mix(size_t hash, const viua::types::Dict::KeyKind kind) -> size_t {
+        uint64_t h = hash;
+        h ^= (static_cast<uint64_t>(kind) + 1) * 0x9e3779b97f4a7c15ULL;
+        h ^= (h >> 33);
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= (h >> 33);
+        return h;
+    }
+
+    /*
+     * Bit N of the result is set if N-th control byte of the group matches.
+     */
+    auto match(const control_type* group, const control_type byte) -> uint32_t {
+#if defined(__SSE2__)
+        auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(byte), ctrl)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            mask |= (static_cast<uint32_t>(group[i] == byte) << i);
+        }
+        return mask;
+#endif
+    }
+    auto match_empty_or_deleted(const control_type* group) -> uint32_t {
+#if defined(__SSE2__)
+        auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            mask |= (static_cast<uint32_t>(group[i] < 0) << i);
+        }
+        return mask;
+#endif
+    }
+
+    auto lowest_bit(const uint32_t mask) -> size_t { return static_cast<size_t>(__builtin_ctz(mask)); }
+}  // namespace
+
+auto viua::types::Dict::Key::operator==(const Key& that) const -> bool {
+    if (kind != that.kind or hash != that.hash) {
+        return false;
+    }
+    switch (kind) {
+    case KeyKind::INTEGER:
+        return (integer == that.integer);
+    case KeyKind::ATOM:
+        return (atom == that.atom);
+    case KeyKind::STRING:
+    case KeyKind::TEXT:
+    case KeyKind::BITS:
+    default:
+        return (bytes == that.bytes);
+    }
+}
+
+auto viua::types::Dict::make_key(Value* object) -> Key {
+    Key key{KeyKind::INTEGER, 0, nullptr, "", 0};
+
+    if (auto i = dynamic_cast<Integer*>(object)) {
+        key.kind = KeyKind::INTEGER;
+        key.integer = i->as_integer();
+        key.hash = hash<int64_t>{}(key.integer);
+    } else if (auto a = dynamic_cast<Atom*>(object)) {
+        key.kind = KeyKind::ATOM;
+        key.atom = a->handle();
+        key.hash = hash<Atom::handle_type>{}(key.atom);
+    } else if (auto s = dynamic_cast<String*>(object)) {
+        key.kind = KeyKind::STRING;
+        key.bytes = s->value();
+        key.hash = hash<string>{}(key.bytes);
+    } else if (auto t = dynamic_cast<Text*>(object)) {
+        key.kind = KeyKind::TEXT;
+        key.bytes = t->str();
+        key.hash = hash<string>{}(key.bytes);
+    } else if (auto b = dynamic_cast<Bits*>(object)) {
+        key.kind = KeyKind::BITS;
+        key.bytes.reserve(b->size());
+        for (Bits::size_type n = 0; n < b->size(); ++n) {
+            key.bytes.push_back(b->at(n) ? '1' : '0');
+        }
+        key.hash = hash<string>{}(key.bytes);
+    } else {
+        throw make_unique<Exception>("invalid key type for Dict: " + object->type());
+    }
+
+    key.hash = mix(key.hash, key.kind);
+    return key;
+}
+
+auto viua::types::Dict::capacity() const -> size_type { return control.size(); }
+
+auto viua::types::Dict::find_slot(const Key& key) const -> size_type {
+    const auto npos = capacity();
+    if (live_entries == 0) {
+        return npos;
+    }
+
+    const auto group_mask = ((capacity() / GROUP_WIDTH) - 1);
+    auto group = (h1(key.hash) & group_mask);
+    const auto fingerprint = h2(key.hash);
+
+    /*
+     * Triangular probing visits every group exactly once when the number of
+     * groups is a power of two.
+     */
+    for (size_type step = 0; step <= group_mask; ++step) {
+        const auto base = (group * GROUP_WIDTH);
+        const auto group_control = (control.data() + base);
+
+        auto candidates = match(group_control, fingerprint);
+        for (; candidates; candidates &= (candidates - 1)) {
+            const auto slot = (base + lowest_bit(candidates));
+            if (entries[slots[slot]].key == key) {
+                return slot;
+            }
+        }
+        if (match(group_control, EMPTY)) {
+            return npos;
+        }
+
+        group = ((group + step + 1) & group_mask);
+    }
+
+    return npos;
+}
+
+auto viua::types::Dict::find_free_slot(const size_t hash) const -> size_type {
+    const auto group_mask = ((capacity() / GROUP_WIDTH) - 1);
+    auto group = (h1(hash) & group_mask);
+
+    for (size_type step = 0; step <= group_mask; ++step) {
+        const auto base = (group * GROUP_WIDTH);
+        if (auto available = match_empty_or_deleted(control.data() + base)) {
+            return (base + lowest_bit(available));
+        }
+        group = ((group + step + 1) & group_mask);
+    }
+
+    // unreachable as long as the load factor is kept below 1
+    throw make_unique<Exception>("Dict: no free slot");
+}
+
+auto viua::types::Dict::rehash(const size_type new_capacity) -> void {
+    decltype(entries) compacted;
+    compacted.reserve(live_entries);
+    for (auto& each : entries) {
+        if (each.original_key) {
+            compacted.emplace_back(std::move(each));
+        }
+    }
+    entries = std::move(compacted);
+
+    key_bytes = 0;
+    for (const auto& each : entries) {
+        key_bytes += viua::util::memory::heap_size(each.key.bytes);
+    }
+
+    control.assign(new_capacity, EMPTY);
+    slots.assign(new_capacity, 0);
+    for (size_type i = 0; i < entries.size(); ++i) {
+        const auto slot = find_free_slot(entries[i].key.hash);
+        control[slot] = h2(entries[i].key.hash);
+        slots[slot] = static_cast<index_type>(i);
+    }
+    charge_table();
+}
+
+auto viua::types::Dict::charge_table() -> void {
+    charge_owned_memory(control.capacity() * sizeof(control_type) + slots.capacity() * sizeof(index_type)
+                        + entries.capacity() * sizeof(Entry) + key_bytes);
+}
+
+string viua::types::Dict::type() const { return "Dict"; }
+
+bool viua::types::Dict::boolean() const { return (live_entries != 0); }
+
+std::size_t viua::types::Dict::memory_footprint() const {
+    auto footprint = sizeof(Dict);
+    footprint += control.capacity() * sizeof(control_type);
+    footprint += slots.capacity() * sizeof(index_type);
+    footprint += entries.capacity() * sizeof(Entry);
+    for (const auto& each : entries) {
+        footprint += viua::util::memory::heap_size(each.key.bytes);
+        footprint += (each.original_key ? each.original_key->memory_footprint() : 0);
+        footprint += (each.value ? each.value->memory_footprint() : 0);
+    }
+    return footprint;
+}
+
+string viua::types::Dict::str() const {
+    ostringstream oss;
+
+    oss << '{';
+
+    auto i = live_entries;
+    for (const auto& each : entries) {
+        if (not each.original_key) {
+            continue;
+        }
+        oss << each.original_key->repr() << ": " << each.value->repr();
+        if (--i) {
+            oss << ", ";
+        }
+    }
+
+    oss << '}';
+
+    return oss.str();
+}
+
+string viua::types::Dict::repr() const { return str(); }
+
+vector<string> viua::types::Dict::bases() const { return vector<string>{"Value"}; }
+vector<string> viua::types::Dict::inheritancechain() const { return vector<string>{"Value"}; }
+
+auto viua::types::Dict::insert(Value* key_object, unique_ptr<Value> value) -> void {
+    auto key = make_key(key_object);
+
+    const auto existing = find_slot(key);
+    if (existing != capacity()) {
+        entries[slots[existing]].value = std::move(value);
+        return;
+    }
+
+    /*
+     * Removed entries stay in the dense array until the next rehash so they
+     * are counted towards the load factor (kept at or below 7/8).
+     * Rehashing drops them, and only grows the table if live entries would
+     * fill more than half of it.
+     */
+    if ((entries.size() + 1) * 8 > capacity() * 7) {
+        auto new_capacity = max(capacity(), GROUP_WIDTH);
+        while ((live_entries + 1) * 2 > new_capacity) {
+            new_capacity *= 2;
+        }
+        rehash(new_capacity);
+    }
+
+    const auto slot = find_free_slot(key.hash);
+    control[slot] = h2(key.hash);
+    slots[slot] = static_cast<index_type>(entries.size());
+    entries.push_back(Entry{std::move(key), key_object->copy(), std::move(value)});
+    ++live_entries;
+    key_bytes += viua::util::memory::heap_size(entries.back().key.bytes);
+    charge_table();
+}
+
+auto viua::types::Dict::at(Value* key_object) -> Value* {
+    const auto slot = find_slot(make_key(key_object));
+    if (slot == capacity()) {
+        throw make_unique<Exception>("key not found: " + key_object->repr());
+    }
+    return entries[slots[slot]].value.get();
+}
+
+auto viua::types::Dict::contains(Value* key_object) const -> bool {
+    return (find_slot(make_key(key_object)) != capacity());
+}
+
+auto viua::types::Dict::remove(Value* key_object) -> unique_ptr<Value> {
+    const auto slot = find_slot(make_key(key_object));
+    if (slot == capacity()) {
+        throw make_unique<Exception>("key not found: " + key_object->repr());
+    }
+
+    auto& entry = entries[slots[slot]];
+    auto value = std::move(entry.value);
+    entry.original_key.reset();
+    control[slot] = DELETED;
+    --live_entries;
+
+    return value;
+}
+
+auto viua::types::Dict::size() const -> size_type { return live_entries; }
+
+auto viua::types::Dict::keys() const -> vector<unique_ptr<Value>> {
+    vector<unique_ptr<Value>> ks;
+    ks.reserve(live_entries);
+    for (const auto& each : entries) {
+        if (each.original_key) {
+            ks.push_back(each.original_key->copy());
+        }
+    }
+    return ks;
+}
+
+auto viua::types::Dict::charge_to(MemoryAccount* account) -> void {
+    Value::charge_to(account);
+    for (const auto& each : entries) {
+        if (each.original_key) {
+            each.original_key->charge_to(account);
+        }
+        if (each.value) {
+            each.value->charge_to(account);
+        }
+    }
+}
+
+unique_ptr<viua::types::Value> viua::types::Dict::copy() const {
+    auto copied = make_unique<Dict>();
+    for (const auto& each : entries) {
+        if (each.original_key) {
+            copied->insert(each.original_key.get(), each.value->copy());
+        }
+    }
+    return copied;
+}
+
+viua::types::Dict::Dict() : live_entries(0), key_bytes(0) {}
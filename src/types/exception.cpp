@@ -19,6 +19,7 @@
 
 #include <string>
 #include <viua/types/exception.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Exception::type_name = "Exception";
@@ -45,6 +46,11 @@ string viua::types::Exception::str() const { return cause; }
 string viua::types::Exception::repr() const { return (etype() + ": " + str::enquote(cause)); }
 bool viua::types::Exception::boolean() const { return true; }
 
+std::size_t viua::types::Exception::memory_footprint() const {
+    using viua::util::memory::heap_size;
+    return (sizeof(Exception) + heap_size(cause) + heap_size(detailed_type));
+}
+
 unique_ptr<viua::types::Value> viua::types::Exception::copy() const { return make_unique<Exception>(cause); }
 
 viua::types::Exception::Exception(string s) : cause(s), detailed_type("Exception") {}
@@ -21,6 +21,7 @@
 #include <string>
 #include <viua/types/function.h>
 #include <viua/types/value.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Function::type_name = "Function";
@@ -43,6 +44,10 @@ string viua::types::Function::repr() const { return str(); }
 
 bool viua::types::Function::boolean() const { return true; }
 
+std::size_t viua::types::Function::memory_footprint() const {
+    return (sizeof(Function) + viua::util::memory::heap_size(function_name));
+}
+
 unique_ptr<viua::types::Value> viua::types::Function::copy() const {
     return make_unique<viua::types::Function>(function_name);
 }
@@ -32,6 +32,8 @@ string Integer::type() const { return "Integer"; }
 string Integer::str() const { return to_string(number); }
 bool Integer::boolean() const { return (number != 0); }
 
+std::size_t Integer::memory_footprint() const { return sizeof(Integer); }
+
 auto Integer::value() -> decltype(number) { return number; }
 
 int64_t Integer::increment() { return (++number); }
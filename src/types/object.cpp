@@ -24,6 +24,7 @@
 #include <viua/kernel/frame.h>
 #include <viua/types/exception.h>
 #include <viua/types/object.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Object::type_name = "Object";
@@ -31,6 +32,16 @@ const string viua::types::Object::type_name = "Object";
 string viua::types::Object::type() const { return object_type_name; }
 bool viua::types::Object::boolean() const { return true; }
 
+std::size_t viua::types::Object::memory_footprint() const {
+    auto footprint = (sizeof(Object) + viua::util::memory::heap_size(object_type_name));
+    for (const auto& each : attributes) {
+        footprint += viua::util::memory::node_size<decltype(attributes)::value_type>();
+        footprint += viua::util::memory::heap_size(each.first);
+        footprint += (each.second ? each.second->memory_footprint() : 0);
+    }
+    return footprint;
+}
+
 string viua::types::Object::str() const {
     ostringstream oss;
 
@@ -49,6 +60,13 @@ string viua::types::Object::str() const {
     return oss.str();
 }
 
+auto viua::types::Object::charge_to(MemoryAccount* account) -> void {
+    Value::charge_to(account);
+    for (const auto& each : attributes) {
+        each.second->charge_to(account);
+    }
+}
+
 unique_ptr<viua::types::Value> viua::types::Object::copy() const {
     auto cp = make_unique<viua::types::Object>(object_type_name);
     for (const auto& each : attributes) {
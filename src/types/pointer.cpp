@@ -31,12 +31,19 @@ using namespace std;
 const string viua::types::Pointer::type_name = "Pointer";
 
 void viua::types::Pointer::attach() {
-    points_to->pointers.push_back(this);
+    if (not points_to->pointers) {
+        points_to->pointers = make_unique<vector<Pointer*>>();
+    }
+    points_to->pointers->push_back(this);
     valid = true;
 }
 void viua::types::Pointer::detach() {
     if (valid) {
-        points_to->pointers.erase(std::find(points_to->pointers.begin(), points_to->pointers.end(), this));
+        auto& pointed_by = *points_to->pointers;
+        pointed_by.erase(std::find(pointed_by.begin(), pointed_by.end(), this));
+        if (pointed_by.empty()) {
+            points_to->pointers.reset();
+        }
     }
     valid = false;
 }
@@ -76,6 +83,8 @@ string viua::types::Pointer::type() const { return ((valid ? points_to->type() :
 
 bool viua::types::Pointer::boolean() const { return valid; }
 
+std::size_t viua::types::Pointer::memory_footprint() const { return sizeof(Pointer); }
+
 vector<string> viua::types::Pointer::bases() const { return vector<string>{"Value"}; }
 vector<string> viua::types::Pointer::inheritancechain() const { return vector<string>{"Value"}; }
 
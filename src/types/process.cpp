@@ -45,8 +45,14 @@ bool viua::types::Process::boolean() const {
     return false;
 }
 
-unique_ptr<viua::types::Value> viua::types::Process::copy() const { return make_unique<Process>(thrd); }
+std::size_t viua::types::Process::memory_footprint() const { return sizeof(Process); }
+
+unique_ptr<viua::types::Value> viua::types::Process::copy() const {
+    // the process may be dead by now so its PID must not be fetched again
+    return make_unique<Process>(thrd, saved_pid);
+}
 
 viua::process::PID viua::types::Process::pid() const { return saved_pid; }
 
 viua::types::Process::Process(viua::process::Process* t) : thrd(t), saved_pid(thrd->pid()) {}
+viua::types::Process::Process(viua::process::Process* t, viua::process::PID pid) : thrd(t), saved_pid(pid) {}
@@ -20,6 +20,7 @@
 #include <sstream>
 #include <string>
 #include <viua/types/prototype.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Prototype::type_name = "Prototype";
@@ -27,6 +28,23 @@ const string viua::types::Prototype::type_name = "Prototype";
 string viua::types::Prototype::type() const { return "viua::types::Prototype"; }
 bool viua::types::Prototype::boolean() const { return true; }
 
+std::size_t viua::types::Prototype::memory_footprint() const {
+    using viua::util::memory::heap_size;
+    auto footprint = (sizeof(Prototype) + heap_size(prototype_name));
+    footprint += (ancestors.capacity() + attributes.capacity()) * sizeof(std::string);
+    for (const auto& each : ancestors) {
+        footprint += heap_size(each);
+    }
+    for (const auto& each : attributes) {
+        footprint += heap_size(each);
+    }
+    for (const auto& each : methods) {
+        footprint += viua::util::memory::node_size<decltype(methods)::value_type>();
+        footprint += (heap_size(each.first) + heap_size(each.second));
+    }
+    return footprint;
+}
+
 vector<string> viua::types::Prototype::bases() const { return vector<string>{"Value"}; }
 vector<string> viua::types::Prototype::inheritancechain() const { return vector<string>{"Value"}; }
 
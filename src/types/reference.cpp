@@ -46,6 +46,11 @@ string viua::types::Reference::str() const { return (*pointer)->str(); }
 string viua::types::Reference::repr() const { return (*pointer)->repr(); }
 bool viua::types::Reference::boolean() const { return (*pointer)->boolean(); }
 
+std::size_t viua::types::Reference::memory_footprint() const {
+    // the referenced value is shared so each reference is charged its part
+    return (sizeof(Reference) + (*pointer)->memory_footprint() / *counter);
+}
+
 vector<string> viua::types::Reference::bases() const { return vector<string>({}); }
 vector<string> viua::types::Reference::inheritancechain() const { return vector<string>({}); }
 
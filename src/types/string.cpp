@@ -19,10 +19,12 @@
 
 #include <algorithm>
 #include <memory>
-#include <regex>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <viua/assert.h>
 #include <viua/exceptions.h>
@@ -33,6 +35,7 @@
 #include <viua/types/string.h>
 #include <viua/types/value.h>
 #include <viua/types/vector.h>
+#include <viua/util/memory.h>
 using namespace std;
 using namespace viua::assertions;
 using namespace viua::types;
@@ -44,6 +47,10 @@ string String::str() const { return svalue; }
 string String::repr() const { return str::enquote(svalue); }
 bool String::boolean() const { return svalue.size() != 0; }
 
+std::size_t String::memory_footprint() const {
+    return (sizeof(String) + viua::util::memory::heap_size(svalue));
+}
+
 unique_ptr<Value> String::copy() const { return make_unique<String>(svalue); }
 
 string& String::value() { return svalue; }
@@ -76,6 +83,7 @@ String* String::add(String* s) {
     /** Append string to this string.
      */
     svalue += s->value();
+    charge_owned_memory(viua::util::memory::heap_size(svalue));
     return this;
 }
 
@@ -100,6 +108,7 @@ void String::stringify(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::R
         throw make_unique<viua::types::Exception>("expected 2 parameters");
     }
     svalue = static_cast<Pointer*>(frame->arguments->at(1))->to(process)->str();
+    charge_owned_memory(viua::util::memory::heap_size(svalue));
 }
 
 void String::represent(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
@@ -108,6 +117,7 @@ void String::represent(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::R
         throw make_unique<viua::types::Exception>("expected 2 parameters");
     }
     svalue = static_cast<Pointer*>(frame->arguments->at(1))->to(process)->repr();
+    charge_owned_memory(viua::util::memory::heap_size(svalue));
 }
 
 void String::startswith(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
@@ -148,36 +158,152 @@ void String::endswith(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::Re
     frame->local_register_set->set(0, make_unique<viua::types::Boolean>(ends_with));
 }
 
-void String::format(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
-                    viua::process::Process*, viua::kernel::Kernel*) {
-    regex key_regex("#\\{(?:(?:0|[1-9][0-9]*)|[a-zA-Z_][a-zA-Z0-9_]*)\\}");
+namespace {
+    /*
+     *  A format string parsed into a sequence of literal text and
+     *  placeholders.
+     *  Placeholders are either positional ("#{0}", taken from the vector
+     *  passed as the first argument), or named ("#{name}", taken from the
+     *  object passed as the second argument).
+     */
+    struct FormatTemplate {
+        struct Segment {
+            enum class Kind {
+                LITERAL,
+                POSITIONAL,
+                NAMED,
+            };
+
+            Kind kind;
+            string text;
+            long int index;
+        };
+
+        vector<Segment> segments;
+        string::size_type literal_size = 0;
+        bool has_placeholders = false;
+    };
+
+    auto is_identifier_head(const char c) -> bool {
+        return ((c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_');
+    }
+    auto is_digit(const char c) -> bool { return (c >= '0' and c <= '9'); }
+
+    auto parse_format_template(const string& source) -> FormatTemplate {
+        using Segment = FormatTemplate::Segment;
+
+        FormatTemplate parsed;
+        string literal;
+
+        const auto size = source.size();
+        for (string::size_type i = 0; i < size; ++i) {
+            if (not(source[i] == '#' and (i + 2) < size and source[i + 1] == '{')) {
+                literal += source[i];
+                continue;
+            }
+
+            auto j = (i + 2);
+            auto kind = Segment::Kind::LITERAL;
+            if (source[j] == '0') {
+                kind = Segment::Kind::POSITIONAL;
+                ++j;
+            } else if (is_digit(source[j])) {
+                kind = Segment::Kind::POSITIONAL;
+                while (j < size and is_digit(source[j])) {
+                    ++j;
+                }
+            } else if (is_identifier_head(source[j])) {
+                kind = Segment::Kind::NAMED;
+                while (j < size and (is_identifier_head(source[j]) or is_digit(source[j]))) {
+                    ++j;
+                }
+            }
+
+            if (kind == Segment::Kind::LITERAL or j >= size or source[j] != '}') {
+                literal += source[i];
+                continue;
+            }
+
+            if (not literal.empty()) {
+                parsed.literal_size += literal.size();
+                parsed.segments.push_back(Segment{Segment::Kind::LITERAL, std::move(literal), 0});
+                literal.clear();
+            }
 
-    string result = svalue;
+            auto key = source.substr(i + 2, (j - i - 2));
+            auto index = ((kind == Segment::Kind::POSITIONAL) ? stol(key) : 0);
+            parsed.segments.push_back(Segment{kind, std::move(key), index});
+            parsed.has_placeholders = true;
 
-    if (regex_search(result, key_regex)) {
-        vector<string> matches;
-        for (sregex_iterator match = sregex_iterator(result.begin(), result.end(), key_regex);
-             match != sregex_iterator(); ++match) {
-            matches.emplace_back(match->str());
+            i = j;
         }
 
-        for (auto i : matches) {
-            string m = i.substr(2, (i.size() - 3));
-            string replacement;
-            bool is_number = true;
-            int index = -1;
-            try {
-                index = stoi(m);
-            } catch (const std::invalid_argument&) { is_number = false; }
-            if (is_number) {
-                replacement = static_cast<Vector*>(frame->arguments->at(1))->at(index)->str();
-            } else {
-                replacement = static_cast<Object*>(frame->arguments->at(2))->at(m)->str();
+        if (not literal.empty()) {
+            parsed.literal_size += literal.size();
+            parsed.segments.push_back(Segment{FormatTemplate::Segment::Kind::LITERAL, std::move(literal), 0});
+        }
+
+        return parsed;
+    }
+
+    /*
+     *  Format strings are usually literals so the same few templates are
+     *  formatted over and over again.
+     *  The cache is dropped when it grows too big so that formatting strings
+     *  built at runtime does not make it grow without bounds.
+     */
+    auto cached_format_template(const string& source) -> shared_ptr<const FormatTemplate> {
+        static const decltype(source.size()) max_cached_templates = 1024;
+        static unordered_map<string, shared_ptr<const FormatTemplate>> templates;
+        static shared_mutex templates_mutex;
+
+        {
+            shared_lock<shared_mutex> lock{templates_mutex};
+            auto found = templates.find(source);
+            if (found != templates.end()) {
+                return found->second;
             }
-            string pat("#\\{" + m + "\\}");
-            regex subst(pat);
-            result = regex_replace(result, subst, replacement);
         }
+
+        auto parsed = make_shared<const FormatTemplate>(parse_format_template(source));
+
+        unique_lock<shared_mutex> lock{templates_mutex};
+        if (templates.size() >= max_cached_templates) {
+            templates.clear();
+        }
+        templates.emplace(source, parsed);
+        return parsed;
+    }
+}  // namespace
+
+void String::format(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::RegisterSet*,
+                    viua::process::Process*, viua::kernel::Kernel*) {
+    using Kind = FormatTemplate::Segment::Kind;
+
+    auto format_template = cached_format_template(svalue);
+    if (not format_template->has_placeholders) {
+        frame->local_register_set->set(0, make_unique<String>(svalue));
+        return;
+    }
+
+    vector<string> replacements;
+    auto result_size = format_template->literal_size;
+    for (const auto& each : format_template->segments) {
+        if (each.kind == Kind::POSITIONAL) {
+            replacements.emplace_back(static_cast<Vector*>(frame->arguments->at(1))->at(each.index)->str());
+        } else if (each.kind == Kind::NAMED) {
+            replacements.emplace_back(static_cast<Object*>(frame->arguments->at(2))->at(each.text)->str());
+        } else {
+            continue;
+        }
+        result_size += replacements.back().size();
+    }
+
+    string result;
+    result.reserve(result_size);
+    auto replacement = replacements.begin();
+    for (const auto& each : format_template->segments) {
+        result += ((each.kind == Kind::LITERAL) ? each.text : *replacement++);
     }
 
     frame->local_register_set->set(0, make_unique<String>(result));
@@ -222,4 +348,4 @@ void String::size(Frame* frame, viua::kernel::RegisterSet*, viua::kernel::Regist
     frame->local_register_set->set(0, make_unique<Integer>(static_cast<int>(svalue.size())));
 }
 
-String::String(string s) : svalue(s) {}
+String::String(string s) : svalue(s) { charge_owned_memory(viua::util::memory::heap_size(svalue)); }
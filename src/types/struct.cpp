@@ -17,25 +17,49 @@
  *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <sstream>
+#include <stdexcept>
 #include <viua/support/string.h>
 #include <viua/types/struct.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Struct::type_name = "Struct";
 
+auto viua::types::Struct::keys_by_name() const -> vector<Atom::handle_type> {
+    vector<Atom::handle_type> ks;
+    ks.reserve(attributes.size());
+    for (const auto& each : attributes) {
+        ks.push_back(each.first);
+    }
+    sort(ks.begin(), ks.end(),
+         [](const Atom::handle_type lhs, const Atom::handle_type rhs) -> bool { return (*lhs < *rhs); });
+    return ks;
+}
+
 string viua::types::Struct::type() const { return "Struct"; }
 
 bool viua::types::Struct::boolean() const { return (not attributes.empty()); }
 
+std::size_t viua::types::Struct::memory_footprint() const {
+    auto footprint = sizeof(Struct);
+    for (const auto& each : attributes) {
+        footprint += viua::util::memory::node_size<decltype(attributes)::value_type>();
+        footprint += (each.second ? each.second->memory_footprint() : 0);
+    }
+    return footprint;
+}
+
 string viua::types::Struct::str() const {
     ostringstream oss;
 
     oss << '{';
 
-    auto i = attributes.size();
-    for (const auto& each : attributes) {
-        oss << str::enquote(each.first, '\'') << ": " << each.second->repr();
+    auto ks = keys_by_name();
+    auto i = ks.size();
+    for (const auto each : ks) {
+        oss << str::enquote(*each, '\'') << ": " << attributes.at(each)->repr();
         if (--i) {
             oss << ", ";
         }
@@ -52,27 +76,41 @@ vector<string> viua::types::Struct::bases() const { return vector<string>{"Value
 vector<string> viua::types::Struct::inheritancechain() const { return vector<string>{"Value"}; }
 
 void viua::types::Struct::insert(const string& key, unique_ptr<viua::types::Value> value) {
-    attributes[key] = std::move(value);
+    attributes[Atom::intern(key)] = std::move(value);
+}
+
+void viua::types::Struct::insert(const Atom& key, unique_ptr<viua::types::Value> value) {
+    attributes[key.handle()] = std::move(value);
 }
 
 unique_ptr<viua::types::Value> viua::types::Struct::remove(const string& key) {
-    unique_ptr<viua::types::Value> value = std::move(attributes.at(key));
-    attributes.erase(key);
+    // a string that was never interned cannot be a key so there is no need to intern it
+    auto handle = Atom::find(key);
+    if (handle == nullptr) {
+        throw out_of_range("Struct::remove: no such key: " + key);
+    }
+    return remove(Atom{handle});
+}
+
+unique_ptr<viua::types::Value> viua::types::Struct::remove(const Atom& key) {
+    unique_ptr<viua::types::Value> value = std::move(attributes.at(key.handle()));
+    attributes.erase(key.handle());
     return value;
 }
 
-vector<string> viua::types::Struct::keys() const {
-    vector<string> ks;
+vector<viua::types::Atom::handle_type> viua::types::Struct::keys() const { return keys_by_name(); }
+
+auto viua::types::Struct::charge_to(MemoryAccount* account) -> void {
+    Value::charge_to(account);
     for (const auto& each : attributes) {
-        ks.push_back(each.first);
+        each.second->charge_to(account);
     }
-    return ks;
 }
 
 unique_ptr<viua::types::Value> viua::types::Struct::copy() const {
     auto copied = make_unique<Struct>();
     for (const auto& each : attributes) {
-        copied->insert(each.first, each.second->copy());
+        copied->insert(Atom{each.first}, each.second->copy());
     }
     return copied;
 }
@@ -21,6 +21,7 @@
 #include <sstream>
 #include <viua/support/string.h>
 #include <viua/types/text.h>
+#include <viua/util/memory.h>
 using namespace std;
 
 const string viua::types::Text::type_name = "Text";
@@ -110,6 +111,14 @@ string viua::types::Text::repr() const { return str::enquote(str()); }
 
 bool viua::types::Text::boolean() const { return false; }
 
+std::size_t viua::types::Text::memory_footprint() const {
+    auto footprint = (sizeof(Text) + text.capacity() * sizeof(Character));
+    for (const auto& each : text) {
+        footprint += viua::util::memory::heap_size(each);
+    }
+    return footprint;
+}
+
 std::unique_ptr<viua::types::Value> viua::types::Text::copy() const { return std::make_unique<Text>(text); }
 
 auto viua::types::Text::operator==(const viua::types::Text& other) const -> bool {
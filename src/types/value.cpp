@@ -18,6 +18,7 @@
  */
 
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -27,6 +28,128 @@
 using namespace std;
 
 
+/*  Whether any thread observes allocations, and the observer of allocations made by
+ *  this thread.
+ *  The flag is checked first so that allocations are not slowed down by a lookup of
+ *  the thread-local observer when nothing is profiled.
+ */
+static std::atomic<bool> allocations_observed{false};
+static thread_local viua::types::AllocationObserver* allocation_observer = nullptr;
+
+auto viua::types::observe_allocations(AllocationObserver* observer) -> void {
+    if (observer) {
+        allocations_observed.store(true, std::memory_order_relaxed);
+    }
+    allocation_observer = observer;
+}
+
+/*  Whether values are allocated with a header holding the account they were charged
+ *  to, and the account charged for values allocated by this thread.
+ *  The header also holds sizes of the value and of buffers it owns so that they can be
+ *  moved to another account, and keeps the alignment guaranteed by global operator new.
+ */
+namespace {
+    struct alignas(std::max_align_t) AllocationHeader {
+        viua::types::MemoryAccount* account;
+        std::size_t size;
+        std::size_t owned;
+    };
+}
+static bool memory_accounted = false;
+static thread_local viua::types::MemoryAccount* allocation_account = nullptr;
+static constexpr std::size_t allocation_header_size = sizeof(AllocationHeader);
+
+static auto header_of(void* pointer) -> AllocationHeader* {
+    return reinterpret_cast<AllocationHeader*>(static_cast<char*>(pointer) - allocation_header_size);
+}
+
+auto viua::types::account_memory() -> void { memory_accounted = true; }
+auto viua::types::accounting_memory() -> bool { return memory_accounted; }
+auto viua::types::charge_allocations_to(MemoryAccount* account) -> MemoryAccount* {
+    auto const previous = allocation_account;
+    allocation_account = account;
+    return previous;
+}
+
+auto viua::types::MemoryAccount::charge(const std::size_t size) -> void {
+    held.fetch_add(size, std::memory_order_relaxed);
+}
+auto viua::types::MemoryAccount::credit(const std::size_t size) -> void {
+    if (held.fetch_sub(size, std::memory_order_acq_rel) == size) {
+        delete this;
+    }
+}
+auto viua::types::MemoryAccount::bytes() const -> uint64_t { return (held.load(std::memory_order_relaxed) - 1); }
+auto viua::types::MemoryAccount::release() -> void { credit(1); }
+viua::types::MemoryAccount::MemoryAccount() : held(1) {}
+
+static auto allocate(const std::size_t size) -> void* {
+    if (not memory_accounted) {
+        return ::operator new(size);
+    }
+    auto const block = ::operator new(allocation_header_size + size);
+    auto const pointer = (static_cast<char*>(block) + allocation_header_size);
+    *header_of(pointer) = AllocationHeader{allocation_account, size, 0};
+    if (allocation_account) {
+        allocation_account->charge(size);
+    }
+    return pointer;
+}
+
+void* viua::types::Value::operator new(const std::size_t size) {
+    auto const pointer = allocate(size);
+    if (allocations_observed.load(std::memory_order_relaxed) and allocation_observer) {
+        allocation_observer->allocated(static_cast<Value*>(pointer), size);
+    }
+    return pointer;
+}
+void viua::types::Value::operator delete(void* pointer, const std::size_t) {
+    if (allocations_observed.load(std::memory_order_relaxed) and allocation_observer) {
+        allocation_observer->released(static_cast<Value*>(pointer));
+    }
+    if (not memory_accounted) {
+        ::operator delete(pointer);
+        return;
+    }
+    auto const header = header_of(pointer);
+    if (header->account) {
+        header->account->credit(header->size + header->owned);
+    }
+    ::operator delete(header);
+}
+
+auto viua::types::Value::charge_owned_memory(const std::size_t size) -> void {
+    if (not memory_accounted) {
+        return;
+    }
+    auto const header = header_of(this);
+    if (header->account and size > header->owned) {
+        header->account->charge(size - header->owned);
+    } else if (header->account and size < header->owned) {
+        header->account->credit(header->owned - size);
+    }
+    header->owned = size;
+}
+
+auto viua::types::Value::charge_to(MemoryAccount* account) -> void {
+    if (not memory_accounted) {
+        return;
+    }
+    auto const header = header_of(this);
+    if (header->account == account) {
+        return;
+    }
+    auto const charged = (header->size + header->owned);
+    if (account) {
+        account->charge(charged);
+    }
+    if (header->account) {
+        header->account->credit(charged);
+    }
+    header->account = account;
+}
+
+
 string viua::types::Value::type() const { return "Value"; }
 string viua::types::Value::str() const {
     ostringstream s;
@@ -42,6 +165,7 @@ bool viua::types::Value::boolean() const {
      */
     return false;
 }
+std::size_t viua::types::Value::memory_footprint() const { return sizeof(Value); }
 
 
 unique_ptr<viua::types::Pointer> viua::types::Value::pointer(
@@ -54,8 +178,13 @@ vector<string> viua::types::Value::bases() const { return vector<string>{"Value"
 vector<string> viua::types::Value::inheritancechain() const { return vector<string>{"Value"}; }
 
 
+viua::types::Value::Value(const Value&) {}
+auto viua::types::Value::operator=(const Value&) -> Value& { return *this; }
+
 viua::types::Value::~Value() {
-    for (auto p : pointers) {
-        p->invalidate(this);
+    if (pointers) {
+        for (auto p : *pointers) {
+            p->invalidate(this);
+        }
     }
 }
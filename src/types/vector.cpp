@@ -17,12 +17,20 @@
  *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <vector>
 #include <viua/exceptions.h>
 #include <viua/util/exceptions.h>
+#include <viua/types/boolean.h>
+#include <viua/types/number.h>
 #include <viua/types/value.h>
 #include <viua/types/vector.h>
 using namespace std;
@@ -31,118 +39,483 @@ using viua::util::exceptions::make_unique_exception;
 
 const string viua::types::Vector::type_name = "Vector";
 
-void viua::types::Vector::insert(long int index, unique_ptr<viua::types::Value> object) {
-    long offset = 0;
+auto viua::types::Vector::offset_of(long int index, const bool for_insertion) const -> size_t {
+    const auto length = size();
 
-    // FIXME: REFACTORING: move bounds-checking to a separate function
-    if (index > 0 and static_cast<decltype(internal_object)::size_type>(index) > internal_object.size()) {
-        ostringstream oss;
-        oss << "positive vector index out of range: index = " << index
-            << ", size = " << internal_object.size();
-        throw make_unique_exception<OutOfRangeException>(oss.str());
-    } else if (index < 0 and
-               static_cast<decltype(internal_object)::size_type>(-index) > internal_object.size()) {
+    if (for_insertion) {
+        if (index > 0 and static_cast<size_t>(index) > length) {
+            ostringstream oss;
+            oss << "positive vector index out of range: index = " << index << ", size = " << length;
+            throw make_unique_exception<OutOfRangeException>(oss.str());
+        }
+    } else if (length == 0) {
+        throw make_unique_exception<OutOfRangeException>("empty vector index out of range");
+    } else if (index > 0 and static_cast<size_t>(index) >= length) {
+        throw make_unique_exception<OutOfRangeException>("positive vector index out of range");
+    }
+    if (index < 0 and static_cast<size_t>(-index) > length) {
         throw make_unique_exception<OutOfRangeException>("negative vector index out of range");
     }
-    if (index < 0) {
-        offset = (static_cast<decltype(index)>(internal_object.size()) + index);
-    } else {
-        offset = index;
+
+    return static_cast<size_t>(index < 0 ? (static_cast<long int>(length) + index) : index);
+}
+
+auto viua::types::Vector::storage_for(const Value* object) const -> Storage {
+    /*
+     *  Only exact types are unboxed.
+     *  Anything derived from them must keep its dynamic type so it stays boxed.
+     */
+    const auto& object_type = typeid(*object);
+    if (object_type == typeid(Integer)) {
+        return Storage::INTEGER;
+    } else if (object_type == typeid(Float)) {
+        return Storage::FLOAT;
+    } else if (object_type == typeid(Boolean)) {
+        return Storage::BOOLEAN;
+    } else if (object_type == typeid(Bits)) {
+        const auto width = static_cast<const Bits*>(object)->size();
+        if (width != 0 and (storage != Storage::BITS or width == bits_width)) {
+            return Storage::BITS;
+        }
     }
+    return Storage::BOXED;
+}
 
-    auto it = (internal_object.begin() + offset);
-    internal_object.insert(it, std::move(object));
+auto viua::types::Vector::box(size_t i) const -> unique_ptr<Value> {
+    switch (storage) {
+    case Storage::INTEGER:
+        return make_unique<Integer>(integer_elements[i]);
+    case Storage::FLOAT:
+        return make_unique<Float>(float_elements[i]);
+    case Storage::BOOLEAN:
+        return make_unique<Boolean>(boolean_elements[i] != 0);
+    case Storage::BITS: {
+        auto first = boolean_elements.begin() + static_cast<long int>(i * bits_width);
+        return make_unique<Bits>(vector<bool>(first, first + static_cast<long int>(bits_width)));
+    }
+    case Storage::BOXED:
+    default:
+        return internal_object[i]->copy();
+    }
 }
 
-void viua::types::Vector::push(unique_ptr<viua::types::Value> object) {
-    internal_object.emplace_back(std::move(object));
+auto viua::types::Vector::unbox(size_t i, unique_ptr<Value> object) -> void {
+    switch (storage) {
+    case Storage::INTEGER:
+        integer_elements.insert(integer_elements.begin() + static_cast<long int>(i),
+                                static_cast<Integer*>(object.get())->as_integer());
+        break;
+    case Storage::FLOAT:
+        float_elements.insert(float_elements.begin() + static_cast<long int>(i),
+                              static_cast<Float*>(object.get())->as_float());
+        break;
+    case Storage::BOOLEAN:
+        boolean_elements.insert(boolean_elements.begin() + static_cast<long int>(i),
+                                static_cast<uint8_t>(object->boolean()));
+        break;
+    case Storage::BITS: {
+        auto bits = static_cast<Bits*>(object.get());
+        vector<uint8_t> flattened(bits_width);
+        for (Bits::size_type k = 0; k < bits_width; ++k) {
+            flattened[k] = static_cast<uint8_t>(bits->at(k));
+        }
+        boolean_elements.insert(boolean_elements.begin() + static_cast<long int>(i * bits_width),
+                                flattened.begin(), flattened.end());
+        break;
+    }
+    case Storage::BOXED:
+    default:
+        internal_object.insert(internal_object.begin() + static_cast<long int>(i), std::move(object));
+    }
 }
 
-unique_ptr<viua::types::Value> viua::types::Vector::pop(long int index) {
-    long offset = 0;
+auto viua::types::Vector::charge_storage() -> void {
+    auto bytes = internal_object.capacity() * sizeof(decltype(internal_object)::value_type);
+    bytes += integer_elements.capacity() * sizeof(decltype(integer_elements)::value_type);
+    bytes += float_elements.capacity() * sizeof(decltype(float_elements)::value_type);
+    bytes += boolean_elements.capacity() * sizeof(decltype(boolean_elements)::value_type);
+    charge_owned_memory(bytes);
+}
 
-    // FIXME: REFACTORING: move bounds-checking to a separate function
-    if (internal_object.size() == 0) {
-        throw make_unique_exception<OutOfRangeException>("empty vector index out of range");
-    } else if (index > 0 and
-               static_cast<decltype(internal_object)::size_type>(index) >= internal_object.size()) {
-        throw make_unique_exception<OutOfRangeException>("positive vector index out of range");
-    } else if (index < 0 and
-               static_cast<decltype(internal_object)::size_type>(-index) > internal_object.size()) {
-        throw make_unique_exception<OutOfRangeException>("negative vector index out of range");
+auto viua::types::Vector::make_boxed() -> void {
+    if (storage == Storage::BOXED) {
+        return;
     }
 
-    if (index < 0) {
-        offset = (static_cast<decltype(index)>(internal_object.size()) + index);
-    } else {
-        offset = index;
+    const auto length = size();
+    internal_object.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        internal_object.emplace_back(box(i));
     }
 
-    auto it = (internal_object.begin() + offset);
-    unique_ptr<viua::types::Value> object = std::move(*it);
-    internal_object.erase(it);
-    return object;
+    integer_elements.clear();
+    float_elements.clear();
+    boolean_elements.clear();
+    bits_width = 0;
+    storage = Storage::BOXED;
+    charge_storage();
 }
 
-viua::types::Value* viua::types::Vector::at(long int index) {
-    long offset = 0;
+void viua::types::Vector::insert(long int index, unique_ptr<viua::types::Value> object) {
+    const auto offset = offset_of(index, true);
 
-    // FIXME: REFACTORING: move bounds-checking to a separate function
-    if (internal_object.size() == 0) {
-        throw make_unique_exception<OutOfRangeException>("empty vector index out of range");
-    } else if (index > 0 and
-               static_cast<decltype(internal_object)::size_type>(index) >= internal_object.size()) {
-        throw make_unique_exception<OutOfRangeException>("positive vector index out of range");
-    } else if (index < 0 and
-               static_cast<decltype(internal_object)::size_type>(-index) > internal_object.size()) {
-        throw make_unique_exception<OutOfRangeException>("negative vector index out of range");
+    if (storage == Storage::BOXED and internal_object.empty()) {
+        storage = storage_for(object.get());
+        if (storage == Storage::BITS) {
+            bits_width = static_cast<Bits*>(object.get())->size();
+        }
+    } else if (storage != Storage::BOXED and storage_for(object.get()) != storage) {
+        make_boxed();
     }
 
-    if (index < 0) {
-        offset = (static_cast<decltype(index)>(internal_object.size()) + index);
-    } else {
-        offset = index;
+    unbox(offset, std::move(object));
+    charge_storage();
+}
+
+void viua::types::Vector::push(unique_ptr<viua::types::Value> object) {
+    insert(static_cast<long int>(size()), std::move(object));
+}
+
+unique_ptr<viua::types::Value> viua::types::Vector::pop(long int index) {
+    const auto offset = offset_of(index, false);
+
+    if (storage == Storage::BOXED) {
+        auto it = (internal_object.begin() + static_cast<long int>(offset));
+        unique_ptr<viua::types::Value> object = std::move(*it);
+        internal_object.erase(it);
+        return object;
     }
 
-    auto it = (internal_object.begin() + offset);
-    return it->get();
+    auto object = box(offset);
+    const auto first = static_cast<long int>(offset);
+    switch (storage) {
+    case Storage::INTEGER:
+        integer_elements.erase(integer_elements.begin() + first);
+        break;
+    case Storage::FLOAT:
+        float_elements.erase(float_elements.begin() + first);
+        break;
+    case Storage::BOOLEAN:
+        boolean_elements.erase(boolean_elements.begin() + first);
+        break;
+    case Storage::BITS: {
+        const auto width = static_cast<long int>(bits_width);
+        boolean_elements.erase(boolean_elements.begin() + (first * width),
+                               boolean_elements.begin() + ((first + 1) * width));
+        break;
+    }
+    case Storage::BOXED:
+    default:
+        break;
+    }
+    return object;
+}
+
+viua::types::Value* viua::types::Vector::at(long int index) {
+    const auto offset = offset_of(index, false);
+
+    // pointers must refer to live values so the elements have to be boxed
+    make_boxed();
+
+    return internal_object[offset].get();
 }
 
 int viua::types::Vector::len() {
     // FIXME: should return unsigned
     // FIXME: VM does not have unsigned integer type so return value has
     // to be converted to signed integer
-    return static_cast<int>(internal_object.size());
+    return static_cast<int>(size());
+}
+
+auto viua::types::Vector::size() const -> size_t {
+    switch (storage) {
+    case Storage::INTEGER:
+        return integer_elements.size();
+    case Storage::FLOAT:
+        return float_elements.size();
+    case Storage::BOOLEAN:
+        return boolean_elements.size();
+    case Storage::BITS:
+        return (boolean_elements.size() / bits_width);
+    case Storage::BOXED:
+    default:
+        return internal_object.size();
+    }
+}
+
+auto viua::types::Vector::storage_kind() const -> Storage { return storage; }
+
+auto viua::types::Vector::numeric_storage() const -> Storage {
+    if (storage == Storage::INTEGER or storage == Storage::FLOAT) {
+        return storage;
+    }
+    if (storage != Storage::BOXED) {
+        throw make_unique<Exception>("expected vector of numbers");
+    }
+
+    auto kind = Storage::INTEGER;
+    for (const auto& each : internal_object) {
+        const auto& each_type = typeid(*each);
+        if (each_type == typeid(Float)) {
+            kind = Storage::FLOAT;
+        } else if (each_type != typeid(Integer)) {
+            throw make_unique<Exception>("expected vector of numbers");
+        }
+    }
+    return kind;
+}
+
+template<typename T> auto viua::types::Vector::elements_as(vector<T>& scratch) const -> const vector<T>& {
+    if constexpr (is_same_v<T, Integer::underlying_type>) {
+        if (storage == Storage::INTEGER) {
+            return integer_elements;
+        }
+    }
+    if constexpr (is_same_v<T, Float::underlying_type>) {
+        if (storage == Storage::FLOAT) {
+            return float_elements;
+        }
+    }
+
+    scratch.clear();
+    scratch.reserve(size());
+    if (storage == Storage::INTEGER) {
+        for (const auto each : integer_elements) {
+            scratch.push_back(static_cast<T>(each));
+        }
+    } else if (storage == Storage::FLOAT) {
+        for (const auto each : float_elements) {
+            scratch.push_back(static_cast<T>(each));
+        }
+    } else {
+        for (const auto& each : internal_object) {
+            auto number = static_cast<const numeric::Number*>(each.get());
+            if constexpr (is_integral_v<T>) {
+                scratch.push_back(number->as_integer());
+            } else {
+                scratch.push_back(number->as_float());
+            }
+        }
+    }
+    return scratch;
+}
+
+template<typename Reduction>
+auto viua::types::Vector::reduce(Reduction reduction) const -> unique_ptr<Value> {
+    if (numeric_storage() == Storage::INTEGER) {
+        vector<Integer::underlying_type> scratch;
+        return make_unique<Integer>(reduction(elements_as(scratch)));
+    }
+    vector<Float::underlying_type> scratch;
+    return make_unique<Float>(reduction(elements_as(scratch)));
+}
+
+template<typename Operation>
+auto viua::types::Vector::elementwise(const Vector& that, Operation operation) const -> unique_ptr<Vector> {
+    if (size() != that.size()) {
+        ostringstream oss;
+        oss << "vector lengths differ: " << size() << " != " << that.size();
+        throw make_unique<Exception>(oss.str());
+    }
+
+    auto result = make_unique<Vector>();
+    const auto length = size();
+    if (numeric_storage() == Storage::INTEGER and that.numeric_storage() == Storage::INTEGER) {
+        vector<Integer::underlying_type> lhs_scratch, rhs_scratch;
+        const auto& lhs = elements_as(lhs_scratch);
+        const auto& rhs = that.elements_as(rhs_scratch);
+
+        result->storage = Storage::INTEGER;
+        result->integer_elements.resize(length);
+        auto out = result->integer_elements.data();
+        for (size_t i = 0; i < length; ++i) {
+            out[i] = operation(lhs[i], rhs[i]);
+        }
+    } else {
+        vector<Float::underlying_type> lhs_scratch, rhs_scratch;
+        const auto& lhs = elements_as(lhs_scratch);
+        const auto& rhs = that.elements_as(rhs_scratch);
+
+        result->storage = Storage::FLOAT;
+        result->float_elements.resize(length);
+        auto out = result->float_elements.data();
+        for (size_t i = 0; i < length; ++i) {
+            out[i] = operation(lhs[i], rhs[i]);
+        }
+    }
+    result->charge_storage();
+    return result;
+}
+
+auto viua::types::Vector::sum() const -> unique_ptr<Value> {
+    return reduce([](const auto& elements) {
+        using element_type = typename remove_reference_t<decltype(elements)>::value_type;
+        return accumulate(elements.begin(), elements.end(), element_type{0});
+    });
+}
+
+auto viua::types::Vector::min() const -> unique_ptr<Value> {
+    if (size() == 0) {
+        throw make_unique_exception<OutOfRangeException>("minimum of empty vector");
+    }
+    return reduce([](const auto& elements) { return *min_element(elements.begin(), elements.end()); });
+}
+
+auto viua::types::Vector::max() const -> unique_ptr<Value> {
+    if (size() == 0) {
+        throw make_unique_exception<OutOfRangeException>("maximum of empty vector");
+    }
+    return reduce([](const auto& elements) { return *max_element(elements.begin(), elements.end()); });
+}
+
+auto viua::types::Vector::dot(const Vector& that) const -> unique_ptr<Value> {
+    if (size() != that.size()) {
+        ostringstream oss;
+        oss << "vector lengths differ: " << size() << " != " << that.size();
+        throw make_unique<Exception>(oss.str());
+    }
+
+    if (numeric_storage() == Storage::INTEGER and that.numeric_storage() == Storage::INTEGER) {
+        vector<Integer::underlying_type> lhs_scratch, rhs_scratch;
+        const auto& lhs = elements_as(lhs_scratch);
+        const auto& rhs = that.elements_as(rhs_scratch);
+        return make_unique<Integer>(
+            inner_product(lhs.begin(), lhs.end(), rhs.begin(), Integer::underlying_type{0}));
+    }
+
+    vector<Float::underlying_type> lhs_scratch, rhs_scratch;
+    const auto& lhs = elements_as(lhs_scratch);
+    const auto& rhs = that.elements_as(rhs_scratch);
+    return make_unique<Float>(inner_product(lhs.begin(), lhs.end(), rhs.begin(), Float::underlying_type{0}));
+}
+
+auto viua::types::Vector::add(const Vector& that) const -> unique_ptr<Vector> {
+    return elementwise(that, [](auto lhs, auto rhs) { return lhs + rhs; });
+}
+
+auto viua::types::Vector::sub(const Vector& that) const -> unique_ptr<Vector> {
+    return elementwise(that, [](auto lhs, auto rhs) { return lhs - rhs; });
+}
+
+auto viua::types::Vector::mul(const Vector& that) const -> unique_ptr<Vector> {
+    return elementwise(that, [](auto lhs, auto rhs) { return lhs * rhs; });
+}
+
+auto viua::types::Vector::div(const Vector& that) const -> unique_ptr<Vector> {
+    if (numeric_storage() == Storage::INTEGER and that.numeric_storage() == Storage::INTEGER and
+        size() == that.size()) {
+        vector<Integer::underlying_type> lhs_scratch, rhs_scratch;
+        const auto& dividends = elements_as(lhs_scratch);
+        const auto& divisors = that.elements_as(rhs_scratch);
+        if (find(divisors.begin(), divisors.end(), 0) != divisors.end()) {
+            throw make_unique<Exception>("division by zero");
+        }
+        // the quotient of the smallest integer and -1 does not fit in an integer (and traps)
+        for (size_t i = 0; i < dividends.size(); ++i) {
+            if (dividends[i] == numeric_limits<Integer::underlying_type>::min() and divisors[i] == -1) {
+                throw make_unique<Exception>("integer overflow in division");
+            }
+        }
+    }
+    return elementwise(that, [](auto lhs, auto rhs) { return lhs / rhs; });
+}
+
+auto viua::types::Vector::sort() -> void {
+    switch (storage) {
+    case Storage::INTEGER:
+        std::sort(integer_elements.begin(), integer_elements.end());
+        break;
+    case Storage::FLOAT: {
+        // NaNs are not ordered with anything (not even themselves) so they are put last
+        auto nans = partition(float_elements.begin(), float_elements.end(),
+                              [](const Float::underlying_type each) { return not isnan(each); });
+        std::sort(float_elements.begin(), nans);
+        break;
+    }
+    case Storage::BOOLEAN:
+        std::sort(boolean_elements.begin(), boolean_elements.end());
+        break;
+    case Storage::BITS:
+        throw make_unique<Exception>("cannot sort vector of Bits");
+    case Storage::BOXED:
+    default: {
+        const auto kind = numeric_storage();
+        std::stable_sort(internal_object.begin(), internal_object.end(),
+                         [kind](const unique_ptr<Value>& lhs, const unique_ptr<Value>& rhs) {
+                             auto l = static_cast<const numeric::Number*>(lhs.get());
+                             auto r = static_cast<const numeric::Number*>(rhs.get());
+                             if (kind == Storage::INTEGER) {
+                                 return (l->as_integer() < r->as_integer());
+                             }
+                             // NaNs are equivalent to each other, and greater than any number
+                             if (isnan(l->as_float())) {
+                                 return false;
+                             }
+                             return (isnan(r->as_float()) or l->as_float() < r->as_float());
+                         });
+    }
+    }
 }
 
 string viua::types::Vector::type() const { return "Vector"; }
 
 string viua::types::Vector::str() const {
+    const auto length = size();
     ostringstream oss;
     oss << "[";
-    for (decltype(internal_object)::size_type i = 0; i < internal_object.size(); ++i) {
-        oss << internal_object[i]->repr() << (i < internal_object.size() - 1 ? ", " : "");
+    for (size_t i = 0; i < length; ++i) {
+        oss << (storage == Storage::BOXED ? internal_object[i]->repr() : box(i)->repr())
+            << (i < length - 1 ? ", " : "");
     }
     oss << "]";
     return oss.str();
 }
 
-bool viua::types::Vector::boolean() const { return internal_object.size() != 0; }
+bool viua::types::Vector::boolean() const { return size() != 0; }
+
+std::size_t viua::types::Vector::memory_footprint() const {
+    auto footprint = sizeof(Vector);
+    footprint += internal_object.capacity() * sizeof(decltype(internal_object)::value_type);
+    for (const auto& each : internal_object) {
+        footprint += (each ? each->memory_footprint() : 0);
+    }
+    footprint += integer_elements.capacity() * sizeof(decltype(integer_elements)::value_type);
+    footprint += float_elements.capacity() * sizeof(decltype(float_elements)::value_type);
+    footprint += boolean_elements.capacity() * sizeof(decltype(boolean_elements)::value_type);
+    return footprint;
+}
 
 unique_ptr<viua::types::Value> viua::types::Vector::copy() const {
     auto v = make_unique<Vector>();
-    for (unsigned i = 0; i < internal_object.size(); ++i) {
-        v->push(internal_object[i]->copy());
+    v->storage = storage;
+    v->integer_elements = integer_elements;
+    v->float_elements = float_elements;
+    v->boolean_elements = boolean_elements;
+    v->bits_width = bits_width;
+    v->internal_object.reserve(internal_object.size());
+    for (const auto& each : internal_object) {
+        v->internal_object.emplace_back(each->copy());
     }
+    v->charge_storage();
     return std::move(v);
 }
 
-vector<unique_ptr<viua::types::Value>>& viua::types::Vector::value() { return internal_object; }
+auto viua::types::Vector::charge_to(MemoryAccount* account) -> void {
+    Value::charge_to(account);
+    for (const auto& each : internal_object) {
+        each->charge_to(account);
+    }
+}
+
+vector<unique_ptr<viua::types::Value>>& viua::types::Vector::value() {
+    make_boxed();
+    return internal_object;
+}
 
-viua::types::Vector::Vector() {}
-viua::types::Vector::Vector(const std::vector<viua::types::Value*>& v) {
+viua::types::Vector::Vector() : storage(Storage::BOXED), bits_width(0) {}
+viua::types::Vector::Vector(const std::vector<viua::types::Value*>& v) : Vector() {
     for (unsigned i = 0; i < v.size(); ++i) {
-        internal_object.push_back(v[i]->copy());
+        push(v[i]->copy());
     }
 }
 viua::types::Vector::~Vector() {}
@@ -42,6 +42,9 @@ import os
 import subprocess
 import sys
 import re
+import socket
+import struct
+import time
 import unittest
 
 
@@ -131,6 +134,26 @@ def run(path, expected_exit_code=0, pipe_error=False):
         raise ViuaCPUError('{0} [{1}]: {2}'.format(path, exit_code, output.decode('utf-8').strip()))
     return (exit_code, output.decode('utf-8'), (error if error is not None else b'').decode('utf-8'))
 
+def run_image(path, expected_exit_code=0):
+    """Run given kernel image with Viua CPU and return its output.
+    """
+    p = subprocess.Popen((VIUA_KERNEL_PATH, '--image', path), stdout=subprocess.PIPE)
+    output, error = p.communicate()
+    exit_code = p.wait()
+    if exit_code != expected_exit_code:
+        raise ViuaCPUError('{0} [{1}]: {2}'.format(path, exit_code, output.decode('utf-8').strip()))
+    return (exit_code, output.decode('utf-8'), '')
+
+def run_with_environment(path, variables):
+    """Run given bytecode file with additional environment variables and return
+    its exit code and output.
+    """
+    environment = dict(os.environ)
+    environment.update(variables)
+    p = subprocess.Popen((VIUA_KERNEL_PATH, path), env=environment, stdout=subprocess.PIPE)
+    output, error = p.communicate(timeout=30)
+    return (p.wait(), output.decode('utf-8').strip())
+
 FLAG_TEST_ONLY_ASSEMBLING = bool(int(os.environ.get('VIUA_TEST_ONLY_ASMING', 0)))
 MEMORY_LEAK_CHECKS_SKIPPED = 0
 MEMORY_LEAK_CHECKS_RUN = 0
@@ -413,6 +436,14 @@ def extractExceptionsThrown(output):
 def extractFirstException(output):
     return extractExceptionsThrown(output)[0]
 
+def restoreEnvironment(name, value):
+    # a variable that was not set before a test must be removed, not set to
+    # an empty string - an empty value may mean something else
+    if value is None:
+        os.environ.pop(name, None)
+    else:
+        os.environ[name] = value
+
 def runTestThrowsException(self, name, expected_output, assembly_opts=None):
     runTest(self, name, expected_error=expected_output, expected_exit_code=1, error_processing_function=extractFirstException, valgrind_enable=False, assembly_opts=assembly_opts)
 
@@ -580,6 +611,9 @@ class StringInstructionsTests(unittest.TestCase):
     def testHelloWorld(self):
         runTest(self, 'hello_world.asm', 'Hello World!', 0)
 
+    def testFormat(self):
+        runTest(self, 'format.asm', '2 + 2 = 4 (#{ #{01} #{x)', 0)
+
 
 class StringInstructionsEscapeSequencesTests(unittest.TestCase):
     """Tests for escape sequence decoding.
@@ -1345,6 +1379,34 @@ class VectorInstructionsTests(unittest.TestCase):
     def testVAT(self):
         runTest(self, 'vat.asm', ['0', '1', '1', 'Hello World!'], 0, lambda o: o.strip().splitlines())
 
+    def testVPUSHOfMixedTypes(self):
+        runTest(self, 'vpush_mixed_types.asm', ['[1, 2, "three"]', 'three', '2'], 0, lambda o: o.strip().splitlines())
+
+    def testVSUMVMINVMAX(self):
+        runTest(self, 'vsum.asm', ['10', '1', '4'], 0, lambda o: o.strip().splitlines())
+
+    def testVSUMOfMixedNumbers(self):
+        runTest(self, 'vsum_of_mixed_numbers.asm', '3.500000')
+
+    def testVDOT(self):
+        runTest(self, 'vdot.asm', '32')
+
+    def testElementwiseArithmetic(self):
+        runTest(self, 'velementwise.asm', ['[7, 10, 15]', '[5, 6, 5]', '[6, 16, 50]', '[6, 4, 2]'], 0, lambda o: o.strip().splitlines())
+
+    def testVDIVByZero(self):
+        runTestThrowsException(self, 'vdiv_by_zero.asm', ('Exception', 'division by zero',))
+
+    def testVDIVOfSmallestIntegerByMinusOne(self):
+        runTestThrowsException(self, 'vdiv_overflow.asm', ('Exception', 'integer overflow in division',))
+
+    def testVSORT(self):
+        runTest(self, 'vsort.asm', '[1, 2, 3]')
+
+    def testVSORTPutsNaNsLast(self):
+        runTest(self, 'vsort_nan.asm', ['[0.500000, 1.000000, 2.000000, nan, nan]'] * 2, 0,
+                lambda o: o.strip().splitlines())
+
 
 class CastingInstructionsTests(unittest.TestCase):
     """Tests for byte instructions.
@@ -1501,6 +1563,21 @@ class FunctionTests(unittest.TestCase):
     def testBasicFunctionSupport(self):
         runTest(self, 'definition.asm', 42, 0, lambda o: int(o.strip()))
 
+    def testBasicFunctionSupportWithoutSymbolIndex(self):
+        runTest(self, 'definition.asm', 42, 0, lambda o: int(o.strip()), assembly_opts=('--no-symbol-index',))
+
+    def testCorruptedBytecodeIsRejectedWhenLoaded(self):
+        compiled_path = './build/test/corrupted_definition.bin'
+        assemble(os.path.join(self.PATH, 'definition.asm'), compiled_path, opts=('--no-symbol-index',))
+
+        # without the symbol index the last byte of the file is the final RETURN of main
+        with open(compiled_path, 'r+b') as iostream:
+            iostream.seek(-1, os.SEEK_END)
+            iostream.write(bytes([0xff]))
+
+        excode, output, error = run(compiled_path, 1)
+        self.assertTrue(output.strip().startswith('error: bytecode verification failed: invalid opcode 255 at 0x'))
+
     def testNestedFunctionCallSupport(self):
         runTestReturnsIntegers(self, 'nested_calls.asm', [2015, 1995, 69, 42])
 
@@ -2915,6 +2992,32 @@ class MiscExceptionTests(unittest.TestCase):
         assemble(os.path.join(self.PATH, source_lib), out=lib_path, opts=('--lib',))
         runTest(self, 'thrown_in_linked_caught_in_static_base.asm', 'looks falsey: 0')
 
+    def testCatchingExceptionThrownInLazilyLinkedModule(self):
+        source_lib = 'thrown_in_linked_caught_in_static_fun.asm'
+        lib_path = 'test_module.vlib'
+        assemble(os.path.join(self.PATH, source_lib), out=lib_path, opts=('--lib',))
+        was = os.environ.get('VIUA_LAZY_LINKING')
+        os.environ['VIUA_LAZY_LINKING'] = 'yes'
+        try:
+            runTest(self, 'thrown_in_linked_caught_in_static_base.asm', 'looks falsey: 0')
+        finally:
+            restoreEnvironment('VIUA_LAZY_LINKING', was)
+
+    def testCatchingExceptionThrownInPreloadedModule(self):
+        source_lib = 'thrown_in_linked_caught_in_static_fun.asm'
+        lib_path = 'test_module.vlib'
+        assemble(os.path.join(self.PATH, source_lib), out=lib_path, opts=('--lib',))
+        was_native = os.environ.get('VIUAPRELINK')
+        was_foreign = os.environ.get('VIUAPREIMPORT')
+        # preloaded modules are loaded as one batch, in parallel
+        os.environ['VIUAPRELINK'] = 'test_module:std/vector'
+        os.environ['VIUAPREIMPORT'] = 'build/test/World'
+        try:
+            runTest(self, 'thrown_in_linked_caught_in_static_base.asm', 'looks falsey: 0')
+        finally:
+            restoreEnvironment('VIUAPRELINK', was_native)
+            restoreEnvironment('VIUAPREIMPORT', was_foreign)
+
     def testVectorOutOfRangeRead(self):
         runTestThrowsException(self, 'vector_out_of_range_read.asm', ('OutOfRangeException', 'positive vector index out of range',))
 
@@ -2951,6 +3054,377 @@ class MiscTests(unittest.TestCase):
     def testMangledNestedBlockNames(self):
         runTest(self, 'mangled_nested_block_names.asm', '')
 
+    def testRunningFromKernelImage(self):
+        lib_path = 'test_module.vlib'
+        compiled_path = './build/test/image_base.bin'
+        image_path = './build/test/image_base.img'
+        assemble('./sample/asm/exceptions/thrown_in_linked_caught_in_static_fun.asm', out=lib_path, opts=('--lib',))
+        assemble('./sample/asm/exceptions/thrown_in_linked_caught_in_static_base.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUAPRELINK'] = 'test_module'
+        p = subprocess.Popen((VIUA_KERNEL_PATH, '--dump-image', image_path, compiled_path), env=environment)
+        self.assertEqual(0, p.wait())
+
+        # the module is linked into the image so its file is no longer needed
+        os.unlink(lib_path)
+        excode, output, error = run_image(image_path)
+        self.assertEqual(0, excode)
+        self.assertEqual('looks falsey: 0', output.strip())
+
+    def testJumpToItselfInKernelImageIsRejected(self):
+        compiled_path = './build/test/jump_to_next_instruction.bin'
+        image_path = './build/test/jump_to_next_instruction.img'
+        assemble(os.path.join(self.PATH, 'jump_to_next_instruction.asm'), out=compiled_path)
+        p = subprocess.Popen((VIUA_KERNEL_PATH, '--dump-image', image_path, compiled_path))
+        self.assertEqual(0, p.wait())
+
+        # make the jump point to itself and fix the checksum so that only the
+        # verifier can catch the problem
+        with open(image_path, 'rb') as ifstream:
+            image = bytearray(ifstream.read())
+        # magic, format version, VM version, hash of opcodes, checksum
+        vm_version = image.index(0) + 1 + 8
+        payload = image.index(0, vm_version) + 1 + 16
+        code = image.index(0, payload) + 1 + 8
+        self.assertEqual(9, struct.unpack_from('<Q', image, code + 1)[0])
+        struct.pack_into('<Q', image, code + 1, 0)
+        checksum = 0xcbf29ce484222325
+        for each in image[payload:]:
+            checksum = ((checksum ^ each) * 0x100000001b3) & 0xffffffffffffffff
+        struct.pack_into('<Q', image, payload - 8, checksum)
+        with open(image_path, 'wb') as ofstream:
+            ofstream.write(image)
+
+        p = subprocess.Popen((VIUA_KERNEL_PATH, '--image', image_path), stdout=subprocess.PIPE,
+                             stderr=subprocess.PIPE)
+        output, error = p.communicate(timeout=30)
+        self.assertEqual(1, p.wait())
+        self.assertEqual('error: invalid image: {}: executable: jump instruction at 0x0 jumps to itself'.format(
+            image_path), output.decode('utf-8').strip())
+
+    def testKernelImageFromDifferentVersionIsRejected(self):
+        compiled_path = './build/test/image_version.bin'
+        image_path = './build/test/image_version.img'
+        assemble(os.path.join(self.PATH, 'jump_to_next_instruction.asm'), out=compiled_path)
+        p = subprocess.Popen((VIUA_KERNEL_PATH, '--dump-image', image_path, compiled_path))
+        self.assertEqual(0, p.wait())
+
+        # the VM version is a NUL-terminated string that follows the magic and
+        # the format version
+        with open(image_path, 'rb') as ifstream:
+            image = bytearray(ifstream.read())
+        vm_version = image.index(0) + 1 + 8
+        image[vm_version] = ord('x')
+        with open(image_path, 'wb') as ofstream:
+            ofstream.write(image)
+
+        p = subprocess.Popen((VIUA_KERNEL_PATH, '--image', image_path), stdout=subprocess.PIPE,
+                             stderr=subprocess.PIPE)
+        output, error = p.communicate(timeout=30)
+        self.assertEqual(1, p.wait())
+        self.assertTrue(output.decode('utf-8').strip().startswith(
+            'error: image written by a different version of the VM (x'))
+
+    def testRunningFromKernelImageWithForeignLibrary(self):
+        compiled_path = './build/test/image_hello_world.bin'
+        image_path = './build/test/image_hello_world.img'
+        assemble('./sample/asm/external/hello_world.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUAPREIMPORT'] = 'build/test/World'
+        p = subprocess.Popen((VIUA_KERNEL_PATH, '--dump-image', image_path, compiled_path), env=environment)
+        self.assertEqual(0, p.wait())
+
+        excode, output, error = run_image(image_path)
+        self.assertEqual(0, excode)
+        self.assertEqual('Hello World!', output.strip())
+
+    def testTracingWritesBinaryTraceRecords(self):
+        compiled_path = './build/test/traced_message_passing.bin'
+        trace_path = './build/test/traced_message_passing.trace'
+        assemble('./sample/asm/concurrency/message_passing.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_ENABLE_TRACING'] = '1'
+        environment['VIUA_TRACE_FILE'] = trace_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+        self.assertEqual('Hello message passing World!', output.decode('utf-8').strip())
+
+        with open(trace_path, 'rb') as ifstream:
+            trace = ifstream.read()
+        magic, version, record_size = struct.unpack('=8sII', trace[:16])
+        self.assertEqual(b'VIUATRC\0', magic)
+        self.assertEqual(2, version)
+        self.assertEqual(32, record_size)
+
+        records = trace[16:]
+        self.assertEqual(0, len(records) % record_size)
+        pids = set()
+        for i in range(0, len(records), record_size):
+            timestamp, pid, ip, depth, scheduler, opcode, flags = struct.unpack('=QQQIHBB', records[i:i+record_size])
+            self.assertTrue(depth > 0)
+            pids.add(pid)
+        self.assertEqual(2, len(pids))
+
+    def testUnwritableTraceFileIsReported(self):
+        compiled_path = './build/test/traced_message_passing.bin'
+        trace_path = './build/test/no_such_directory/traced_message_passing.trace'
+        assemble('./sample/asm/concurrency/message_passing.asm', out=compiled_path)
+        self.assertEqual((1, 'fatal: cannot open trace file: {}'.format(trace_path)),
+                         run_with_environment(compiled_path, {'VIUA_ENABLE_TRACING': '1', 'VIUA_TRACE_FILE': trace_path}))
+
+    def testOpcodeProfileIsWrittenAsJSON(self):
+        compiled_path = './build/test/profiled_message_passing.bin'
+        profile_path = './build/test/profiled_message_passing.json'
+        assemble('./sample/asm/concurrency/message_passing.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_OPCODE_PROFILE'] = profile_path
+        environment['VIUA_OPCODE_PROFILE_SAMPLING'] = '1'
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+
+        with open(profile_path) as ifstream:
+            profile = {each['opcode']: each for each in json.loads(ifstream.read())['opcodes']}
+        self.assertEqual(1, profile['print']['executions'])
+        self.assertEqual(2, profile['send']['executions'])
+        self.assertEqual(profile['send']['executions'], profile['send']['samples'])
+
+    def testOpcodeProfileIsWrittenAsTable(self):
+        compiled_path = './build/test/profiled_message_passing.bin'
+        profile_path = './build/test/profiled_message_passing.txt'
+        assemble('./sample/asm/concurrency/message_passing.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_OPCODE_PROFILE'] = profile_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+
+        with open(profile_path) as ifstream:
+            rows = [line.split() for line in ifstream.read().splitlines()]
+        self.assertEqual(['opcode', 'executions', 'share', 'samples', 'mean', 'cycles'], rows[0])
+        self.assertIn(['send', '2'], [row[:2] for row in rows])
+
+    def testInvalidOpcodeProfileSamplingIsReported(self):
+        compiled_path = './build/test/profiled_message_passing.bin'
+        assemble('./sample/asm/concurrency/message_passing.asm', out=compiled_path)
+        self.assertEqual((1, 'fatal: invalid value of VIUA_OPCODE_PROFILE_SAMPLING: "often" (expected a number)'),
+                         run_with_environment(compiled_path, {
+                             'VIUA_OPCODE_PROFILE': './build/test/profiled_message_passing.json',
+                             'VIUA_OPCODE_PROFILE_SAMPLING': 'often',
+                         }))
+
+    def testStackProfileIsWrittenInCollapsedFormat(self):
+        compiled_path = './build/test/stack_sampling.bin'
+        profile_path = './build/test/stack_sampling.folded'
+        assemble('./sample/asm/misc/stack_sampling.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_STACK_PROFILE'] = profile_path
+        environment['VIUA_STACK_PROFILE_INTERVAL'] = '100'
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+        self.assertEqual('Hello sampled World!', output.decode('utf-8').strip())
+
+        with open(profile_path) as ifstream:
+            samples = dict(line.rsplit(' ', 1) for line in ifstream.read().splitlines())
+        self.assertIn('__entry;main/0;spin/1', samples)
+        self.assertIn('waiter/1;[receive]', samples)
+        self.assertTrue(all(int(count) > 0 for count in samples.values()))
+
+    def testInvalidStackProfileIntervalIsReported(self):
+        compiled_path = './build/test/stack_sampling.bin'
+        assemble('./sample/asm/misc/stack_sampling.asm', out=compiled_path)
+        self.assertEqual((1, 'fatal: invalid suffix in VIUA_STACK_PROFILE_INTERVAL: "us"'),
+                         run_with_environment(compiled_path, {
+                             'VIUA_STACK_PROFILE': './build/test/stack_sampling.folded',
+                             'VIUA_STACK_PROFILE_INTERVAL': '100us',
+                         }))
+
+    def testAllocationProfileCountsValuesByTypeAndSite(self):
+        compiled_path = './build/test/allocation_profile.bin'
+        profile_path = './build/test/allocation_profile.txt'
+        assemble('./sample/asm/process_abstraction/memory_usage.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_ALLOCATION_PROFILE'] = profile_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+        self.assertEqual('true', output.decode('utf-8').strip())
+
+        with open(profile_path) as ifstream:
+            types_section, sites_section = ifstream.read().split('\n\n')
+        types = {line.split()[0]: int(line.split()[1]) for line in types_section.splitlines()[1:]}
+        sites = [line.split() for line in sites_section.splitlines()[1:]]
+        self.assertEqual(1000, types['String'])
+        self.assertIn('Vector', types)
+        self.assertIn(['String', '1000'], [site[1:3] for site in sites if site[0].startswith('main/0+0x')])
+
+    def testInvalidAllocationProfileSamplingIsReported(self):
+        compiled_path = './build/test/allocation_profile.bin'
+        assemble('./sample/asm/process_abstraction/memory_usage.asm', out=compiled_path)
+        self.assertEqual((1, 'fatal: invalid value of VIUA_ALLOCATION_PROFILE_SAMPLING: "-1" (expected a number)'),
+                         run_with_environment(compiled_path, {
+                             'VIUA_ALLOCATION_PROFILE': './build/test/allocation_profile.txt',
+                             'VIUA_ALLOCATION_PROFILE_SAMPLING': '-1',
+                         }))
+
+    def testCallProfileCountsCallsOfFunctions(self):
+        compiled_path = './build/test/call_profile.bin'
+        profile_path = './build/test/call_profile.txt'
+        assemble('./sample/asm/misc/call_profile.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_CALL_PROFILE'] = profile_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+
+        with open(profile_path) as ifstream:
+            sections = ifstream.read().strip().split('\n\n')
+        self.assertEqual([
+            'Flat profile (all processes):',
+            'Call graph (all processes):',
+            'Flat profile (1 process started with __entry):',
+        ], sections[0::2])
+        calls = {line.split()[-1]: int(line.split()[-3]) for line in sections[1].splitlines()[1:]}
+        self.assertEqual({
+            '__entry': 1,
+            'main/0': 1,
+            'countdown/1': 4,
+            'report/0': 1,
+            'std::scheduler::statistics/0': 1,
+        }, calls)
+
+    def testCallProfileClosesFramesOfKilledProcessOnce(self):
+        compiled_path = './build/test/call_profile_of_killed_process.bin'
+        profile_path = './build/test/call_profile_of_killed_process.txt'
+        assemble('./sample/asm/misc/call_profile_of_killed_process.asm', out=compiled_path)
+        self.assertEqual((0, 'OH NOES!'), run_with_environment(compiled_path, {'VIUA_CALL_PROFILE': profile_path}))
+
+        with open(profile_path) as ifstream:
+            sections = ifstream.read().strip().split('\n\n')
+        calls = {line.split()[-1]: int(line.split()[-3]) for line in sections[1].splitlines()[1:]}
+        self.assertEqual({
+            '__entry': 1,
+            'main/0': 1,
+            'fail/0': 1,
+            'watchdog_process/1': 1,
+        }, calls)
+
+    def testSchedulerTelemetryIsExposed(self):
+        compiled_path = './build/test/scheduler_statistics.bin'
+        metrics_path = './build/test/scheduler_statistics.prom'
+        assemble('./sample/asm/misc/scheduler_statistics.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_VP_SCHEDULERS'] = '2'
+        environment['VIUA_METRICS_FILE'] = metrics_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(0, p.wait())
+        self.assertEqual('2', output.decode('utf-8').strip())
+
+        with open(metrics_path) as ifstream:
+            metrics = dict(line.rsplit(' ', 1) for line in ifstream.read().splitlines()
+                           if not line.startswith('#'))
+        self.assertIn('viua_scheduler_ticks_total{scheduler="0"}', metrics)
+        self.assertIn('viua_scheduler_ticks_total{scheduler="1"}', metrics)
+        self.assertTrue(int(metrics['viua_scheduler_ticks_total{scheduler="0"}']) > 0)
+        self.assertTrue(int(metrics['viua_scheduler_ffi_calls_total{scheduler="0"}']) > 0)
+        self.assertIn('viua_mailbox_high_water_mark_max', metrics)
+        self.assertEqual(metrics['viua_scheduler_bursts_total{scheduler="0"}'],
+                         metrics['viua_scheduler_burst_duration_seconds_bucket{scheduler="0",le="+Inf"}'])
+
+    def testSchedulerTelemetryIsKeptOnlyWhenRequested(self):
+        compiled_path = './build/test/scheduler_statistics.bin'
+        assemble('./sample/asm/misc/scheduler_statistics.asm', out=compiled_path)
+        self.assertEqual((0, '0'), run_with_environment(compiled_path, {'VIUA_VP_SCHEDULERS': '2'}))
+        self.assertEqual((0, '2'), run_with_environment(compiled_path, {
+            'VIUA_VP_SCHEDULERS': '2',
+            'VIUA_SCHEDULER_TELEMETRY': '1',
+        }))
+
+    def testInvalidMetricsIntervalIsReported(self):
+        compiled_path = './build/test/scheduler_statistics.bin'
+        assemble('./sample/asm/misc/scheduler_statistics.asm', out=compiled_path)
+        # the interval is read before schedulers start, so no process runs
+        self.assertEqual((1, 'fatal: invalid value of VIUA_METRICS_INTERVAL: "second" (expected a number)'),
+                         run_with_environment(compiled_path, {
+                             'VIUA_METRICS_FILE': './build/test/scheduler_statistics.prom',
+                             'VIUA_METRICS_INTERVAL': 'second',
+                         }))
+
+
+    def testIntrospectionSocketAnswersQueries(self):
+        compiled_path = './build/test/introspection.bin'
+        socket_path = './build/test/introspection.sock'
+        assemble('./sample/asm/misc/introspection.asm', out=compiled_path)
+        if os.path.exists(socket_path):
+            os.unlink(socket_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_VP_SCHEDULERS'] = '2'
+        environment['VIUA_INTROSPECTION_SOCKET'] = socket_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.DEVNULL)
+        try:
+            for i in range(100):
+                if os.path.exists(socket_path):
+                    break
+                time.sleep(0.05)
+
+            client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            client.connect(socket_path)
+            stream = client.makefile('rw')
+            def query(text):
+                stream.write(text + '\n')
+                stream.flush()
+                lines = []
+                line = stream.readline()
+                while line not in ('', '\n'):
+                    lines.append(line.rstrip('\n'))
+                    line = stream.readline()
+                return lines
+
+            # the module is imported by the main process so wait until it is linked
+            for i in range(100):
+                if 'std::vector' in query('modules'):
+                    break
+                time.sleep(0.05)
+            self.assertIn('std::vector', query('modules'))
+            self.assertIn('std::scheduler::statistics/0', query('foreign'))
+
+            processes = {}
+            for i in range(100):
+                processes = {line.split()[-1]: line.split() for line in query('processes')[1:]}
+                if processes.get('main/0', [None, None, None])[2] == 'receive' and 'waiter/0' in processes:
+                    break
+                time.sleep(0.05)
+            self.assertEqual('receive', processes['main/0'][2])
+            self.assertEqual('2', processes['main/0'][5])
+            self.assertEqual('receive', processes['waiter/0'][2])
+            self.assertRegex(processes['main/0'][0], r'^0x[0-9a-f]+#[0-9]+$')
+
+            stack = query('stack {}'.format(processes['main/0'][0]))
+            self.assertEqual(['  __entry', '  main/0'], stack[1:])
+            self.assertEqual(['error: no such process: 0x0'], query('stack 0x0'))
+
+            schedulers = query('schedulers')
+            self.assertEqual('vp schedulers: 2', schedulers[0])
+            self.assertEqual(2, len(schedulers[4:]))
+            stream.close()
+            client.close()
+        finally:
+            p.kill()
+            p.wait()
+
 
 class ExternalModulesTests(unittest.TestCase):
     """Tests for C/C++ module importing, and calling external functions.
@@ -2997,6 +3471,55 @@ class ExternalModulesTests(unittest.TestCase):
         ])
         runTest(self, 'many_hello_world.asm', expected_output, 0, output_processing_function=lambda _: sorted(_.strip().splitlines()))
 
+    def testModuleResolutionCache(self):
+        cache_path = './build/test/module_cache'
+        if os.path.exists(cache_path):
+            os.unlink(cache_path)
+        was = os.environ.get('VIUA_MODULE_CACHE')
+        was_path = os.environ.get('VIUAPATH')
+        os.environ['VIUA_MODULE_CACHE'] = cache_path
+        try:
+            runTest(self, 'hello_world.asm', 'Hello World!')
+            with open(cache_path) as ifstream:
+                cached = [line.split('\t') for line in ifstream.read().splitlines()]
+            self.assertEqual([('any', 'build/test/World', 'foreign',)], [tuple(each[1:4]) for each in cached])
+
+            # the second run uses the cached path
+            runTest(self, 'hello_world.asm', 'Hello World!')
+
+            # a different search path gets entries of its own
+            os.environ['VIUAPATH'] = '{}:./build/test'.format(was_path or '')
+            runTest(self, 'hello_world.asm', 'Hello World!')
+            with open(cache_path) as ifstream:
+                cached = [line.split('\t') for line in ifstream.read().splitlines()]
+            self.assertEqual(2, len(cached))
+            self.assertEqual(2, len(set(each[0] for each in cached)))
+        finally:
+            restoreEnvironment('VIUA_MODULE_CACHE', was)
+            restoreEnvironment('VIUAPATH', was_path)
+            if os.path.exists(cache_path):
+                os.unlink(cache_path)
+
+    def testPrelinkedModulesAreNeverForeign(self):
+        compiled_path = './build/test/prelink_foreign.bin'
+        assemble('./sample/asm/string/hello_world.asm', out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUAPRELINK'] = 'build/test/World'
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate()
+        self.assertEqual(1, p.wait())
+        self.assertEqual('fatal: preload: failed to link library: build/test/World', output.decode('utf-8').strip())
+
+    def testConcurrentImportOfTheSameModule(self):
+        expected_output = sorted([
+            'Hello Joe!',
+            'Hello Robert!',
+            'Hello Mike!',
+            'Hello Bjarne!',
+        ])
+        runTest(self, 'concurrent_import.asm', expected_output, 0, output_processing_function=lambda _: sorted(_.strip().splitlines()))
+
     def testLongRunningFunctionBlocksOneScheduler(self):
         # expected output must be sorted because it is not defined in what order the messages will be printed if
         # there is more than one FFI or VP scheduler running
@@ -3030,6 +3553,79 @@ class ProcessAbstractionTests(unittest.TestCase):
         # FIXME global registers should not be statically checked
         runTestReportsException(self, 'separate_global_rs.asm', ('Exception', 'read from null register: 1',), assembly_opts=('--no-sa',))
 
+    def testMemoryUsageGrowsWithValuesHeldByProcess(self):
+        runTest(self, 'memory_usage.asm', 'true')
+
+    def testExceedingMemoryLimitThrowsException(self):
+        os.environ['VIUA_PROCESS_MEMORY_LIMIT'] = '1M'
+        try:
+            runTest(self, 'memory_limit.asm', 'memory limit exceeded')
+        finally:
+            del os.environ['VIUA_PROCESS_MEMORY_LIMIT']
+
+    def testGrowingBuffersAreChargedToTheirOwner(self):
+        os.environ['VIUA_PROCESS_MEMORY_LIMIT'] = '1M'
+        try:
+            runTest(self, 'memory_limit_of_buffers.asm', 'memory limit exceeded')
+        finally:
+            del os.environ['VIUA_PROCESS_MEMORY_LIMIT']
+
+    def testMessagesAreNotChargedToTheirSender(self):
+        os.environ['VIUA_PROCESS_MEMORY_LIMIT'] = '64K'
+        try:
+            runTest(self, 'memory_limit_of_sender.asm', '5000')
+        finally:
+            del os.environ['VIUA_PROCESS_MEMORY_LIMIT']
+
+    def testMessagesAreChargedToTheirReceiver(self):
+        os.environ['VIUA_PROCESS_MEMORY_LIMIT'] = '64K'
+        try:
+            runTest(self, 'memory_limit_of_receiver.asm', 'memory limit exceeded')
+        finally:
+            del os.environ['VIUA_PROCESS_MEMORY_LIMIT']
+
+    def testInvalidMemoryLimitIsReported(self):
+        compiled_path = './build/test/invalid_memory_limit.bin'
+        assemble(os.path.join(self.PATH, 'memory_usage.asm'), out=compiled_path)
+        for value, message in (
+            ('1X', 'invalid suffix in VIUA_PROCESS_MEMORY_LIMIT: "X"'),
+            ('lots', 'invalid value of VIUA_PROCESS_MEMORY_LIMIT: "lots" (expected a number)'),
+            ('-1', 'invalid value of VIUA_PROCESS_MEMORY_LIMIT: "-1" (expected a number)'),
+            ('99999999999999999999', 'value of VIUA_PROCESS_MEMORY_LIMIT is too big: 99999999999999999999'),
+            ('99999999999G', 'value of VIUA_PROCESS_MEMORY_LIMIT is too big: 99999999999G'),
+        ):
+            self.assertEqual((1, 'fatal: ' + message),
+                             run_with_environment(compiled_path, {'VIUA_PROCESS_MEMORY_LIMIT': value}))
+
+    def testMailboxDepthAndMessageLatencyAreTracked(self):
+        os.environ['VIUA_MESSAGE_TIMESTAMPS'] = '1'
+        try:
+            runTestSplitlines(self, 'mailbox_depth.asm', ['10', '10', '0', '10', '10'])
+        finally:
+            del os.environ['VIUA_MESSAGE_TIMESTAMPS']
+
+    def testDeepestMailboxesRejectsNonIntegerLimit(self):
+        runTest(self, 'deepest_mailboxes_of_non_integer.asm', 'expected number of mailboxes (integer) as parameter 0')
+
+    def testHibernatedProcessKeepsItsRegisters(self):
+        runTestSplitlines(self, 'hibernate.asm', ['Hello', 'hibernated World!'])
+
+    def testHibernatedProcessWakesUpWhenReceiveTimesOut(self):
+        runTestThrowsException(self, 'hibernate_until_timeout.asm', ('Exception', 'no message received',))
+
+    def testIdleProcessesAreHibernatedAutomatically(self):
+        os.environ['VIUA_HIBERNATE_AFTER'] = '1'
+        try:
+            runTestSplitlines(self, 'hibernate.asm', ['Hello', 'hibernated World!'])
+        finally:
+            del os.environ['VIUA_HIBERNATE_AFTER']
+
+    def testInvalidHibernationThresholdIsReported(self):
+        compiled_path = './build/test/invalid_hibernation_threshold.bin'
+        assemble(os.path.join(self.PATH, 'hibernate.asm'), out=compiled_path)
+        self.assertEqual((1, 'fatal: invalid value of VIUA_HIBERNATE_AFTER: "soon" (expected a number)'),
+                         run_with_environment(compiled_path, {'VIUA_HIBERNATE_AFTER': 'soon'}))
+
 
 class ConcurrencyTests(unittest.TestCase):
     PATH = './sample/asm/concurrency'
@@ -3068,7 +3664,7 @@ class ConcurrencyTests(unittest.TestCase):
 
     def testTransferringExceptionsOnJoin(self):
         def match_output(self, excode, output):
-            pat = re.compile(r'^exception transferred from process Process: 0x[a-f0-9]+: Hello exception transferring World!$')
+            pat = re.compile(r'^exception transferred from process Process: 0x[a-f0-9]+#[0-9]+: Hello exception transferring World!$')
             wat = re.match(pat, output)
             self.assertTrue(wat is not None)
             self.assertEqual(0, excode)
@@ -3126,6 +3722,45 @@ class ConcurrencyTests(unittest.TestCase):
     def testJoinTimeout0ms(self):
         runTestThrowsException(self, 'join_timeout_0ms.asm', ('Exception', 'process did not join',))
 
+    def testJoiningATreeOfProcesses(self):
+        # processes are freed and allocated again while results of their
+        # siblings still wait to be joined; PIDs must not be confused even
+        # if the addresses of the processes are reused
+        runTest(self, 'joining_a_tree_of_processes.asm', '25')
+
+    def testPingPongOnOneScheduler(self):
+        compiled_path = './build/test/ping_pong_on_one_scheduler.bin'
+        assemble(os.path.join(self.PATH, 'ping_pong_on_one_scheduler.asm'), out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_VP_SCHEDULERS'] = '1'
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        # processes posted to the free list while the only scheduler is busy
+        # must still be picked up, otherwise this never finishes
+        output, error = p.communicate(timeout=30)
+        self.assertEqual(0, p.wait())
+        self.assertEqual('10', output.decode('utf-8').strip())
+
+    def testBlockedReceiveYieldsTheScheduler(self):
+        compiled_path = './build/test/blocked_receive_yields_the_scheduler.bin'
+        metrics_path = './build/test/blocked_receive_yields_the_scheduler.prom'
+        assemble(os.path.join(self.PATH, 'blocked_receive_yields_the_scheduler.asm'), out=compiled_path)
+
+        environment = dict(os.environ)
+        environment['VIUA_VP_SCHEDULERS'] = '1'
+        environment['VIUA_METRICS_FILE'] = metrics_path
+        p = subprocess.Popen((VIUA_KERNEL_PATH, compiled_path), env=environment, stdout=subprocess.PIPE)
+        output, error = p.communicate(timeout=30)
+        self.assertEqual(0, p.wait())
+        self.assertEqual('1000', output.decode('utf-8').strip())
+
+        with open(metrics_path) as ifstream:
+            metrics = dict(line.rsplit(' ', 1) for line in ifstream.read().splitlines()
+                           if not line.startswith('#'))
+        # main/0 executes about 2000 instructions; a waiter that spun on its
+        # empty mailbox for whole quants would add hundreds per burst
+        self.assertTrue(int(metrics['viua_scheduler_ticks_total{scheduler="0"}']) < 4000)
+
 
 class WatchdogTests(unittest.TestCase):
     PATH = './sample/asm/watchdog'
@@ -3182,6 +3817,9 @@ class StructTests(unittest.TestCase):
     def testRemovingAValueFromAStruct(self):
         runTestSplitlines(self, 'removing_a_value_from_a_struct.asm', ["{'answer': 42}", '{}'])
 
+    def testRemovingAValueIntoARegister(self):
+        runTestSplitlines(self, 'removing_a_value_into_a_register.asm', ['42', '{}'])
+
     def testOverwritingAValueInAStruct(self):
         runTestSplitlines(self, 'overwriting_a_value_in_a_struct.asm', ["{'answer': 666}", "{'answer': 42}"])
 
@@ -3192,6 +3830,34 @@ class StructTests(unittest.TestCase):
         runTest(self, 'struct_of_structs.asm', "{'bad': {'answer': 666}, 'good': {'answer': 42}}")
 
 
+class DictTests(unittest.TestCase):
+    PATH = './sample/asm/dicts'
+
+    def testCreatingEmptyDict(self):
+        runTest(self, 'creating_empty_dict.asm', '{}')
+
+    def testInsertingKeysOfDifferentTypes(self):
+        runTestSplitlines(self, 'inserting_keys_of_different_types.asm', ["{1: 42, 'answer': 42, \"answer\": 666, 00000101: 5}", '4'])
+
+    def testLookingUpKeys(self):
+        runTestSplitlines(self, 'looking_up_keys.asm', ['42', 'true', 'false', 'false'])
+
+    def testLookingUpMissingKey(self):
+        runTestThrowsException(self, 'looking_up_missing_key.asm', ('Exception', "key not found: 'answer'",))
+
+    def testRemovingAValueFromADict(self):
+        runTestSplitlines(self, 'removing_a_value_from_a_dict.asm', ['{1: 42, 2: 666}', '42', '{2: 666}', '{}'])
+
+    def testOverwritingAValueInADict(self):
+        runTestSplitlines(self, 'overwriting_a_value_in_a_dict.asm', ["{'answer': 666}", "{'answer': 42}"])
+
+    def testObtainingListOfKeysInADict(self):
+        runTest(self, 'obtaining_list_of_keys_in_a_dict.asm', "['zeta', 'alpha', 3]")
+
+    def testGrowingADict(self):
+        runTestSplitlines(self, 'growing_a_dict.asm', ['1000', '999', '999', 'false'])
+
+
 class AtomTests(unittest.TestCase):
     PATH = './sample/asm/atoms'
 
@@ -3201,6 +3867,9 @@ class AtomTests(unittest.TestCase):
     def testComparingAtoms(self):
         runTestSplitlines(self, 'comparing_atoms.asm', ['true', 'false'])
 
+    def testComparingAtomsFromStructKeys(self):
+        runTestSplitlines(self, 'comparing_atoms_from_struct_keys.asm', ['true', 'false'])
+
     def testComparingWithDifferentType(self):
         # This was before the "new SA".
         # runTestThrowsException(self, 'comparing_with_different_type.asm', ('Exception', "fetched invalid type: expected 'viua::types::Atom' but got 'Integer'"))
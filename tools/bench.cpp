@@ -0,0 +1,593 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+
+/** Benchmark runner; to be used to time workloads from sample/benchmark
+ *  (see `make bench` and sample/benchmark/actors/run_bench.sh).
+ *
+ *      bench [--kernel <path>] [--runs <n>] [--warmup <n>]
+ *            [--schedulers <n>[,<n>...]] [--ffi-schedulers <n>[,<n>...]]
+ *            [--throughput] [--message-latency]
+ *            [--output <file>] [--baseline <file>] [--threshold <percent>] <bytecode>...
+ *
+ *  Every bytecode file is a separate benchmark, named after the file.
+ *  Each is run in a fresh kernel (--warmup runs are not measured) for every
+ *  combination of VP and FFI scheduler counts given, and the wall-clock time,
+ *  CPU time, and peak RSS of measured runs are summarised; since starting the
+ *  kernel is included in every timing, an empty "startup" workload should be
+ *  run alongside the others to provide a reference.
+ *
+ *  With --throughput the last line printed by a workload is taken to be the
+ *  number of operations it performed, and operations per second of the
+ *  median run are reported.
+ *  With --message-latency the kernel is told to timestamp messages, and
+ *  percentiles of the time messages spent queued are read from its metrics;
+ *  they are upper bounds of the histogram buckets the kernel uses.
+ *
+ *  Results are printed as a table and, with --output, written as JSON.
+ *  With --baseline the median of every benchmark is compared with the one
+ *  recorded in a JSON file written earlier by this tool, and the tool exits
+ *  with 1 if any of them is slower by more than --threshold percent.
+ */
+
+
+struct Options {
+    string kernel = "./build/bin/vm/kernel";
+    unsigned runs = 10;
+    unsigned warmup = 1;
+    bool throughput = false;
+    bool message_latency = false;
+};
+
+struct Configuration {
+    // empty means "inherit from environment"
+    string vp_schedulers;
+    string ffi_schedulers;
+};
+
+struct Run {
+    double wall_ms;
+    double cpu_ms;
+    uint64_t peak_rss_kb;
+    string output;
+
+    // cumulative counts of received messages by upper bound of latency (in seconds)
+    map<double, uint64_t> message_latency;
+};
+
+struct Summary {
+    string name;
+    Configuration configuration;
+
+    double min_ms;
+    double median_ms;
+    double mean_ms;
+    double stddev_ms;
+    double p90_ms;
+    double p99_ms;
+    double max_ms;
+    double cpu_median_ms;
+    uint64_t peak_rss_kb;
+
+    optional<uint64_t> operations;
+    optional<double> operations_per_second;
+
+    // nullopt inside means "above the last bucket"
+    optional<vector<optional<double>>> message_latency_ms;
+};
+
+const vector<double> LATENCY_PERCENTILES = {0.5, 0.9, 0.99};
+
+
+static auto split(const string& list) -> vector<string> {
+    vector<string> parts;
+    istringstream in(list);
+    string each;
+    while (getline(in, each, ',')) {
+        if (each.size()) {
+            parts.push_back(each);
+        }
+    }
+    return parts;
+}
+
+static auto label_of(const Summary& summary) -> string {
+    auto label = summary.name;
+    if (summary.configuration.vp_schedulers.size()) {
+        label += (" vp=" + summary.configuration.vp_schedulers);
+    }
+    if (summary.configuration.ffi_schedulers.size()) {
+        label += (" ffi=" + summary.configuration.ffi_schedulers);
+    }
+    return label;
+}
+
+static auto percentile_of(vector<double> samples, const double percentile) -> double {
+    /*  Nearest-rank percentile.
+     */
+    sort(samples.begin(), samples.end());
+    auto const rank =
+        static_cast<vector<double>::size_type>(ceil(percentile * static_cast<double>(samples.size())));
+    return samples.at(max<vector<double>::size_type>(rank, 1) - 1);
+}
+
+static auto median_of(vector<double> samples) -> double {
+    sort(samples.begin(), samples.end());
+    auto const middle = (samples.size() / 2);
+    return ((samples.size() % 2) ? samples.at(middle) : ((samples.at(middle - 1) + samples.at(middle)) / 2));
+}
+
+static auto latency_percentile(const map<double, uint64_t>& buckets, const double percentile)
+    -> optional<double> {
+    auto const total = buckets.rbegin()->second;
+    for (const auto& [upper_bound, count] : buckets) {
+        if (static_cast<double>(count) >= (percentile * static_cast<double>(total))) {
+            return (isinf(upper_bound) ? nullopt : optional<double>{upper_bound * 1e3});
+        }
+    }
+    return nullopt;
+}
+
+static auto summarise(const string& name, const Configuration& configuration, const vector<Run>& runs)
+    -> Summary {
+    vector<double> wall;
+    vector<double> cpu;
+    for (const auto& each : runs) {
+        wall.push_back(each.wall_ms);
+        cpu.push_back(each.cpu_ms);
+    }
+
+    Summary summary;
+    summary.name = name;
+    summary.configuration = configuration;
+    summary.min_ms = *min_element(wall.begin(), wall.end());
+    summary.max_ms = *max_element(wall.begin(), wall.end());
+    summary.median_ms = median_of(wall);
+    summary.mean_ms = (accumulate(wall.begin(), wall.end(), 0.0) / static_cast<double>(wall.size()));
+    summary.p90_ms = percentile_of(wall, 0.9);
+    summary.p99_ms = percentile_of(wall, 0.99);
+
+    auto squares = 0.0;
+    for (const auto each : wall) {
+        squares += ((each - summary.mean_ms) * (each - summary.mean_ms));
+    }
+    summary.stddev_ms =
+        ((wall.size() > 1) ? sqrt(squares / static_cast<double>(wall.size() - 1)) : 0.0);
+
+    summary.cpu_median_ms = median_of(cpu);
+    summary.peak_rss_kb = 0;
+    for (const auto& each : runs) {
+        summary.peak_rss_kb = max(summary.peak_rss_kb, each.peak_rss_kb);
+    }
+    return summary;
+}
+
+static auto read_message_latency(const string& path) -> map<double, uint64_t> {
+    /*  Sums buckets of the message latency histogram of all schedulers from a
+     *  metrics file written by the kernel.
+     */
+    const string bucket_prefix = "viua_message_latency_seconds_bucket{";
+    const string bound_key = "le=\"";
+
+    map<double, uint64_t> buckets;
+    ifstream in(path);
+    string line;
+    while (getline(in, line)) {
+        if (line.compare(0, bucket_prefix.size(), bucket_prefix) != 0) {
+            continue;
+        }
+        auto const bound_begins = (line.find(bound_key) + bound_key.size());
+        auto const bound = line.substr(bound_begins, line.find('"', bound_begins) - bound_begins);
+        buckets[(bound == "+Inf") ? numeric_limits<double>::infinity() : stod(bound)] +=
+            stoull(line.substr(line.rfind(' ') + 1));
+    }
+    return buckets;
+}
+
+static auto metrics_path() -> string {
+    auto const directory = getenv("TMPDIR");
+    return (string{directory ? directory : "/tmp"} + "/viua-bench-" + to_string(getpid()) + ".prom");
+}
+
+static auto run_once(const Options& options, const string& bytecode, const Configuration& configuration)
+    -> Run {
+    auto const metrics = metrics_path();
+
+    int output_pipe[2];
+    if (pipe(output_pipe) == -1) {
+        throw string{"failed to create pipe"};
+    }
+
+    auto const started_at = chrono::steady_clock::now();
+    auto const child = fork();
+    if (child == -1) {
+        throw string{"failed to fork"};
+    }
+    if (child == 0) {
+        close(output_pipe[0]);
+        dup2(output_pipe[1], STDOUT_FILENO);
+        auto const null_device = open("/dev/null", O_WRONLY);
+        dup2(null_device, STDERR_FILENO);
+        if (configuration.vp_schedulers.size()) {
+            setenv("VIUA_VP_SCHEDULERS", configuration.vp_schedulers.c_str(), 1);
+        }
+        if (configuration.ffi_schedulers.size()) {
+            setenv("VIUA_FFI_SCHEDULERS", configuration.ffi_schedulers.c_str(), 1);
+        }
+        if (options.message_latency) {
+            setenv("VIUA_MESSAGE_TIMESTAMPS", "yes", 1);
+            setenv("VIUA_METRICS_FILE", metrics.c_str(), 1);
+            // only the final dump, written when the kernel exits, is needed
+            setenv("VIUA_METRICS_INTERVAL", "3600000", 1);
+        }
+        execl(options.kernel.c_str(), options.kernel.c_str(), bytecode.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(output_pipe[1]);
+    Run run;
+    char buffer[4096];
+    ssize_t n = 0;
+    while ((n = read(output_pipe[0], buffer, sizeof(buffer))) > 0) {
+        run.output.append(buffer, static_cast<string::size_type>(n));
+    }
+    close(output_pipe[0]);
+
+    int status = 0;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) == -1) {
+        throw string{"failed to wait for kernel"};
+    }
+    run.wall_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - started_at).count();
+    if (not WIFEXITED(status) or WEXITSTATUS(status) != 0) {
+        throw(bytecode + ": kernel failed (exit status " +
+              to_string(WIFEXITED(status) ? WEXITSTATUS(status) : (128 + WTERMSIG(status))) + ")");
+    }
+
+    auto const to_ms = [](const struct timeval& tv) -> double {
+        return ((static_cast<double>(tv.tv_sec) * 1e3) + (static_cast<double>(tv.tv_usec) / 1e3));
+    };
+    run.cpu_ms = (to_ms(usage.ru_utime) + to_ms(usage.ru_stime));
+    run.peak_rss_kb = static_cast<uint64_t>(usage.ru_maxrss);
+
+    if (options.message_latency) {
+        run.message_latency = read_message_latency(metrics);
+        unlink(metrics.c_str());
+    }
+
+    return run;
+}
+
+static auto benchmark(const Options& options, const string& bytecode, const Configuration& configuration)
+    -> Summary {
+    for (auto i = options.warmup; i; --i) {
+        run_once(options, bytecode, configuration);
+    }
+
+    vector<Run> runs;
+    for (auto i = options.runs; i; --i) {
+        runs.push_back(run_once(options, bytecode, configuration));
+    }
+
+    auto name = bytecode.substr(bytecode.rfind('/') + 1);
+    auto summary = summarise(name.substr(0, name.rfind('.')), configuration, runs);
+
+    if (options.throughput) {
+        auto output = runs.back().output;
+        while (output.size() and output.back() == '\n') {
+            output.pop_back();
+        }
+        try {
+            summary.operations = stoull(output.substr(output.rfind('\n') + 1));
+        } catch (const std::logic_error&) {
+            throw(bytecode + ": last line of output is not a number of operations");
+        }
+        summary.operations_per_second = (static_cast<double>(*summary.operations) / (summary.median_ms / 1e3));
+    }
+
+    if (options.message_latency) {
+        map<double, uint64_t> buckets;
+        for (const auto& each : runs) {
+            for (const auto& [upper_bound, count] : each.message_latency) {
+                buckets[upper_bound] += count;
+            }
+        }
+        if (buckets.size() and buckets.rbegin()->second) {
+            vector<optional<double>> percentiles;
+            for (const auto each : LATENCY_PERCENTILES) {
+                percentiles.push_back(latency_percentile(buckets, each));
+            }
+            summary.message_latency_ms = percentiles;
+        }
+    }
+
+    return summary;
+}
+
+static auto write_header(ostream& out, const Options& options) -> void {
+    out << setw(28) << left << "benchmark" << right << setw(12) << "median ms" << setw(12) << "p90 ms"
+        << setw(12) << "p99 ms" << setw(12) << "stddev ms" << setw(12) << "cpu ms" << setw(12) << "peak MiB";
+    if (options.throughput) {
+        out << setw(14) << "ops/s";
+    }
+    if (options.message_latency) {
+        out << setw(26) << "msg p50/p90/p99 ms";
+    }
+    out << endl;
+}
+
+static auto write_row(ostream& out, const Options& options, const Summary& summary) -> void {
+    out << setw(28) << left << label_of(summary) << right << fixed << setprecision(3) << setw(12)
+        << summary.median_ms << setw(12) << summary.p90_ms << setw(12) << summary.p99_ms << setw(12)
+        << summary.stddev_ms << setw(12) << summary.cpu_median_ms << setw(12) << setprecision(1)
+        << (static_cast<double>(summary.peak_rss_kb) / 1024.0);
+    if (options.throughput) {
+        out << setw(14) << setprecision(0) << *summary.operations_per_second;
+    }
+    if (options.message_latency) {
+        ostringstream percentiles;
+        if (summary.message_latency_ms) {
+            for (const auto& each : *summary.message_latency_ms) {
+                percentiles << (percentiles.tellp() ? "/" : "");
+                if (each) {
+                    percentiles << *each;
+                } else {
+                    percentiles << "+Inf";
+                }
+            }
+        } else {
+            percentiles << '-';
+        }
+        out << setw(26) << percentiles.str();
+    }
+    out << endl;
+}
+
+static auto json_string(const string& s) -> string {
+    return (s.size() ? ("\"" + s + "\"") : string{"null"});
+}
+
+static auto write_json(ostream& out, const Options& options, const vector<Summary>& summaries) -> void {
+    /*  One benchmark per line; read_baseline() depends on it.
+     */
+    out << "{\n";
+    out << "    \"kernel\": \"" << options.kernel << "\",\n";
+    out << "    \"runs\": " << options.runs << ",\n";
+    out << "    \"benchmarks\": [\n";
+    out << fixed << setprecision(3);
+    for (auto i = vector<Summary>::size_type{0}; i < summaries.size(); ++i) {
+        const auto& each = summaries.at(i);
+        out << "        {\"name\": \"" << each.name
+            << "\", \"vp_schedulers\": " << json_string(each.configuration.vp_schedulers)
+            << ", \"ffi_schedulers\": " << json_string(each.configuration.ffi_schedulers)
+            << ", \"min_ms\": " << each.min_ms << ", \"median_ms\": " << each.median_ms
+            << ", \"mean_ms\": " << each.mean_ms << ", \"stddev_ms\": " << each.stddev_ms
+            << ", \"p90_ms\": " << each.p90_ms << ", \"p99_ms\": " << each.p99_ms
+            << ", \"max_ms\": " << each.max_ms
+            << ", \"cpu_median_ms\": " << each.cpu_median_ms << ", \"peak_rss_kb\": " << each.peak_rss_kb;
+        if (each.operations) {
+            out << ", \"operations\": " << *each.operations
+                << ", \"operations_per_second\": " << *each.operations_per_second;
+        }
+        if (each.message_latency_ms) {
+            for (auto j = vector<double>::size_type{0}; j < LATENCY_PERCENTILES.size(); ++j) {
+                auto const& value = each.message_latency_ms->at(j);
+                out << ", \"message_latency_p" << static_cast<unsigned>(LATENCY_PERCENTILES.at(j) * 100)
+                    << "_ms\": ";
+                if (value) {
+                    out << *value;
+                } else {
+                    out << "null";
+                }
+            }
+        }
+        out << "}" << ((i + 1 < summaries.size()) ? "," : "") << "\n";
+    }
+    out << "    ]\n";
+    out << "}\n";
+}
+
+static auto field_of(const string& line, const string& key) -> string {
+    /*  Returns raw text of a value in a line written by write_json().
+     */
+    auto const key_text = ("\"" + key + "\": ");
+    auto const found = line.find(key_text);
+    if (found == string::npos) {
+        return "";
+    }
+    auto const begins = (found + key_text.size());
+    auto value = line.substr(begins, line.find_first_of(",}", begins) - begins);
+    if (value.size() and value.front() == '"') {
+        value = value.substr(1, value.size() - 2);
+    }
+    return (value == "null" ? string{} : value);
+}
+
+static auto read_baseline(const string& path) -> map<string, double> {
+    /*  Reads medians from a file written by write_json().
+     */
+    ifstream in(path);
+    if (not in) {
+        throw("failed to open baseline: " + path);
+    }
+
+    map<string, double> medians;
+    string line;
+    while (getline(in, line)) {
+        auto const median = field_of(line, "median_ms");
+        if (median.empty()) {
+            continue;
+        }
+        Summary summary;
+        summary.name = field_of(line, "name");
+        summary.configuration.vp_schedulers = field_of(line, "vp_schedulers");
+        summary.configuration.ffi_schedulers = field_of(line, "ffi_schedulers");
+        medians[label_of(summary)] = stod(median);
+    }
+    return medians;
+}
+
+static auto compare(const vector<Summary>& summaries, const map<string, double>& baseline,
+                    const double threshold) -> bool {
+    /*  Returns true if any benchmark regressed.
+     */
+    bool regressed = false;
+
+    cout << '\n';
+    cout << setw(28) << left << "benchmark" << right << setw(14) << "baseline ms" << setw(14) << "median ms"
+         << setw(10) << "change" << '\n';
+    cout << fixed;
+    for (const auto& each : summaries) {
+        auto const label = label_of(each);
+        auto found = baseline.find(label);
+        if (found == baseline.end()) {
+            cout << setw(28) << left << label << right << setw(14) << "-" << setw(14) << setprecision(3)
+                 << each.median_ms << setw(10) << "new" << '\n';
+            continue;
+        }
+
+        auto const change = ((each.median_ms - found->second) / found->second * 100.0);
+        auto const slower = (change > threshold);
+        regressed = (regressed or slower);
+
+        ostringstream change_text;
+        change_text << showpos << fixed << setprecision(1) << change << '%';
+        cout << setw(28) << left << label << right << setw(14) << setprecision(3) << found->second << setw(14)
+             << each.median_ms << setw(10) << change_text.str() << (slower ? "  REGRESSION" : "") << '\n';
+    }
+
+    return regressed;
+}
+
+
+int main(int argc, char* argv[]) {
+    Options options;
+    vector<string> vp_schedulers{""};
+    vector<string> ffi_schedulers{""};
+    string output_filename;
+    string baseline_filename;
+    double threshold = 10.0;
+    vector<string> workloads;
+
+    for (int i = 1; i < argc; ++i) {
+        const string option(argv[i]);
+        if (option == "--throughput") {
+            options.throughput = true;
+        } else if (option == "--message-latency") {
+            options.message_latency = true;
+        } else if ((option == "--kernel" or option == "--runs" or option == "--warmup" or
+                    option == "--schedulers" or option == "--ffi-schedulers" or option == "--output" or
+                    option == "--baseline" or option == "--threshold") and
+                   (i + 1) < argc) {
+            const string value(argv[++i]);
+            if (option == "--kernel") {
+                options.kernel = value;
+            } else if (option == "--runs") {
+                options.runs = static_cast<unsigned>(stoul(value));
+            } else if (option == "--warmup") {
+                options.warmup = static_cast<unsigned>(stoul(value));
+            } else if (option == "--schedulers") {
+                vp_schedulers = split(value);
+            } else if (option == "--ffi-schedulers") {
+                ffi_schedulers = split(value);
+            } else if (option == "--output") {
+                output_filename = value;
+            } else if (option == "--baseline") {
+                baseline_filename = value;
+            } else {
+                threshold = stod(value);
+            }
+        } else if (option.size() and option[0] == '-') {
+            cerr << "error: unknown option: " << option << endl;
+            return 1;
+        } else {
+            workloads.push_back(option);
+        }
+    }
+
+    if (workloads.empty()) {
+        cerr << "error: no benchmarks to run" << endl;
+        return 1;
+    }
+    if (options.runs == 0) {
+        cerr << "error: at least one run is required" << endl;
+        return 1;
+    }
+    if (vp_schedulers.empty() or ffi_schedulers.empty()) {
+        cerr << "error: empty list of scheduler counts" << endl;
+        return 1;
+    }
+
+    // read before running so that results may be written over the baseline
+    map<string, double> baseline;
+    if (baseline_filename.size()) {
+        try {
+            baseline = read_baseline(baseline_filename);
+        } catch (const string& e) {
+            cerr << "error: " << e << endl;
+            return 1;
+        }
+    }
+
+    vector<Summary> summaries;
+    try {
+        write_header(cout, options);
+        for (const auto& each : workloads) {
+            for (const auto& vp : vp_schedulers) {
+                for (const auto& ffi : ffi_schedulers) {
+                    summaries.push_back(benchmark(options, each, Configuration{vp, ffi}));
+                    write_row(cout, options, summaries.back());
+                }
+            }
+        }
+    } catch (const string& e) {
+        cerr << "error: " << e << endl;
+        return 1;
+    }
+
+    if (output_filename.size()) {
+        ofstream out(output_filename);
+        write_json(out, options, summaries);
+    }
+
+    if (baseline_filename.size()) {
+        return (compare(summaries, baseline, threshold) ? 1 : 0);
+    }
+
+    return 0;
+}
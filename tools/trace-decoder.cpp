@@ -0,0 +1,201 @@
+/*
+ *  Copyright (C) 2017 Marek Marecki
+ *
+ *  This file is part of Viua VM.
+ *
+ *  Viua VM is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Viua VM is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Viua VM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <viua/bytecode/maps.h>
+#include <viua/machine.h>
+#include <viua/scheduler/tracing.h>
+using namespace std;
+
+using viua::scheduler::tracing::Record;
+
+
+/** Trace decoder tool; to be used to inspect traces written by the kernel
+ *  when VIUA_ENABLE_TRACING is set.
+ *
+ *  This tool takes a trace file on input and prints to standard output.
+ *  By default every record is rendered as a single line:
+ *
+ *      <nanoseconds> scheduler=<n> pid=<pid> depth=<depth> ip=<offset> <instruction>
+ *
+ *  Records can be filtered by process (--pid <pid>), scheduler (--scheduler <n>), and
+ *  instruction (--opcode <mnemonic>).
+ *  With --summary, instead of printing records the tool reports how many
+ *  instructions were executed in total, by each process, and of each kind.
+ */
+
+
+static auto opcode_name(const uint8_t opcode) -> string {
+    auto found = OP_NAMES.find(static_cast<OPCODE>(opcode));
+    if (found == OP_NAMES.end()) {
+        return ("<unrecognised instruction byte = " + to_string(static_cast<unsigned>(opcode)) + ">");
+    }
+    return found->second;
+}
+
+static auto read_records(const string& path) -> vector<Record> {
+    ifstream in(path, ios::in | ios::binary);
+    if (not in) {
+        throw("cannot open trace file: " + path);
+    }
+
+    const auto magic_size = (strlen(VIUA_TRACE_MAGIC) + 1);
+    string magic(magic_size, '\0');
+    in.read(&magic[0], static_cast<streamsize>(magic_size));
+    if ((not in) or memcmp(magic.data(), VIUA_TRACE_MAGIC, magic_size)) {
+        throw("not a trace file: " + path);
+    }
+
+    uint32_t version = 0;
+    uint32_t record_size = 0;
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+    if (version != viua::scheduler::tracing::TRACE_FORMAT_VERSION or record_size != sizeof(Record)) {
+        throw("unsupported trace format version " + to_string(version) + ": " + path);
+    }
+
+    vector<Record> records;
+    Record record;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(Record))) {
+        records.push_back(record);
+    }
+
+    // records of different schedulers are flushed in batches so they
+    // must be put back in order
+    stable_sort(records.begin(), records.end(),
+                [](const Record& lhs, const Record& rhs) -> bool { return (lhs.timestamp < rhs.timestamp); });
+    return records;
+}
+
+static auto render(const vector<Record>& records) -> void {
+    for (const auto& each : records) {
+        cout << setw(12) << each.timestamp;
+        cout << " scheduler=" << each.scheduler;
+        cout << " pid=" << each.pid;
+        cout << " depth=" << each.depth;
+        cout << " ip=0x" << hex << setw(8) << setfill('0') << each.ip << setfill(' ') << dec;
+        cout << ' ' << opcode_name(each.opcode);
+        if (each.flags & viua::scheduler::tracing::RECORD_EXCEPTION_ACTIVE) {
+            cout << " (exception active)";
+        }
+        cout << '\n';
+    }
+}
+
+static auto summarise(const vector<Record>& records) -> void {
+    map<uint8_t, uint64_t> by_opcode;
+    map<uint64_t, uint64_t> by_process;
+    for (const auto& each : records) {
+        ++by_opcode[each.opcode];
+        ++by_process[each.pid];
+    }
+
+    cout << "instructions: " << records.size() << '\n';
+    if (records.size()) {
+        cout << "time: " << (records.back().timestamp - records.front().timestamp) << "ns\n";
+    }
+
+    cout << "\nprocesses: " << by_process.size() << '\n';
+    for (const auto& each : by_process) {
+        cout << "  " << each.first << ": " << each.second << '\n';
+    }
+
+    vector<pair<uint8_t, uint64_t>> opcodes(by_opcode.begin(), by_opcode.end());
+    stable_sort(opcodes.begin(), opcodes.end(),
+                [](const pair<uint8_t, uint64_t>& lhs, const pair<uint8_t, uint64_t>& rhs) -> bool {
+                    return (lhs.second > rhs.second);
+                });
+    cout << "\ninstructions by kind:\n";
+    for (const auto& each : opcodes) {
+        cout << "  " << opcode_name(each.first) << ": " << each.second << '\n';
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    string input_filename;
+    bool summary = false;
+    string only_opcode;
+    string only_pid;
+    string only_scheduler;
+
+    for (int i = 1; i < argc; ++i) {
+        const string option(argv[i]);
+        if (option == "--summary") {
+            summary = true;
+        } else if ((option == "--pid" or option == "--opcode" or option == "--scheduler") and (i + 1) < argc) {
+            const string value(argv[++i]);
+            if (option == "--pid") {
+                only_pid = value;
+            } else if (option == "--opcode") {
+                only_opcode = value;
+            } else {
+                only_scheduler = value;
+            }
+        } else if (option.size() and option[0] == '-') {
+            cerr << "error: unknown option: " << option << endl;
+            return 1;
+        } else {
+            input_filename = option;
+        }
+    }
+
+    if (input_filename.empty()) {
+        cerr << "error: no input file" << endl;
+        return 1;
+    }
+
+    vector<Record> records;
+    try {
+        records = read_records(input_filename);
+    } catch (const string& e) {
+        cerr << "error: " << e << endl;
+        return 1;
+    }
+
+    if (only_opcode.size() or only_pid.size() or only_scheduler.size()) {
+        auto rejected = [&](const Record& each) -> bool {
+            if (only_opcode.size() and opcode_name(each.opcode) != only_opcode) {
+                return true;
+            }
+            if (only_pid.size() and each.pid != stoull(only_pid)) {
+                return true;
+            }
+            if (only_scheduler.size() and each.scheduler != stoul(only_scheduler)) {
+                return true;
+            }
+            return false;
+        };
+        records.erase(remove_if(records.begin(), records.end(), rejected), records.end());
+    }
+
+    if (summary) {
+        summarise(records);
+    } else {
+        render(records);
+    }
+
+    return 0;
+}